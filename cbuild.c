@@ -34,6 +34,7 @@ enum Mode {
     M_DOCS,
     M_LSP,
     M_FLAGS,
+    M_UNICODE,
 
     M_COUNT,
     M_DEFAULT = M_HELP
@@ -151,6 +152,10 @@ struct Settings {
                 bool disable_simd      : 1;
             } flags;
         } flags;
+        struct SettingsUnicode {
+            const char* path_ucd;
+            const char* version;
+        } unicode;
     };
 };
 
@@ -191,6 +196,7 @@ int mode_test( struct Settings* settings );
 int mode_docs( struct Settings* settings );
 int mode_lsp( struct Settings* settings );
 int mode_flags( struct Settings* settings );
+int mode_unicode( struct Settings* settings );
 
 int main( int argc, char** argv ) {
     CB_INITIALIZE( CB_LOG_ALL );
@@ -528,6 +534,26 @@ int main( int argc, char** argv ) {
                     goto next_arg;
                 }
             } break;
+            case M_UNICODE: {
+                if( strcmp( args.buf[0], "-ucd" ) == 0 ) {
+                    args = NEXT( args );
+                    if( !args.len ) {
+                        CB_ERROR( "-ucd requires a path after it!" );
+                        goto error_arg;
+                    }
+                    settings.unicode.path_ucd = args.buf[0];
+                    goto next_arg;
+                }
+                if( strcmp( args.buf[0], "-version" ) == 0 ) {
+                    args = NEXT( args );
+                    if( !args.len ) {
+                        CB_ERROR( "-version requires a version string after it!" );
+                        goto error_arg;
+                    }
+                    settings.unicode.version = args.buf[0];
+                    goto next_arg;
+                }
+            } break;
 
             case M_COUNT:
                 break;
@@ -544,12 +570,13 @@ next_arg:
 break_args:
 
     switch( settings.mode ) {
-        case M_HELP:  return mode_help( &settings );
-        case M_BUILD: return mode_build( &settings );
-        case M_TEST:  return mode_test( &settings );
-        case M_DOCS:  return mode_docs( &settings );
-        case M_LSP:   return mode_lsp( &settings );
-        case M_FLAGS: return mode_flags( &settings );
+        case M_HELP:    return mode_help( &settings );
+        case M_BUILD:   return mode_build( &settings );
+        case M_TEST:    return mode_test( &settings );
+        case M_DOCS:    return mode_docs( &settings );
+        case M_LSP:     return mode_lsp( &settings );
+        case M_FLAGS:   return mode_flags( &settings );
+        case M_UNICODE: return mode_unicode( &settings );
         case M_COUNT:
             break;
     }
@@ -782,6 +809,16 @@ int mode_help( struct Settings* settings ) {
             printf( "  -disable-simd        Don't generate enable SIMD flag.\n" );
         } break;
 
+        case M_UNICODE: {
+            printf( "  -ucd <string>        Path to Unicode Character Database directory.\n" );
+            printf( "                          default: ./ucd\n" );
+            printf( "                          note:    reads UnicodeData.txt, CaseFolding.txt,\n" );
+            printf( "                                   auxiliary/GraphemeBreakProperty.txt\n" );
+            printf( "                                   and emoji/emoji-data.txt.\n" );
+            printf( "  -version <string>    Unicode version to record in generated file.\n" );
+            printf( "                          default: unknown\n" );
+        } break;
+
         case M_COUNT:
             break;
     }
@@ -1632,6 +1669,549 @@ int mode_flags( struct Settings* settings ) {
     return 0;
 }
 
+#define UNICODE_RUNE_COUNT     (0x110000)
+#define UNICODE_MAX_PROPERTIES (256)
+
+#define UNICODE_PROPERTY_ALPHABETIC (1 << 0)
+#define UNICODE_PROPERTY_UPPER      (1 << 1)
+#define UNICODE_PROPERTY_LOWER      (1 << 2)
+
+// NOTE(alicia): order must match UNICODE_GRAPHEME_* in generated file,
+// extended pictographic is kept as its own class since it never overlaps
+// with other grapheme break properties.
+const char* global_unicode_grapheme_names[] = {
+    "Other",
+    "CR",
+    "LF",
+    "Control",
+    "Extend",
+    "ZWJ",
+    "Regional_Indicator",
+    "Prepend",
+    "SpacingMark",
+    "L",
+    "V",
+    "T",
+    "LV",
+    "LVT",
+    "Extended_Pictographic",
+};
+const char* global_unicode_grapheme_macros[] = {
+    "OTHER",
+    "CR",
+    "LF",
+    "CONTROL",
+    "EXTEND",
+    "ZWJ",
+    "REGIONAL_INDICATOR",
+    "PREPEND",
+    "SPACING_MARK",
+    "L",
+    "V",
+    "T",
+    "LV",
+    "LVT",
+    "EXTENDED_PICTOGRAPHIC",
+};
+#define UNICODE_GRAPHEME_COUNT \
+    (sizeof(global_unicode_grapheme_names) / sizeof(global_unicode_grapheme_names[0]))
+
+struct UnicodeProperties {
+    int32_t upper;
+    int32_t lower;
+    int32_t fold;
+    uint8_t flags;
+    uint8_t grapheme;
+};
+
+bool unicode_parse_field( char** at, char** out_field ) {
+    char* start = *at;
+    if( !start ) {
+        return false;
+    }
+    char* end = start;
+    while( *end && *end != ';' && *end != '\n' && *end != '\r' ) {
+        end++;
+    }
+    if( *end == ';' ) {
+        *at = end + 1;
+    } else {
+        *at = NULL;
+    }
+    *end       = 0;
+    *out_field = start;
+    return true;
+}
+uint8_t unicode_flags_from_category( const char* category ) {
+    if( category[0] != 'L' ) {
+        return 0;
+    }
+    uint8_t flags = UNICODE_PROPERTY_ALPHABETIC;
+    if( category[1] == 'u' ) {
+        flags |= UNICODE_PROPERTY_UPPER;
+    } else if( category[1] == 'l' ) {
+        flags |= UNICODE_PROPERTY_LOWER;
+    }
+    return flags;
+}
+bool unicode_push_properties(
+    struct UnicodeProperties* properties, uint32_t* count,
+    struct UnicodeProperties value, uint16_t* out_index
+) {
+    for( uint32_t i = 0; i < *count; ++i ) {
+        if(
+            properties[i].upper    == value.upper &&
+            properties[i].lower    == value.lower &&
+            properties[i].fold     == value.fold  &&
+            properties[i].flags    == value.flags &&
+            properties[i].grapheme == value.grapheme
+        ) {
+            *out_index = (uint16_t)i;
+            return true;
+        }
+    }
+    if( *count >= UNICODE_MAX_PROPERTIES ) {
+        return false;
+    }
+    properties[*count] = value;
+    *out_index = (uint16_t)((*count)++);
+    return true;
+}
+/// Read UCD property file with lines in format
+/// 'XXXX..YYYY ; Value # comment' and set grapheme
+/// class of runes whose value is a grapheme break name.
+bool unicode_read_grapheme_property(
+    const char* path, struct UnicodeProperties* runes
+) {
+    uintptr_t data_size = 0;
+    char*     data      = NULL;
+    CB_INFO( "reading %s . . .", path );
+    if( !cb_read_entire_file( path, &data_size, (void**)&data ) ) {
+        CB_ERROR( "failed to read %s!", path );
+        return false;
+    }
+    data = CB_ALLOC( data, data_size, data_size + 1 );
+    data[data_size] = 0;
+
+    char* line = data;
+    while( line && *line ) {
+        char* next = strchr( line, '\n' );
+        if( next ) {
+            *next++ = 0;
+        }
+        char* comment = strchr( line, '#' );
+        if( comment ) {
+            *comment = 0;
+        }
+
+        char* at    = line;
+        char* range = NULL;
+        char* value = NULL;
+        if(
+            !unicode_parse_field( &at, &range ) ||
+            !unicode_parse_field( &at, &value )
+        ) {
+            line = next;
+            continue;
+        }
+        while( *value == ' ' ) {
+            value++;
+        }
+        size_t value_len = strlen( value );
+        while( value_len && value[value_len - 1] == ' ' ) {
+            value[--value_len] = 0;
+        }
+
+        uint32_t grapheme = 0;
+        for( ; grapheme < UNICODE_GRAPHEME_COUNT; ++grapheme ) {
+            if( strcmp( value, global_unicode_grapheme_names[grapheme] ) == 0 ) {
+                break;
+            }
+        }
+        if( grapheme == UNICODE_GRAPHEME_COUNT ) {
+            // NOTE(alicia): emoji-data.txt has other emoji properties.
+            line = next;
+            continue;
+        }
+
+        char*    end   = NULL;
+        uint32_t first = (uint32_t)strtoul( range, &end, 16 );
+        uint32_t last  = first;
+        if( end[0] == '.' && end[1] == '.' ) {
+            last = (uint32_t)strtoul( end + 2, NULL, 16 );
+        }
+        if( last >= UNICODE_RUNE_COUNT || first > last ) {
+            CB_ERROR( "%s: invalid range '%s'!", path, range );
+            CB_FREE( data, data_size + 1 );
+            return false;
+        }
+        for( uint32_t r = first; r <= last; ++r ) {
+            runes[r].grapheme = (uint8_t)grapheme;
+        }
+
+        line = next;
+    }
+
+    CB_FREE( data, data_size + 1 );
+    return true;
+}
+/// Read CaseFolding.txt with lines in format
+/// 'XXXX; S; YYYY; # comment' and set simple case folding
+/// of runes with common (C) or simple (S) status.
+bool unicode_read_case_folding(
+    const char* path, struct UnicodeProperties* runes
+) {
+    uintptr_t data_size = 0;
+    char*     data      = NULL;
+    CB_INFO( "reading %s . . .", path );
+    if( !cb_read_entire_file( path, &data_size, (void**)&data ) ) {
+        CB_ERROR( "failed to read %s!", path );
+        return false;
+    }
+    data = CB_ALLOC( data, data_size, data_size + 1 );
+    data[data_size] = 0;
+
+    char* line = data;
+    while( line && *line ) {
+        char* next = strchr( line, '\n' );
+        if( next ) {
+            *next++ = 0;
+        }
+        char* comment = strchr( line, '#' );
+        if( comment ) {
+            *comment = 0;
+        }
+
+        char* at      = line;
+        char* code    = NULL;
+        char* status  = NULL;
+        char* mapping = NULL;
+        if(
+            !unicode_parse_field( &at, &code )   ||
+            !unicode_parse_field( &at, &status ) ||
+            !unicode_parse_field( &at, &mapping )
+        ) {
+            line = next;
+            continue;
+        }
+        while( *status == ' ' ) {
+            status++;
+        }
+        if( *status != 'C' && *status != 'S' ) {
+            // NOTE(alicia): full (F) and Turkic (T) mappings are not simple.
+            line = next;
+            continue;
+        }
+
+        uint32_t rune   = (uint32_t)strtoul( code, NULL, 16 );
+        uint32_t folded = (uint32_t)strtoul( mapping, NULL, 16 );
+        if( rune >= UNICODE_RUNE_COUNT || folded >= UNICODE_RUNE_COUNT ) {
+            CB_ERROR( "%s: invalid mapping '%s'!", path, code );
+            CB_FREE( data, data_size + 1 );
+            return false;
+        }
+        runes[rune].fold = (int32_t)folded - (int32_t)rune;
+
+        line = next;
+    }
+
+    CB_FREE( data, data_size + 1 );
+    return true;
+}
+/// Split per-rune property indices into blocks of (1 << shift) runes,
+/// deduplicate blocks and return total size of both stages in bytes.
+size_t unicode_compress(
+    const uint16_t* rune_properties, uint32_t shift, bool write_tables,
+    uint32_t* out_page_count, uint16_t* out_block_index, uint16_t* out_pages
+) {
+    uint32_t block_size  = 1u << shift;
+    uint32_t block_count = UNICODE_RUNE_COUNT >> shift;
+    uint32_t page_count  = 0;
+
+    // NOTE(alicia): pages are always taken from rune_properties,
+    // so only first rune of each page needs to be stored while searching.
+    uint32_t* page_start = CB_ALLOC( NULL, 0, sizeof(uint32_t) * block_count );
+
+    for( uint32_t block = 0; block < block_count; ++block ) {
+        const uint16_t* src = rune_properties + (block << shift);
+
+        uint32_t page = 0;
+        for( ; page < page_count; ++page ) {
+            if( memcmp(
+                rune_properties + page_start[page], src,
+                sizeof(uint16_t) * block_size ) == 0
+            ) {
+                break;
+            }
+        }
+        if( page == page_count ) {
+            page_start[page_count++] = block << shift;
+            if( write_tables ) {
+                memcpy(
+                    out_pages + (page << shift), src, sizeof(uint16_t) * block_size );
+            }
+        }
+        if( write_tables ) {
+            out_block_index[block] = (uint16_t)page;
+        }
+    }
+
+    CB_FREE( page_start, sizeof(uint32_t) * block_count );
+
+    size_t index_size = page_count > 256 ? 2 : 1;
+    *out_page_count = page_count;
+    return (index_size * block_count) + (page_count << shift);
+}
+void unicode_write_array(
+    CB_File* file, const char* type, const char* name,
+    uint32_t count, const uint16_t* values
+) {
+    cb_file_write_fmt( file, "attr_global const %s %s[%" PRIu32 "] = {", type, name, count );
+    for( uint32_t i = 0; i < count; ++i ) {
+        if( (i % 16) == 0 ) {
+            cb_file_write_fmt( file, "\n    " );
+        }
+        cb_file_write_fmt( file, "%" PRIu16 ",", values[i] );
+        if( ((i + 1) % 16) != 0 && (i + 1) < count ) {
+            cb_file_write_fmt( file, " " );
+        }
+    }
+    cb_file_write_fmt( file, "\n};\n" );
+}
+int mode_unicode( struct Settings* settings ) {
+    #define PATH "src/core/unicode_tables.c"
+
+    const char* ucd     = settings->unicode.path_ucd ? settings->unicode.path_ucd : "ucd";
+    const char* version = settings->unicode.version  ? settings->unicode.version  : "unknown";
+
+    const char* path_data = cb_local_buf_fmt( "%s/UnicodeData.txt", ucd );
+
+    uintptr_t data_size = 0;
+    char*     data      = NULL;
+    CB_INFO( "reading %s . . .", path_data );
+    if( !cb_read_entire_file( path_data, &data_size, (void**)&data ) ) {
+        CB_ERROR( "failed to read %s!", path_data );
+        return 1;
+    }
+    data = CB_ALLOC( data, data_size, data_size + 1 );
+    data[data_size] = 0;
+
+    struct UnicodeProperties* runes =
+        CB_ALLOC( NULL, 0, sizeof(struct UnicodeProperties) * UNICODE_RUNE_COUNT );
+
+    uint32_t range_first = UINT32_MAX;
+    uint32_t line_count  = 0;
+
+    char* line = data;
+    while( line && *line ) {
+        char* next = strchr( line, '\n' );
+        if( next ) {
+            *next++ = 0;
+        }
+        if( !*line || *line == '#' || *line == '\r' ) {
+            line = next;
+            continue;
+        }
+
+        char* at = line;
+        char* fields[15] = {};
+        for( int i = 0; i < 15; ++i ) {
+            if( !unicode_parse_field( &at, fields + i ) ) {
+                fields[i] = "";
+            }
+        }
+
+        uint32_t rune  = (uint32_t)strtoul( fields[0], NULL, 16 );
+        uint32_t upper = *fields[12] ? (uint32_t)strtoul( fields[12], NULL, 16 ) : rune;
+        uint32_t lower = *fields[13] ? (uint32_t)strtoul( fields[13], NULL, 16 ) : rune;
+        if( rune >= UNICODE_RUNE_COUNT ) {
+            CB_ERROR( "%s:%" PRIu32 ": rune out of range!", path_data, line_count + 1 );
+            return 1;
+        }
+
+        struct UnicodeProperties value = {
+            .upper = (int32_t)upper - (int32_t)rune,
+            .lower = (int32_t)lower - (int32_t)rune,
+            .flags = unicode_flags_from_category( fields[2] ),
+        };
+
+        size_t name_len = strlen( fields[1] );
+        if( name_len > 8 && strcmp( fields[1] + name_len - 8, ", First>" ) == 0 ) {
+            range_first = rune;
+        } else if( name_len > 7 && strcmp( fields[1] + name_len - 7, ", Last>" ) == 0 ) {
+            if( range_first > rune ) {
+                CB_ERROR( "%s:%" PRIu32 ": range end without start!", path_data, line_count + 1 );
+                return 1;
+            }
+            for( uint32_t r = range_first; r <= rune; ++r ) {
+                runes[r] = value;
+            }
+            range_first = UINT32_MAX;
+        } else {
+            runes[rune] = value;
+        }
+
+        line_count++;
+        line = next;
+    }
+    CB_FREE( data, data_size + 1 );
+
+    if( !unicode_read_case_folding(
+        cb_local_buf_fmt( "%s/CaseFolding.txt", ucd ), runes
+    ) ) {
+        return 1;
+    }
+    if( !unicode_read_grapheme_property(
+        cb_local_buf_fmt( "%s/auxiliary/GraphemeBreakProperty.txt", ucd ), runes
+    ) ) {
+        return 1;
+    }
+    if( !unicode_read_grapheme_property(
+        cb_local_buf_fmt( "%s/emoji/emoji-data.txt", ucd ), runes
+    ) ) {
+        return 1;
+    }
+
+    uint16_t* rune_properties =
+        CB_ALLOC( NULL, 0, sizeof(uint16_t) * UNICODE_RUNE_COUNT );
+    struct UnicodeProperties* properties =
+        CB_ALLOC( NULL, 0, sizeof(struct UnicodeProperties) * UNICODE_MAX_PROPERTIES );
+    uint32_t property_count = 0;
+
+    // NOTE(alicia): property 0 is unassigned/no properties.
+    uint16_t index = 0;
+    unicode_push_properties(
+        properties, &property_count, (struct UnicodeProperties){0}, &index );
+    for( uint32_t rune = 0; rune < UNICODE_RUNE_COUNT; ++rune ) {
+        if( !unicode_push_properties( properties, &property_count, runes[rune], &index ) ) {
+            // NOTE(alicia): pages store property index as a byte.
+            CB_ERROR( "more than %d unique properties!", UNICODE_MAX_PROPERTIES );
+            return 1;
+        }
+        rune_properties[rune] = index;
+    }
+    CB_FREE( runes, sizeof(struct UnicodeProperties) * UNICODE_RUNE_COUNT );
+
+    uint32_t best_shift = 0;
+    size_t   best_size  = SIZE_MAX;
+    for( uint32_t shift = 4; shift <= 10; ++shift ) {
+        uint32_t page_count = 0;
+        size_t   size = unicode_compress(
+            rune_properties, shift, false, &page_count, NULL, NULL );
+        CB_INFO( "  block size %4" PRIu32 ": %5" PRIu32 " pages, %zu bytes",
+            1u << shift, page_count, size );
+        if( size < best_size ) {
+            best_size  = size;
+            best_shift = shift;
+        }
+    }
+
+    uint32_t  block_count = UNICODE_RUNE_COUNT >> best_shift;
+    uint16_t* block_index = CB_ALLOC( NULL, 0, sizeof(uint16_t) * block_count );
+    uint16_t* pages       = CB_ALLOC( NULL, 0, sizeof(uint16_t) * UNICODE_RUNE_COUNT );
+    uint32_t  page_count  = 0;
+    unicode_compress( rune_properties, best_shift, true, &page_count, block_index, pages );
+
+    CB_INFO(
+        "parsed %" PRIu32 " entries, %" PRIu32 " unique properties, "
+        "block size %" PRIu32 ", %" PRIu32 " pages, %zu bytes",
+        line_count, property_count, 1u << best_shift, page_count, best_size );
+
+    CB_INFO( "generating " PATH " . . ." );
+    if( cb_file_exists( PATH ) ) {
+        if( !cb_file_remove( PATH ) ) {
+            return 1;
+        }
+    }
+
+    CB_Time    now     = cb_time_query();
+    struct tm* tm_info = localtime( &now );
+
+    char time_buf[64] = {};
+    strftime( time_buf, sizeof(time_buf), "%B %d, %Y", tm_info );
+
+    CB_File file;
+    if( !cb_file_open( PATH, CB_FOPEN_CREATE | CB_FOPEN_WRITE, &file ) ) {
+        return 1;
+    }
+
+    #define write( ... ) cb_file_write_fmt( &file, __VA_ARGS__ )
+
+    write( "/**\n" );
+    write( " * @file   unicode_tables.c\n" );
+    write( " * @brief  Generated Unicode property tables.\n" );
+    write( " * @details\n" );
+    write( " * Generated from UnicodeData.txt, CaseFolding.txt,\n" );
+    write( " * GraphemeBreakProperty.txt and emoji-data.txt, Unicode %s.\n", version );
+    write( " * Do not edit, regenerate with './cbuild unicode'.\n" );
+    write( " *\n" );
+    write( " * Two-stage table, rune >> #UNICODE_TABLE_SHIFT selects a page\n" );
+    write( " * from block index and low bits of rune select property index\n" );
+    write( " * within page. Identical pages are stored once.\n" );
+    write( " * @author Generated from cbuild.c\n" );
+    write( " * @date   %s\n", time_buf );
+    write( "*/\n" );
+    write( "#include \"core/types.h\"\n" );
+    write( "#include \"core/attributes.h\"\n\n" );
+
+    write( "#define UNICODE_TABLE_SHIFT (%" PRIu32 ")\n", best_shift );
+    write( "#define UNICODE_TABLE_MASK  ((1 << UNICODE_TABLE_SHIFT) - 1)\n\n" );
+
+    write( "#define UNICODE_PROPERTY_ALPHABETIC (%d)\n", UNICODE_PROPERTY_ALPHABETIC );
+    write( "#define UNICODE_PROPERTY_UPPER      (%d)\n", UNICODE_PROPERTY_UPPER );
+    write( "#define UNICODE_PROPERTY_LOWER      (%d)\n\n", UNICODE_PROPERTY_LOWER );
+
+    for( uint32_t i = 0; i < UNICODE_GRAPHEME_COUNT; ++i ) {
+        write( "#define UNICODE_GRAPHEME_%-21s (%" PRIu32 ")\n",
+            global_unicode_grapheme_macros[i], i );
+    }
+    write( "#define UNICODE_GRAPHEME_COUNT                 (%zu)\n\n", UNICODE_GRAPHEME_COUNT );
+
+    write( "/// @brief Properties shared by one or more runes.\n" );
+    write( "typedef struct UnicodeProperties {\n" );
+    write( "    /// @brief Offset from rune to its simple upper-case mapping.\n" );
+    write( "    i32 upper;\n" );
+    write( "    /// @brief Offset from rune to its simple lower-case mapping.\n" );
+    write( "    i32 lower;\n" );
+    write( "    /// @brief Offset from rune to its simple case folding.\n" );
+    write( "    i32 fold;\n" );
+    write( "    /// @brief Property bits, UNICODE_PROPERTY_*.\n" );
+    write( "    u16 flags;\n" );
+    write( "    /// @brief Grapheme cluster break property, UNICODE_GRAPHEME_*.\n" );
+    write( "    u16 grapheme;\n" );
+    write( "} UnicodeProperties;\n\n" );
+
+    write(
+        "attr_global const UnicodeProperties global_unicode_properties[%" PRIu32 "] = {\n",
+        property_count );
+    for( uint32_t i = 0; i < property_count; ++i ) {
+        write(
+            "    { %6" PRIi32 ", %6" PRIi32 ", %6" PRIi32 ", %" PRIu8 ", UNICODE_GRAPHEME_%s },\n",
+            properties[i].upper, properties[i].lower, properties[i].fold, properties[i].flags,
+            global_unicode_grapheme_macros[properties[i].grapheme] );
+    }
+    write( "};\n" );
+
+    unicode_write_array(
+        &file, page_count > 256 ? "u16" : "u8", "global_unicode_block_index",
+        block_count, block_index );
+    unicode_write_array(
+        &file, "u8", "global_unicode_pages",
+        page_count << best_shift, pages );
+
+    #undef write
+    cb_file_close( &file );
+
+    CB_FREE( rune_properties, sizeof(uint16_t) * UNICODE_RUNE_COUNT );
+    CB_FREE( properties, sizeof(struct UnicodeProperties) * UNICODE_MAX_PROPERTIES );
+    CB_FREE( block_index, sizeof(uint16_t) * block_count );
+    CB_FREE( pages, sizeof(uint16_t) * UNICODE_RUNE_COUNT );
+
+    CB_INFO( "generated " PATH " successfully!" );
+    #undef PATH
+    return 0;
+}
+
 bool mode_from_string( const char* string, enum Mode* out_mode ) {
     for( enum Mode m = 0; m < M_COUNT; ++m ) {
         if( strcmp( string, string_from_mode( m ) ) == 0 ) {
@@ -1643,12 +2223,13 @@ bool mode_from_string( const char* string, enum Mode* out_mode ) {
 }
 const char* string_from_mode( enum Mode mode ) {
     switch( mode ) {
-        case M_HELP:  return "help";
-        case M_BUILD: return "build";
-        case M_TEST:  return "test";
-        case M_DOCS:  return "docs";
-        case M_LSP:   return "lsp";
-        case M_FLAGS: return "flags";
+        case M_HELP:    return "help";
+        case M_BUILD:   return "build";
+        case M_TEST:    return "test";
+        case M_DOCS:    return "docs";
+        case M_LSP:     return "lsp";
+        case M_FLAGS:   return "flags";
+        case M_UNICODE: return "unicode";
         case M_COUNT:
             break;
     }
@@ -1668,6 +2249,8 @@ const char* mode_description( enum Mode mode ) {
             return "Generate clangd compile flags.";
         case M_FLAGS:
             return "Output null-separated list of compile flags for downstream project.";
+        case M_UNICODE:
+            return "Generate Unicode property tables from Unicode Character Database.";
         case M_COUNT:
             break;
     }
@@ -0,0 +1,367 @@
+#if !defined(CORE_CPP_SORT_HPP) && defined(__cplusplus)
+#define CORE_CPP_SORT_HPP
+/**
+ * @file   sort.hpp
+ * @brief  C++ Sorting algorithms.
+ * @details
+ * Unlike C sorting functions, comparison is a template parameter
+ * so lambdas are inlined into the sort.
+ *
+ * Comparison functions take two items and return true
+ * if the first item should be sorted before the second item.
+ * Items must be trivially copyable.
+ * @author Alicia Amarilla (smushyaa@gmail.com)
+ * @date   October 18, 2026
+*/
+#if !defined(CORE_SORT_H)
+    #include "core/sort.h"
+#endif
+#include "core/cpp/slice.hpp"
+#include "core/alloc.h"
+
+/// @brief Sort items in slice.
+/// @details
+/// Introsort, worst case is O(n log n). Not stable.
+/// @param[in] slice Slice of items to sort.
+/// @param     less  Comparison function.
+template<typename T, typename Less> attr_header
+void sort( Slice<T> slice, Less less );
+/// @brief Sort items in slice from least to greatest using operator<.
+/// @details
+/// Introsort, worst case is O(n log n). Not stable.
+/// @param[in] slice Slice of items to sort.
+template<typename T> attr_header
+void sort( Slice<T> slice );
+/// @brief Stable sort items in slice.
+/// @details
+/// Merge sort, worst case is O(n log n). Equal items keep their order.
+/// @param[in] allocator Pointer to allocator interface for scratch memory. Allocates up to (len / 2) + 1 items.
+/// @param[in] slice     Slice of items to sort.
+/// @param     less      Comparison function.
+/// @return
+///     - @c true  : Sorted slice.
+///     - @c false : Failed to allocate scratch memory, slice is unchanged.
+template<typename T, typename Less> attr_header
+bool stable_sort( AllocatorInterface* allocator, Slice<T> slice, Less less );
+/// @brief Stable sort items in slice from least to greatest using operator<.
+/// @details
+/// Merge sort, worst case is O(n log n). Equal items keep their order.
+/// @param[in] allocator Pointer to allocator interface for scratch memory. Allocates up to (len / 2) + 1 items.
+/// @param[in] slice     Slice of items to sort.
+/// @return
+///     - @c true  : Sorted slice.
+///     - @c false : Failed to allocate scratch memory, slice is unchanged.
+template<typename T> attr_header
+bool stable_sort( AllocatorInterface* allocator, Slice<T> slice );
+/// @brief Sort smallest items in slice.
+/// @details
+/// After sorting, first @c count items are the smallest items in sorted order.
+/// Order of the rest of the items is unspecified.
+/// @param[in] slice Slice of items to sort.
+/// @param     count Number of items to sort.
+/// @param     less  Comparison function.
+template<typename T, typename Less> attr_header
+void partial_sort( Slice<T> slice, usize count, Less less );
+/// @brief Sort smallest items in slice using operator<.
+/// @details
+/// After sorting, first @c count items are the smallest items in sorted order.
+/// Order of the rest of the items is unspecified.
+/// @param[in] slice Slice of items to sort.
+/// @param     count Number of items to sort.
+template<typename T> attr_header
+void partial_sort( Slice<T> slice, usize count );
+/// @brief Partially sort slice so that item at @c nth is in its sorted position.
+/// @details
+/// Items before @c nth are not greater than it and
+/// items after @c nth are not less than it.
+/// Average O(n), worst case is O(n log n).
+/// @param[in] slice Slice of items to sort.
+/// @param     nth   Index of item to put in sorted position. Must be < slice.len.
+/// @param     less  Comparison function.
+template<typename T, typename Less> attr_header
+void nth_element( Slice<T> slice, usize nth, Less less );
+/// @brief Partially sort slice so that item at @c nth is in its sorted position using operator<.
+/// @details
+/// Items before @c nth are not greater than it and
+/// items after @c nth are not less than it.
+/// Average O(n), worst case is O(n log n).
+/// @param[in] slice Slice of items to sort.
+/// @param     nth   Index of item to put in sorted position. Must be < slice.len.
+template<typename T> attr_header
+void nth_element( Slice<T> slice, usize nth );
+
+// NOTE(alicia): implementation -----------------------------------------------
+
+/// @brief Ranges at or below this length are sorted with insertion sort.
+#define CPP_SORT_INSERTION_THRESHOLD (16)
+/// @brief Ranges above this length use ninther for pivot selection.
+#define CPP_SORT_NINTHER_THRESHOLD   (128)
+
+template<typename T> attr_always_inline attr_header
+void _internal_sort_swap( T& a, T& b ) {
+    T temp = a;
+    a = b;
+    b = temp;
+}
+template<typename T, typename Less> attr_header
+void _internal_sort_insertion( T* buf, usize len, Less& less ) {
+    for( usize i = 1; i < len; ++i ) {
+        T value = buf[i];
+        usize j = i;
+        while( j && less( value, buf[j - 1] ) ) {
+            buf[j] = buf[j - 1];
+            j--;
+        }
+        buf[j] = value;
+    }
+}
+template<typename T, typename Less> attr_header
+void _internal_sort_sift_down( T* buf, usize root, usize len, Less& less ) {
+    T value = buf[root];
+    for( ;; ) {
+        usize child = (root * 2) + 1;
+        if( child >= len ) {
+            break;
+        }
+        if( (child + 1) < len && less( buf[child], buf[child + 1] ) ) {
+            child++;
+        }
+        if( !less( value, buf[child] ) ) {
+            break;
+        }
+        buf[root] = buf[child];
+        root = child;
+    }
+    buf[root] = value;
+}
+template<typename T, typename Less> attr_header
+void _internal_sort_heapify( T* buf, usize len, Less& less ) {
+    for( usize i = len / 2; i-- > 0; ) {
+        _internal_sort_sift_down( buf, i, len, less );
+    }
+}
+template<typename T, typename Less> attr_header
+void _internal_sort_heapsort( T* buf, usize len, Less& less ) {
+    _internal_sort_heapify( buf, len, less );
+    for( usize i = len; i-- > 1; ) {
+        _internal_sort_swap( buf[0], buf[i] );
+        _internal_sort_sift_down( buf, 0, i, less );
+    }
+}
+template<typename T, typename Less> attr_always_inline attr_header
+usize _internal_sort_median3( T* buf, usize a, usize b, usize c, Less& less ) {
+    if( less( buf[a], buf[b] ) ) {
+        if( less( buf[b], buf[c] ) ) {
+            return b;
+        }
+        return less( buf[a], buf[c] ) ? c : a;
+    }
+    if( less( buf[a], buf[c] ) ) {
+        return a;
+    }
+    return less( buf[b], buf[c] ) ? c : b;
+}
+template<typename T, typename Less> attr_header
+usize _internal_sort_partition( T* buf, usize len, Less& less ) {
+    usize mid   = len / 2;
+    usize last  = len - 1;
+    usize pivot = 0;
+    if( len > CPP_SORT_NINTHER_THRESHOLD ) {
+        usize s = len / 8;
+        pivot   = _internal_sort_median3( buf,
+            _internal_sort_median3( buf, 0, s, s * 2, less ),
+            _internal_sort_median3( buf, mid - s, mid, mid + s, less ),
+            _internal_sort_median3( buf, last - (s * 2), last - s, last, less ),
+            less );
+    } else {
+        pivot = _internal_sort_median3( buf, 0, mid, last, less );
+    }
+    _internal_sort_swap( buf[0], buf[pivot] );
+
+    T value = buf[0];
+    usize i = 0, j = len;
+    for( ;; ) {
+        while( less( buf[++i], value ) ) {
+            if( i == last ) {
+                break;
+            }
+        }
+        // NOTE(alicia): non-strict less (<=) can match value itself,
+        // so j must not walk past index 0.
+        while( less( value, buf[--j] ) ) {
+            if( !j ) {
+                break;
+            }
+        }
+        if( i >= j ) {
+            break;
+        }
+        _internal_sort_swap( buf[i], buf[j] );
+    }
+
+    buf[0] = buf[j];
+    buf[j] = value;
+    return j;
+}
+template<typename T, typename Less> attr_header
+void _internal_sort_introsort( T* buf, usize len, usize depth, Less& less ) {
+    while( len > CPP_SORT_INSERTION_THRESHOLD ) {
+        if( !depth ) {
+            _internal_sort_heapsort( buf, len, less );
+            return;
+        }
+        depth--;
+
+        usize p     = _internal_sort_partition( buf, len, less );
+        usize left  = p;
+        usize right = len - p - 1;
+        if( left < right ) {
+            _internal_sort_introsort( buf, left, depth, less );
+            buf += p + 1;
+            len  = right;
+        } else {
+            _internal_sort_introsort( buf + p + 1, right, depth, less );
+            len = left;
+        }
+    }
+    _internal_sort_insertion( buf, len, less );
+}
+attr_always_inline attr_header
+usize _internal_sort_depth_limit( usize len ) {
+    usize depth = 0;
+    while( len > 1 ) {
+        len >>= 1;
+        depth++;
+    }
+    return depth * 2;
+}
+/// @brief Merge sort, temp must hold (len / 2) + 1 items.
+template<typename T, typename Less> attr_header
+void _internal_sort_merge( T* buf, usize len, T* temp, Less& less ) {
+    if( len <= CPP_SORT_INSERTION_THRESHOLD * 2 ) {
+        _internal_sort_insertion( buf, len, less );
+        return;
+    }
+    usize mid = len / 2;
+    _internal_sort_merge( buf, mid, temp, less );
+    _internal_sort_merge( buf + mid, len - mid, temp, less );
+
+    // NOTE(alicia): halves are already in order.
+    if( !less( buf[mid], buf[mid - 1] ) ) {
+        return;
+    }
+
+    memory_copy( temp, buf, sizeof(T) * mid );
+    usize i = 0, j = mid, dst = 0;
+    while( i < mid && j < len ) {
+        if( less( buf[j], temp[i] ) ) {
+            buf[dst++] = buf[j++];
+        } else {
+            buf[dst++] = temp[i++];
+        }
+    }
+    if( i < mid ) {
+        memory_copy( buf + dst, temp + i, sizeof(T) * (mid - i) );
+    }
+}
+
+template<typename T, typename Less> attr_header
+void sort( Slice<T> slice, Less less ) {
+    if( slice.len < 2 ) {
+        return;
+    }
+    _internal_sort_introsort(
+        slice.buf, slice.len, _internal_sort_depth_limit( slice.len ), less );
+}
+template<typename T> attr_header
+void sort( Slice<T> slice ) {
+    sort( slice, []( const T& a, const T& b ) { return a < b; } );
+}
+template<typename T, typename Less> attr_header
+bool stable_sort( AllocatorInterface* allocator, Slice<T> slice, Less less ) {
+    if( slice.len < 2 ) {
+        return true;
+    }
+    if( slice.len <= CPP_SORT_INSERTION_THRESHOLD * 2 ) {
+        _internal_sort_insertion( slice.buf, slice.len, less );
+        return true;
+    }
+    usize temp_size = sizeof(T) * ((slice.len / 2) + 1);
+    T* temp = (T*)allocator_alloc( allocator, temp_size );
+    if( !temp ) {
+        return false;
+    }
+    _internal_sort_merge( slice.buf, slice.len, temp, less );
+    allocator_free( allocator, temp, temp_size );
+    return true;
+}
+template<typename T> attr_header
+bool stable_sort( AllocatorInterface* allocator, Slice<T> slice ) {
+    return stable_sort(
+        allocator, slice, []( const T& a, const T& b ) { return a < b; } );
+}
+template<typename T, typename Less> attr_header
+void partial_sort( Slice<T> slice, usize count, Less less ) {
+    if( count > slice.len ) {
+        count = slice.len;
+    }
+    if( !count ) {
+        return;
+    }
+
+    // NOTE(alicia): keep max-heap of smallest items seen so far.
+    T* buf = slice.buf;
+    _internal_sort_heapify( buf, count, less );
+    for( usize i = count; i < slice.len; ++i ) {
+        if( less( buf[i], buf[0] ) ) {
+            _internal_sort_swap( buf[0], buf[i] );
+            _internal_sort_sift_down( buf, 0, count, less );
+        }
+    }
+    for( usize i = count; i-- > 1; ) {
+        _internal_sort_swap( buf[0], buf[i] );
+        _internal_sort_sift_down( buf, 0, i, less );
+    }
+}
+template<typename T> attr_header
+void partial_sort( Slice<T> slice, usize count ) {
+    partial_sort( slice, count, []( const T& a, const T& b ) { return a < b; } );
+}
+template<typename T, typename Less> attr_header
+void nth_element( Slice<T> slice, usize nth, Less less ) {
+    if( nth >= slice.len ) {
+        return;
+    }
+    T*    buf   = slice.buf;
+    usize len   = slice.len;
+    usize depth = _internal_sort_depth_limit( len );
+    while( len > CPP_SORT_INSERTION_THRESHOLD ) {
+        if( !depth ) {
+            _internal_sort_heapsort( buf, len, less );
+            return;
+        }
+        depth--;
+
+        usize p = _internal_sort_partition( buf, len, less );
+        if( p == nth ) {
+            return;
+        }
+        if( nth < p ) {
+            len = p;
+        } else {
+            buf += p + 1;
+            len -= p + 1;
+            nth -= p + 1;
+        }
+    }
+    _internal_sort_insertion( buf, len, less );
+}
+template<typename T> attr_header
+void nth_element( Slice<T> slice, usize nth ) {
+    nth_element( slice, nth, []( const T& a, const T& b ) { return a < b; } );
+}
+
+#undef CPP_SORT_INSERTION_THRESHOLD
+#undef CPP_SORT_NINTHER_THRESHOLD
+
+#endif /* header guard */
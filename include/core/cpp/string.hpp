@@ -91,6 +91,20 @@ char string_last_unchecked( String str );
 ///     - @c false : @c a and @c b are not equal.
 attr_header
 bool string_cmp( String a, String b );
+/// @brief Compare strings for equality, ignoring case of ASCII letters.
+/// @param a, b Strings to compare.
+/// @return
+///     - @c true  : @c a and @c b are equal in length and contents, ignoring case.
+///     - @c false : @c a and @c b are not equal.
+attr_header
+bool string_cmp_ascii_nocase( String a, String b );
+/// @brief Compare UTF-8 strings for equality, ignoring case.
+/// @param a, b Strings to compare.
+/// @return
+///     - @c true  : @c a and @c b are equal, ignoring case.
+///     - @c false : @c a and @c b are not equal.
+attr_header
+bool string_cmp_utf8_nocase( String a, String b );
 /// @brief Search for ascii character in string.
 /// @param      str           String to search in.
 /// @param      c             Character to search for.
@@ -163,6 +177,15 @@ bool string_find_phrase_rev( String str, String phrase, usize* opt_out_index = n
 /// @return Number of times @c phrase appears in @c str.
 attr_header
 usize string_find_phrase_count( String str, String phrase );
+/// @brief Search for phrase in string, ignoring case of ASCII letters.
+/// @param str String to search in.
+/// @param phrase Phrase to search for.
+/// @param[out] opt_out_index (optional) Pointer to write index of first character of phrase. (if not null)
+/// @return 
+///     - @c true  : @c phrase was found in @c str.
+///     - @c false : @c phrase was not found.
+attr_header
+bool string_find_phrase_nocase( String str, String phrase, usize* opt_out_index = nullptr );
 /// @brief Truncate length of string.
 /// @details
 /// Returns str if max is greater than length.
@@ -273,6 +296,36 @@ bool string_parse_int( String str, i64* out_int );
 ///     - @c false : Failed to parse integer.
 attr_header
 bool string_parse_uint( String str, u64* out_uint );
+/// @brief Parse signed integer from start of string.
+/// @param      str     String to parse integer from.
+/// @param[out] out_int Pointer to integer to receive result.
+/// @return Number of bytes parsed, zero if integer could not be parsed.
+attr_header
+usize string_parse_int_prefix( String str, i64* out_int );
+/// @brief Parse unsigned integer from start of string.
+/// @param      str      String to parse integer from.
+/// @param[out] out_uint Pointer to integer to receive result.
+/// @return Number of bytes parsed, zero if integer could not be parsed.
+attr_header
+usize string_parse_uint_prefix( String str, u64* out_uint );
+/// @brief Parse array of signed integers from source string.
+/// @param      str         String to parse integers from.
+/// @param      cap         Number of integers that @c out_ints can hold.
+/// @param[out] out_ints    Pointer to array to write integers to.
+/// @param[out] opt_out_len (optional) Pointer to write number of bytes up to end of last integer to.
+/// @return Number of integers parsed.
+attr_header
+usize string_parse_int_array(
+    String str, usize cap, i64* out_ints, usize* opt_out_len = nullptr );
+/// @brief Parse array of unsigned integers from source string.
+/// @param      str         String to parse integers from.
+/// @param      cap         Number of integers that @c out_uints can hold.
+/// @param[out] out_uints   Pointer to array to write integers to.
+/// @param[out] opt_out_len (optional) Pointer to write number of bytes up to end of last integer to.
+/// @return Number of integers parsed.
+attr_header
+usize string_parse_uint_array(
+    String str, usize cap, u64* out_uints, usize* opt_out_len = nullptr );
 /// @brief Parse float from source string.
 /// @details Parsing is successful if valid float is found from start of string.
 /// @param      str       String to parse float from.
@@ -282,6 +335,33 @@ bool string_parse_uint( String str, u64* out_uint );
 ///     - @c false : Failed to parse float.
 attr_header
 bool string_parse_float( String str, f64* out_float );
+/// @brief Parse 32-bit float from source string.
+/// @details Parsing is successful if valid float is found from start of string.
+/// @param      str       String to parse float from.
+/// @param[out] out_float Pointer to float to receive result.
+/// @return
+///     - @c true  : Float was successfully parsed from string.
+///     - @c false : Failed to parse float.
+attr_header
+bool string_parse_float32( String str, f32* out_float );
+/// @brief Parse array of floats from source string.
+/// @param      str         String to parse floats from.
+/// @param      cap         Number of floats that @c out_floats can hold.
+/// @param[out] out_floats  Pointer to array to write floats to.
+/// @param[out] opt_out_len (optional) Pointer to write number of bytes up to end of last float to.
+/// @return Number of floats parsed.
+attr_header
+usize string_parse_float_array(
+    String str, usize cap, f64* out_floats, usize* opt_out_len = nullptr );
+/// @brief Parse array of 32-bit floats from source string.
+/// @param      str         String to parse floats from.
+/// @param      cap         Number of floats that @c out_floats can hold.
+/// @param[out] out_floats  Pointer to array to write floats to.
+/// @param[out] opt_out_len (optional) Pointer to write number of bytes up to end of last float to.
+/// @return Number of floats parsed.
+attr_header
+usize string_parse_float32_array(
+    String str, usize cap, f32* out_floats, usize* opt_out_len = nullptr );
 
 // NOTE(alicia):
 // string_mut don't have overloads with C++ string
@@ -929,6 +1009,14 @@ bool string_cmp( String a, String b ) {
     return string_cmp( a.__pod, b.__pod );
 }
 attr_always_inline attr_header attr_hot
+bool string_cmp_ascii_nocase( String a, String b ) {
+    return string_cmp_ascii_nocase( a.__pod, b.__pod );
+}
+attr_always_inline attr_header attr_hot
+bool string_cmp_utf8_nocase( String a, String b ) {
+    return string_cmp_utf8_nocase( a.__pod, b.__pod );
+}
+attr_always_inline attr_header attr_hot
 bool string_find( String str, char c, usize* opt_out_index ) {
     return string_find( str.__pod, c, opt_out_index );
 }
@@ -965,6 +1053,10 @@ usize string_find_phrase_count( String str, String phrase ) {
     return string_find_phrase_count( str.__pod, phrase.__pod );
 }
 attr_always_inline attr_header attr_hot
+bool string_find_phrase_nocase( String str, String phrase, usize* opt_out_index ) {
+    return string_find_phrase_nocase( str.__pod, phrase.__pod, opt_out_index );
+}
+attr_always_inline attr_header attr_hot
 String string_truncate( String str, usize max ) {
     return string_truncate( str.__pod, max );
 }
@@ -1030,10 +1122,46 @@ bool string_parse_uint( String str, u64* out_uint ) {
     return string_parse_uint( str.__pod, out_uint );
 }
 attr_always_inline attr_header attr_hot
+usize string_parse_int_prefix( String str, i64* out_int ) {
+    return string_parse_int_prefix( str.__pod, out_int );
+}
+attr_always_inline attr_header attr_hot
+usize string_parse_uint_prefix( String str, u64* out_uint ) {
+    return string_parse_uint_prefix( str.__pod, out_uint );
+}
+attr_always_inline attr_header attr_hot
+usize string_parse_int_array(
+    String str, usize cap, i64* out_ints, usize* opt_out_len
+) {
+    return string_parse_int_array( str.__pod, cap, out_ints, opt_out_len );
+}
+attr_always_inline attr_header attr_hot
+usize string_parse_uint_array(
+    String str, usize cap, u64* out_uints, usize* opt_out_len
+) {
+    return string_parse_uint_array( str.__pod, cap, out_uints, opt_out_len );
+}
+attr_always_inline attr_header attr_hot
 bool string_parse_float( String str, f64* out_float ) {
     return string_parse_float( str.__pod, out_float );
 }
 attr_always_inline attr_header attr_hot
+bool string_parse_float32( String str, f32* out_float ) {
+    return string_parse_float32( str.__pod, out_float );
+}
+attr_always_inline attr_header attr_hot
+usize string_parse_float_array(
+    String str, usize cap, f64* out_floats, usize* opt_out_len
+) {
+    return string_parse_float_array( str.__pod, cap, out_floats, opt_out_len );
+}
+attr_always_inline attr_header attr_hot
+usize string_parse_float32_array(
+    String str, usize cap, f32* out_floats, usize* opt_out_len
+) {
+    return string_parse_float32_array( str.__pod, cap, out_floats, opt_out_len );
+}
+attr_always_inline attr_header attr_hot
 usize string_stream_to_upper( StreamBytesFN* stream, void* target, String str ) {
     return string_stream_to_upper( stream, target, str.__pod );
 }
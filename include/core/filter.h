@@ -0,0 +1,226 @@
+#if !defined(CORE_FILTER_H)
+#define CORE_FILTER_H
+/**
+ * @file   filter.h
+ * @brief  Probabilistic membership filters.
+ * @details
+ * Filters answer "definitely not present" or "probably present"
+ * and are meant to be checked before expensive lookups.
+ *
+ * Filters take in 64-bit hashes rather than keys,
+ * hashes should be obtained from functions in core/hash.h.
+ * @author Alicia Amarilla (smushyaa@gmail.com)
+ * @date   October 18, 2026
+*/
+#include "core/types.h"
+#include "core/attributes.h"
+#include "core/hash.h"
+#include "core/string.h"
+
+struct AllocatorInterface;
+
+/// @brief Size of bloom filter blocks in bytes.
+/// @details
+/// Each key only touches one block so each lookup
+/// is a single cache line.
+#define BLOOM_FILTER_BLOCK_SIZE (64)
+
+/// @brief Number of fingerprints in each cuckoo filter bucket.
+#define CUCKOO_FILTER_BUCKET_SIZE (4)
+
+/// @brief Blocked bloom filter.
+typedef struct BloomFilter {
+    /// @brief Number of blocks in filter.
+    usize block_count;
+    /// @brief Number of bits set per key.
+    u32   hash_count;
+    /// @brief Pointer to blocks.
+    u8*   blocks;
+} BloomFilter;
+
+/// @brief Cuckoo filter.
+/// @details
+/// Unlike bloom filter, supports removing keys.
+typedef struct CuckooFilter {
+    /// @brief Number of buckets. Always power of two.
+    usize bucket_count;
+    /// @brief Number of keys in filter.
+    usize len;
+    /// @brief Mask of fingerprint bits.
+    u16   fingerprint_mask;
+    /// @brief If true, filter is full and victim is stored in @c victim_fingerprint.
+    b16   has_victim;
+    /// @brief Fingerprint that could not be placed in a bucket.
+    u16   victim_fingerprint;
+    /// @brief Bucket index of victim.
+    usize victim_index;
+    /// @brief Pointer to buckets.
+    u16*  buckets;
+} CuckooFilter;
+
+/// @brief Calculate bloom filter size from expected number of keys and false positive rate.
+/// @note
+/// Keeping each key in one block means the actual false positive rate
+/// ends up slightly higher than target at very low rates.
+/// @param      expected_count      Expected number of keys in filter.
+/// @param      false_positive_rate Target false positive rate. Must be > 0 and < 1.
+/// @param[out] out_hash_count      Pointer to write number of bits to set per key.
+/// @return Size of filter in bytes. Always a multiple of #BLOOM_FILTER_BLOCK_SIZE.
+attr_core_api
+usize bloom_filter_calculate_size(
+    usize expected_count, f32 false_positive_rate, u32* out_hash_count );
+/// @brief Create bloom filter sized for expected number of keys and false positive rate.
+/// @param[in]  allocator           Pointer to allocator interface.
+/// @param      expected_count      Expected number of keys in filter.
+/// @param      false_positive_rate Target false positive rate. Must be > 0 and < 1.
+/// @param[out] out_filter          Pointer to write filter to.
+/// @return
+///     - @c true  : Allocated filter.
+///     - @c false : Failed to allocate filter.
+attr_core_api
+b32 bloom_filter_create(
+    struct AllocatorInterface* allocator, usize expected_count,
+    f32 false_positive_rate, BloomFilter* out_filter );
+/// @brief Free bloom filter.
+/// @param[in] allocator Pointer to allocator interface used to create filter.
+/// @param[in] filter    Pointer to filter to free.
+attr_core_api
+void bloom_filter_free(
+    struct AllocatorInterface* allocator, BloomFilter* filter );
+/// @brief Remove all keys from bloom filter.
+/// @param[in] filter Pointer to filter.
+attr_core_api
+void bloom_filter_clear( BloomFilter* filter );
+/// @brief Insert key into bloom filter.
+/// @param[in] filter Pointer to filter.
+/// @param     hash   Hash of key.
+attr_core_api
+void bloom_filter_insert( BloomFilter* filter, hash64 hash );
+/// @brief Check if key could be in bloom filter.
+/// @param[in] filter Pointer to filter.
+/// @param     hash   Hash of key.
+/// @return
+///     - @c true  : Key might be in filter.
+///     - @c false : Key is definitely not in filter.
+attr_core_api
+b32 bloom_filter_contains( const BloomFilter* filter, hash64 hash );
+/// @brief Insert string into bloom filter.
+/// @details
+/// String is hashed with #hash_city_64().
+/// @param[in] filter Pointer to filter.
+/// @param     str    String to insert.
+attr_always_inline attr_header
+void bloom_filter_insert_string( BloomFilter* filter, struct _StringPOD str ) {
+    bloom_filter_insert( filter, hash_city_64( str.len, str.cbuf ) );
+}
+/// @brief Check if string could be in bloom filter.
+/// @details
+/// String is hashed with #hash_city_64().
+/// @param[in] filter Pointer to filter.
+/// @param     str    String to check.
+/// @return
+///     - @c true  : String might be in filter.
+///     - @c false : String is definitely not in filter.
+attr_always_inline attr_header
+b32 bloom_filter_contains_string( const BloomFilter* filter, struct _StringPOD str ) {
+    return bloom_filter_contains( filter, hash_city_64( str.len, str.cbuf ) );
+}
+
+/// @brief Calculate cuckoo filter size from capacity and false positive rate.
+/// @details
+/// Fingerprints are between 8 and 16 bits so false positive rate
+/// is clamped to ~0.03 - ~0.00013.
+/// @param      capacity               Maximum number of keys in filter.
+/// @param      false_positive_rate    Target false positive rate. Must be > 0 and < 1.
+/// @param[out] out_bucket_count       Pointer to write number of buckets to.
+/// @param[out] out_fingerprint_bits   Pointer to write number of fingerprint bits to.
+/// @return Size of filter in bytes.
+attr_core_api
+usize cuckoo_filter_calculate_size(
+    usize capacity, f32 false_positive_rate,
+    usize* out_bucket_count, u32* out_fingerprint_bits );
+/// @brief Create cuckoo filter sized for capacity and false positive rate.
+/// @param[in]  allocator           Pointer to allocator interface.
+/// @param      capacity            Maximum number of keys in filter.
+/// @param      false_positive_rate Target false positive rate. Must be > 0 and < 1.
+/// @param[out] out_filter          Pointer to write filter to.
+/// @return
+///     - @c true  : Allocated filter.
+///     - @c false : Failed to allocate filter.
+attr_core_api
+b32 cuckoo_filter_create(
+    struct AllocatorInterface* allocator, usize capacity,
+    f32 false_positive_rate, CuckooFilter* out_filter );
+/// @brief Free cuckoo filter.
+/// @param[in] allocator Pointer to allocator interface used to create filter.
+/// @param[in] filter    Pointer to filter to free.
+attr_core_api
+void cuckoo_filter_free(
+    struct AllocatorInterface* allocator, CuckooFilter* filter );
+/// @brief Remove all keys from cuckoo filter.
+/// @param[in] filter Pointer to filter.
+attr_core_api
+void cuckoo_filter_clear( CuckooFilter* filter );
+/// @brief Insert key into cuckoo filter.
+/// @param[in] filter Pointer to filter.
+/// @param     hash   Hash of key.
+/// @return
+///     - @c true  : Inserted key.
+///     - @c false : Filter is full.
+attr_core_api
+b32 cuckoo_filter_insert( CuckooFilter* filter, hash64 hash );
+/// @brief Check if key could be in cuckoo filter.
+/// @param[in] filter Pointer to filter.
+/// @param     hash   Hash of key.
+/// @return
+///     - @c true  : Key might be in filter.
+///     - @c false : Key is definitely not in filter.
+attr_core_api
+b32 cuckoo_filter_contains( const CuckooFilter* filter, hash64 hash );
+/// @brief Remove key from cuckoo filter.
+/// @warning Only remove keys that were previously inserted.
+/// @param[in] filter Pointer to filter.
+/// @param     hash   Hash of key.
+/// @return
+///     - @c true  : Removed key.
+///     - @c false : Key was not in filter.
+attr_core_api
+b32 cuckoo_filter_remove( CuckooFilter* filter, hash64 hash );
+/// @brief Insert string into cuckoo filter.
+/// @details
+/// String is hashed with #hash_city_64().
+/// @param[in] filter Pointer to filter.
+/// @param     str    String to insert.
+/// @return
+///     - @c true  : Inserted string.
+///     - @c false : Filter is full.
+attr_always_inline attr_header
+b32 cuckoo_filter_insert_string( CuckooFilter* filter, struct _StringPOD str ) {
+    return cuckoo_filter_insert( filter, hash_city_64( str.len, str.cbuf ) );
+}
+/// @brief Check if string could be in cuckoo filter.
+/// @details
+/// String is hashed with #hash_city_64().
+/// @param[in] filter Pointer to filter.
+/// @param     str    String to check.
+/// @return
+///     - @c true  : String might be in filter.
+///     - @c false : String is definitely not in filter.
+attr_always_inline attr_header
+b32 cuckoo_filter_contains_string( const CuckooFilter* filter, struct _StringPOD str ) {
+    return cuckoo_filter_contains( filter, hash_city_64( str.len, str.cbuf ) );
+}
+/// @brief Remove string from cuckoo filter.
+/// @details
+/// String is hashed with #hash_city_64().
+/// @param[in] filter Pointer to filter.
+/// @param     str    String to remove.
+/// @return
+///     - @c true  : Removed string.
+///     - @c false : String was not in filter.
+attr_always_inline attr_header
+b32 cuckoo_filter_remove_string( CuckooFilter* filter, struct _StringPOD str ) {
+    return cuckoo_filter_remove( filter, hash_city_64( str.len, str.cbuf ) );
+}
+
+#endif /* header guard */
@@ -57,12 +57,19 @@ typedef enum FormatFloatFlags {
     FMT_FLOAT_VECTOR4     = 0b00110000,
     /// @brief Floats are 64-bit. (doubles)
     FMT_FLOAT_F64         = 0b01000000,
+    /// @brief Format shortest digits that parse back to same float, precision is ignored.
+    FMT_FLOAT_SHORTEST    = 0b10000000,
+    /// @brief Format in scientific notation, precision is number of digits after first.
+    FMT_FLOAT_SCIENTIFIC  = 0b00000001 << 8,
 } FormatFloatFlags;
 /// @brief Mask for extracting which type of vector float is.
 #define FMT_FLOAT_VECTOR_MASK\
     (FMT_FLOAT_VECTOR2 | FMT_FLOAT_VECTOR3 | FMT_FLOAT_VECTOR4)
 /// @brief Maximum allowed float precision.
-#define FMT_FLOAT_MAX_PRECISION (6)
+/// @details
+/// Floats are formatted exactly, no float has non-zero digits
+/// past this many decimal places (smallest f64 is 2^-1074).
+#define FMT_FLOAT_MAX_PRECISION (1074)
 /// Flags for integer formatting.
 typedef enum FormatIntFlags {
     /// @brief Format integer as if it is an amount of memory.
@@ -9,6 +9,8 @@
 #include "core/types.h"
 #include "core/attributes.h"
 
+struct _StringPOD;
+
 /// @brief Elf 64-bit hash function.
 /// @param     len Length of @c buf in bytes.
 /// @param[in] buf Pointer to start of buffer to hash.
@@ -36,5 +38,58 @@ hash64 hash_murmur2_64( usize len, const void* buf );
 /// @return 64-bit hash of @c buf.
 attr_core_api
 hash64 hash_city_64( usize len, const void* buf );
+/// @brief Cityhash 64-bit hash function, ignoring case of ASCII letters.
+/// @details
+/// Produces the same hash as #hash_city_64() on a copy of @c buf
+/// with ASCII upper-case letters converted to lower-case,
+/// letters are folded 8 bytes at a time as they are loaded
+/// so nothing is copied.
+/// @param     len Length of @c buf in bytes.
+/// @param[in] buf Pointer to start of buffer to hash.
+/// @return 64-bit hash of @c buf.
+attr_core_api
+hash64 hash_city_64_ascii_nocase( usize len, const void* buf );
+
+/// @brief Elf 64-bit hash function over array of strings.
+/// @details
+/// Produces the same hashes as calling #hash_elf_64() on each key.
+/// @param      count      Number of keys.
+/// @param[in]  keys       Pointer to array of keys.
+/// @param[out] out_hashes Pointer to array to write hashes to. Must be able to hold @c count hashes.
+attr_core_api
+void hash_elf_64_batch(
+    usize count, const struct _StringPOD* keys, hash64* out_hashes );
+/// @brief MurmurHash2 64-bit hash function over array of strings.
+/// @details
+/// Produces the same hashes as calling #hash_murmur2_64() on each key.
+/// @param      count      Number of keys.
+/// @param[in]  keys       Pointer to array of keys.
+/// @param[out] out_hashes Pointer to array to write hashes to. Must be able to hold @c count hashes.
+attr_core_api
+void hash_murmur2_64_batch(
+    usize count, const struct _StringPOD* keys, hash64* out_hashes );
+/// @brief Cityhash 64-bit hash function over array of strings.
+/// @details
+/// Produces the same hashes as calling #hash_city_64() on each key.
+/// @param      count      Number of keys.
+/// @param[in]  keys       Pointer to array of keys.
+/// @param[out] out_hashes Pointer to array to write hashes to. Must be able to hold @c count hashes.
+attr_core_api
+void hash_city_64_batch(
+    usize count, const struct _StringPOD* keys, hash64* out_hashes );
+/// @brief MurmurHash2 64-bit hash function over array of fixed-width keys.
+/// @details
+/// Produces the same hashes as calling #hash_murmur2_64() on each key.
+///
+/// Keys are tightly packed so key @c i starts at @c keys + ( @c i * @c key_size ).
+/// Several keys are hashed in lock-step since they all
+/// go through the same number of rounds.
+/// @param      count      Number of keys.
+/// @param      key_size   Size of each key in bytes.
+/// @param[in]  keys       Pointer to start of keys.
+/// @param[out] out_hashes Pointer to array to write hashes to. Must be able to hold @c count hashes.
+attr_core_api
+void hash_murmur2_64_batch_fixed(
+    usize count, usize key_size, const void* keys, hash64* out_hashes );
 
 #endif /* header guard */
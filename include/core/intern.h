@@ -0,0 +1,151 @@
+#if !defined(CORE_INTERN_H)
+#define CORE_INTERN_H
+/**
+ * @file   intern.h
+ * @brief  String interning.
+ * @author Alicia Amarilla (smushyaa@gmail.com)
+ * @date   October 18, 2026
+*/
+#include "core/types.h"
+#include "core/attributes.h"
+#include "core/macros.h"
+#include "core/string.h"
+#include "core/sync.h"
+
+struct AllocatorInterface;
+
+/// @brief Number of shards in string interner.
+/// @details
+/// Each shard has its own lock, hash table and arena
+/// so threads interning different strings rarely contend.
+/// Must be a power of two.
+#define CORE_INTERNER_SHARD_COUNT (16)
+
+#if !defined(CORE_INTERNER_DEFAULT_BLOCK_SIZE)
+    /// @brief Default size of interner arena blocks.
+    #define CORE_INTERNER_DEFAULT_BLOCK_SIZE (kibibytes(16))
+#endif
+
+/// @brief Handle to interned string.
+/// @details
+/// Handles are stable for the lifetime of the interner.
+/// Zero is never a valid handle.
+typedef u32 InternHandle;
+
+/// @brief Invalid intern handle.
+#define INTERN_HANDLE_NULL ((InternHandle)0)
+
+/// @brief Interned string entry.
+typedef struct InternEntry {
+    /// @brief Canonical string. Always null terminated.
+    struct _StringPOD str;
+    /// @brief Hash of string.
+    hash64 hash;
+} InternEntry;
+
+/// @brief Shard of string interner.
+/// @note Fields are internal, do not modify them directly.
+typedef struct InternShard {
+    /// @brief Lock for this shard.
+    Mutex        mtx;
+    /// @brief Number of slots in hash table. Always power of two.
+    u32          slot_cap;
+    /// @brief Number of entries.
+    u32          len;
+    /// @brief Capacity of entries.
+    u32          cap;
+    /// @brief Hash table of entry indices + 1. Zero is an empty slot.
+    u32*         slots;
+    /// @brief Interned entries.
+    InternEntry* entries;
+    /// @brief Current arena block.
+    void*        block;
+} InternShard;
+
+/// @brief Concurrent string interner.
+/// @details
+/// Stores a single copy of each unique string in an arena.
+/// Interned strings never move so two interned strings are
+/// equal if and only if their pointers are equal.
+typedef struct StringInterner {
+    /// @brief Allocator for arena blocks and tables.
+    struct AllocatorInterface* allocator;
+    /// @brief Size of arena blocks.
+    usize                      block_size;
+    /// @brief Shards.
+    InternShard                shards[CORE_INTERNER_SHARD_COUNT];
+} StringInterner;
+
+/// @brief Initialize string interner.
+/// @details
+/// Does not allocate, memory is allocated lazily when strings are interned.
+/// @param[in]  allocator      Pointer to allocator interface.
+/// @param      opt_block_size (optional) Size of arena blocks. Zero for #CORE_INTERNER_DEFAULT_BLOCK_SIZE.
+/// @param[out] out_interner   Pointer to write interner to.
+attr_core_api
+void interner_init(
+    struct AllocatorInterface* allocator,
+    usize opt_block_size, StringInterner* out_interner );
+/// @brief Free all memory owned by string interner.
+/// @details
+/// All interned strings and handles are invalidated.
+/// @param[in] interner Pointer to interner.
+attr_core_api
+void interner_free( StringInterner* interner );
+/// @brief Intern a string.
+/// @details
+/// If string was already interned, returns existing entry,
+/// otherwise copies string to interner arena.
+/// Safe to call from multiple threads.
+/// @param[in]  interner       Pointer to interner.
+/// @param      str            String to intern.
+/// @param[out] opt_out_handle (optional) Pointer to write handle to.
+/// @param[out] opt_out_string (optional) Pointer to write canonical string to.
+/// @return
+///     - @c true  : String was interned.
+///     - @c false : Failed to allocate space for string.
+attr_core_api
+b32 interner_intern(
+    StringInterner* interner, struct _StringPOD str,
+    InternHandle* opt_out_handle, struct _StringPOD* opt_out_string );
+/// @brief Search for string in interner without interning it.
+/// @details
+/// Safe to call from multiple threads.
+/// @param[in]  interner       Pointer to interner.
+/// @param      str            String to search for.
+/// @param[out] opt_out_handle (optional) Pointer to write handle to.
+/// @param[out] opt_out_string (optional) Pointer to write canonical string to.
+/// @return
+///     - @c true  : String is interned.
+///     - @c false : String is not interned.
+attr_core_api
+b32 interner_find(
+    StringInterner* interner, struct _StringPOD str,
+    InternHandle* opt_out_handle, struct _StringPOD* opt_out_string );
+/// @brief Get canonical string from handle.
+/// @details
+/// Safe to call from multiple threads.
+/// @param[in] interner Pointer to interner.
+/// @param     handle   Handle to interned string.
+/// @return
+///     - Empty string : @c handle is not a valid handle.
+///     - String       : Canonical string.
+attr_core_api
+struct _StringPOD interner_query_string(
+    StringInterner* interner, InternHandle handle );
+/// @brief Get number of unique strings in interner.
+/// @param[in] interner Pointer to interner.
+/// @return Number of interned strings.
+attr_core_api
+usize interner_query_count( StringInterner* interner );
+/// @brief Compare canonical strings obtained from the same interner.
+/// @param a, b Canonical strings.
+/// @return
+///     - @c true  : @c a and @c b are the same string.
+///     - @c false : @c a and @c b are different strings.
+attr_always_inline attr_header
+b32 interned_string_cmp( struct _StringPOD a, struct _StringPOD b ) {
+    return a.cbuf == b.cbuf;
+}
+
+#endif /* header guard */
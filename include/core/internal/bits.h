@@ -0,0 +1,154 @@
+#if !defined(CORE_INTERNAL_BITS_H)
+#define CORE_INTERNAL_BITS_H
+/**
+ * Description:  Internal bit manipulation helpers.
+ * Author:       Alicia Amarilla (smushyaa@gmail.com)
+ * File Created: October 18, 2026
+*/
+#include "core/defines.h"
+#include "core/types.h"
+#include "core/attributes.h"
+
+#if defined(CORE_COMPILER_MSVC)
+    #include <intrin.h>
+#endif
+
+/// @brief Hint that memory at pointer is going to be read soon.
+#if defined(CORE_COMPILER_GCC) || defined(CORE_COMPILER_CLANG)
+    #define internal_prefetch( ptr ) __builtin_prefetch( (const void*)(ptr) )
+#elif defined(CORE_COMPILER_MSVC) && defined(CORE_ARCH_X86)
+    #define internal_prefetch( ptr ) _mm_prefetch( (const char*)(ptr), _MM_HINT_T0 )
+#else
+    #define internal_prefetch( ptr )
+#endif
+
+/// @brief Count trailing zero bits. Value must not be zero.
+attr_always_inline inline attr_internal
+u32 internal_bits_ctz32( u32 value ) {
+#if defined(CORE_COMPILER_MSVC)
+    unsigned long result = 0;
+    _BitScanForward( &result, value );
+    return (u32)result;
+#else
+    return (u32)__builtin_ctz( value );
+#endif
+}
+/// @brief Count trailing zero bits. Value must not be zero.
+attr_always_inline inline attr_internal
+u32 internal_bits_ctz64( u64 value ) {
+#if defined(CORE_COMPILER_MSVC)
+    unsigned long result = 0;
+    #if defined(CORE_ARCH_64_BIT)
+        _BitScanForward64( &result, value );
+    #else
+        if( (u32)value ) {
+            _BitScanForward( &result, (u32)value );
+        } else {
+            _BitScanForward( &result, (u32)(value >> 32) );
+            result += 32;
+        }
+    #endif
+    return (u32)result;
+#else
+    return (u32)__builtin_ctzll( value );
+#endif
+}
+/// @brief Count leading zero bits. Value must not be zero.
+attr_always_inline inline attr_internal
+u32 internal_bits_clz32( u32 value ) {
+#if defined(CORE_COMPILER_MSVC)
+    unsigned long result = 0;
+    _BitScanReverse( &result, value );
+    return 31 - (u32)result;
+#else
+    return (u32)__builtin_clz( value );
+#endif
+}
+/// @brief Count leading zero bits. Value must not be zero.
+attr_always_inline inline attr_internal
+u32 internal_bits_clz64( u64 value ) {
+#if defined(CORE_COMPILER_MSVC)
+    unsigned long result = 0;
+    #if defined(CORE_ARCH_64_BIT)
+        _BitScanReverse64( &result, value );
+    #else
+        if( value >> 32 ) {
+            _BitScanReverse( &result, (u32)(value >> 32) );
+            result += 32;
+        } else {
+            _BitScanReverse( &result, (u32)value );
+        }
+    #endif
+    return 63 - (u32)result;
+#else
+    return (u32)__builtin_clzll( value );
+#endif
+}
+/// @brief Count set bits.
+/// @note
+/// Not using builtin, without -mpopcnt it becomes
+/// a call into libgcc which is not linked with -nostdlib.
+attr_always_inline inline attr_internal
+u32 internal_bits_popcount32( u32 value ) {
+    value = value - ((value >> 1) & 0x55555555u);
+    value = (value & 0x33333333u) + ((value >> 2) & 0x33333333u);
+    value = (value + (value >> 4)) & 0x0F0F0F0Fu;
+    return (value * 0x01010101u) >> 24;
+}
+/// @brief Count set bits.
+attr_always_inline inline attr_internal
+u32 internal_bits_popcount64( u64 value ) {
+    value = value - ((value >> 1) & 0x5555555555555555ull);
+    value = (value & 0x3333333333333333ull) + ((value >> 2) & 0x3333333333333333ull);
+    value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return (u32)((value * 0x0101010101010101ull) >> 56);
+}
+/// @brief Multiply 64-bit integers into 128-bit product.
+/// @param      a, b     Integers to multiply.
+/// @param[out] out_high Pointer to write upper 64 bits of product to.
+/// @return Lower 64 bits of product.
+attr_always_inline inline attr_internal
+u64 internal_bits_mul64( u64 a, u64 b, u64* out_high ) {
+#if (defined(CORE_COMPILER_GCC) || defined(CORE_COMPILER_CLANG)) && defined(CORE_ARCH_64_BIT)
+    __extension__ unsigned __int128 product = (unsigned __int128)a * b;
+    *out_high = (u64)(product >> 64);
+    return (u64)product;
+#elif defined(CORE_COMPILER_MSVC) && defined(CORE_ARCH_64_BIT) && defined(CORE_ARCH_X86)
+    return _umul128( a, b, out_high );
+#else
+    u64 a_lo = (u32)a, a_hi = a >> 32;
+    u64 b_lo = (u32)b, b_hi = b >> 32;
+
+    u64 lo_lo = a_lo * b_lo;
+    u64 hi_lo = a_hi * b_lo;
+    u64 lo_hi = a_lo * b_hi;
+    u64 hi_hi = a_hi * b_hi;
+
+    u64 cross = (lo_lo >> 32) + (u32)hi_lo + lo_hi;
+    *out_high = hi_hi + (hi_lo >> 32) + (cross >> 32);
+    return (cross << 32) | (u32)lo_lo;
+#endif
+}
+/// @brief Reverse order of bytes in integer.
+attr_always_inline inline attr_internal
+u64 internal_bits_bswap64( u64 value ) {
+#if defined(CORE_COMPILER_MSVC)
+    return _byteswap_uint64( value );
+#else
+    return __builtin_bswap64( value );
+#endif
+}
+/// @brief Load 8 bytes as little-endian integer, pointer does not need to be aligned.
+/// @note
+/// Compilers recognize pattern and emit a single load
+/// on little-endian targets.
+attr_always_inline inline attr_internal
+u64 internal_bits_load_le64( const u8* bytes ) {
+    return
+        ((u64)bytes[0] <<  0) | ((u64)bytes[1] <<  8) |
+        ((u64)bytes[2] << 16) | ((u64)bytes[3] << 24) |
+        ((u64)bytes[4] << 32) | ((u64)bytes[5] << 40) |
+        ((u64)bytes[6] << 48) | ((u64)bytes[7] << 56);
+}
+
+#endif /* header guard */
@@ -0,0 +1,216 @@
+#if !defined(CORE_MATCHER_H)
+#define CORE_MATCHER_H
+/**
+ * @file   matcher.h
+ * @brief  Multi-pattern string matching.
+ * @details
+ * Aho-Corasick automaton that searches for any number of
+ * patterns in a single pass over text.
+ *
+ * Automaton is compiled into a dense transition table,
+ * bytes that do not appear in any pattern share a single
+ * column so table width is number of distinct pattern bytes + 1.
+ *
+ * Matches are reported through a callback, either every
+ * (possibly overlapping) match or only leftmost-longest
+ * non-overlapping matches.
+ * Text can be searched all at once or streamed in chunks.
+ * @author Alicia Amarilla (smushyaa@gmail.com)
+ * @date   October 18, 2026
+*/
+#include "core/types.h"
+#include "core/attributes.h"
+#include "core/string.h"
+#include "core/stream.h"
+
+struct AllocatorInterface;
+
+/// @brief Which matches to report.
+typedef enum MultiMatchKind {
+    /// @brief Report every match, including overlapping matches.
+    /// Matches are reported in order of end position.
+    MULTI_MATCH_ALL,
+    /// @brief Report leftmost-longest non-overlapping matches.
+    /// At each position, longest pattern starting there is reported
+    /// and search continues after end of match.
+    MULTI_MATCH_LEFTMOST_LONGEST,
+} MultiMatchKind;
+
+/// @brief Single match.
+typedef struct MultiMatch {
+    /// @brief Index of pattern that matched.
+    usize pattern;
+    /// @brief Offset of start of match from beginning of text.
+    usize start;
+    /// @brief Length of match.
+    usize len;
+} MultiMatch;
+
+/// @brief Function that receives matches.
+/// @param[in] match  Pointer to match.
+/// @param[in] params (optional) Additional parameters.
+/// @return
+///     - @c true  : Continue searching.
+///     - @c false : Stop searching.
+typedef b32 MultiMatchFN( const MultiMatch* match, void* params );
+
+/// @brief State of multi-pattern matcher automaton.
+typedef struct MultiMatcherState {
+    /// @brief Length of prefix that state represents.
+    u32 depth;
+    /// @brief Index + 1 of first pattern that ends at this state. Zero if none.
+    u32 pattern;
+    /// @brief Closest state through failure links that has patterns. Zero if none.
+    u32 dictionary;
+} MultiMatcherState;
+
+/// @brief Multi-pattern matcher.
+typedef struct MultiMatcher {
+    /// @brief Number of patterns.
+    usize pattern_count;
+    /// @brief Length of longest pattern.
+    usize max_len;
+    /// @brief Number of states in automaton.
+    u32   state_count;
+    /// @brief Number of byte classes, width of transition table.
+    u32   class_count;
+    /// @brief Byte class of each byte.
+    u16   byte_class[256];
+    /// @brief First bytes of all patterns.
+    /// @details
+    /// When no pattern is partially matched, search skips
+    /// ahead to next byte in set. Only used when set is small
+    /// enough to be searched with SIMD.
+    ByteSet start_set;
+    /// @brief Transition table, @c state_count rows of @c class_count states.
+    u32* transitions;
+    /// @brief Per state depth and outputs.
+    MultiMatcherState* states;
+    /// @brief Length of each pattern.
+    u32* pattern_len;
+    /// @brief Index + 1 of next pattern with identical bytes. Zero if none.
+    u32* pattern_next;
+    /// @brief Size of allocation that holds tables.
+    usize memory_size;
+} MultiMatcher;
+
+/// @brief Streaming search state.
+/// @details
+/// Chunks are written with #multi_matcher_stream_write(),
+/// which is compatible with #StreamBytesFN.
+/// Leftmost-longest matches are only reported once they can no longer
+/// be extended so #multi_matcher_stream_finish() must be called after
+/// last chunk.
+typedef struct MultiMatcherStream {
+    /// @brief Pointer to matcher.
+    const MultiMatcher* matcher;
+    /// @brief Which matches to report.
+    MultiMatchKind      kind;
+    /// @brief Current automaton state.
+    u32                 state;
+    /// @brief Function that receives matches.
+    MultiMatchFN*       callback;
+    /// @brief Additional parameters for callback.
+    void*               params;
+    /// @brief Number of bytes written to stream.
+    usize               offset;
+    /// @brief Offset of next byte to run through automaton.
+    usize               cursor;
+    /// @brief Number of matches reported.
+    usize               match_count;
+    /// @brief If true, callback requested to stop.
+    b32                 stopped;
+    /// @brief If true, @c best is a leftmost-longest candidate that is not yet reported.
+    b32                 has_best;
+    /// @brief Leftmost-longest candidate.
+    MultiMatch          best;
+    /// @brief Ring buffer of most recent bytes. Only used for leftmost-longest.
+    u8*                 history;
+    /// @brief Capacity of @c history. Always power of two.
+    usize               history_cap;
+} MultiMatcherStream;
+
+/// @brief Create multi-pattern matcher.
+/// @details
+/// Patterns are not referenced after matcher is created.
+/// Empty patterns never match.
+/// @param[in]  allocator     Pointer to allocator interface.
+/// @param      pattern_count Number of patterns.
+/// @param[in]  patterns      Pointer to patterns.
+/// @param[out] out_matcher   Pointer to write matcher to.
+/// @return
+///     - @c true  : Created matcher.
+///     - @c false : Failed to allocate matcher.
+attr_core_api
+b32 multi_matcher_create(
+    struct AllocatorInterface* allocator, usize pattern_count,
+    const struct _StringPOD* patterns, MultiMatcher* out_matcher );
+/// @brief Free multi-pattern matcher.
+/// @param[in] allocator Pointer to allocator interface used to create matcher.
+/// @param[in] matcher   Pointer to matcher to free.
+attr_core_api
+void multi_matcher_free(
+    struct AllocatorInterface* allocator, MultiMatcher* matcher );
+/// @brief Search for patterns in string.
+/// @param[in] matcher   Pointer to matcher.
+/// @param     kind      Which matches to report.
+/// @param     str       String to search in.
+/// @param[in] callback  Function that receives matches.
+/// @param[in] opt_params (optional) Additional parameters for callback.
+/// @return Number of matches reported.
+attr_core_api
+usize multi_matcher_find(
+    const MultiMatcher* matcher, MultiMatchKind kind, struct _StringPOD str,
+    MultiMatchFN* callback, void* opt_params );
+/// @brief Check if any pattern occurs in string.
+/// @param[in]  matcher       Pointer to matcher.
+/// @param      str           String to search in.
+/// @param[out] opt_out_match (optional) Pointer to write first match to, by end position.
+/// @return
+///     - @c true  : Found a pattern.
+///     - @c false : No pattern occurs in string.
+attr_core_api
+b32 multi_matcher_find_first(
+    const MultiMatcher* matcher, struct _StringPOD str, MultiMatch* opt_out_match );
+
+/// @brief Initialize streaming search.
+/// @param[in]  allocator  Pointer to allocator interface.
+/// @param[in]  matcher    Pointer to matcher. Must outlive stream.
+/// @param      kind       Which matches to report.
+/// @param[in]  callback   Function that receives matches.
+/// @param[in]  opt_params (optional) Additional parameters for callback.
+/// @param[out] out_stream Pointer to write stream to.
+/// @return
+///     - @c true  : Initialized stream.
+///     - @c false : Failed to allocate history buffer.
+attr_core_api
+b32 multi_matcher_stream_init(
+    struct AllocatorInterface* allocator, const MultiMatcher* matcher,
+    MultiMatchKind kind, MultiMatchFN* callback, void* opt_params,
+    MultiMatcherStream* out_stream );
+/// @brief Free streaming search.
+/// @param[in] allocator Pointer to allocator interface used to initialize stream.
+/// @param[in] stream    Pointer to stream to free.
+attr_core_api
+void multi_matcher_stream_free(
+    struct AllocatorInterface* allocator, MultiMatcherStream* stream );
+/// @brief Search next chunk of text.
+/// @details
+/// Compatible with #StreamBytesFN, target is pointer to #MultiMatcherStream.
+/// Match offsets are relative to start of first chunk.
+/// @param[in] target Pointer to #MultiMatcherStream.
+/// @param     count  Number of bytes in chunk.
+/// @param[in] bytes  Pointer to chunk.
+/// @return Always zero, chunks written after callback stops search are ignored.
+attr_core_api
+usize multi_matcher_stream_write( void* target, usize count, const void* bytes );
+/// @brief Finish streaming search.
+/// @details
+/// Reports leftmost-longest matches that were waiting for more text.
+/// Stream can not be written to after it is finished.
+/// @param[in] stream Pointer to stream.
+/// @return Number of matches reported over lifetime of stream.
+attr_core_api
+usize multi_matcher_stream_finish( MultiMatcherStream* stream );
+
+#endif /* header guard */
@@ -0,0 +1,392 @@
+#if !defined(CORE_SEARCH_H)
+#define CORE_SEARCH_H
+/**
+ * @file   search.h
+ * @brief  Searching algorithms.
+ * @details
+ * Binary searches are branchless so that lookups into large
+ * sorted tables do not pay for mispredicted branches.
+ *
+ * Eytzinger layout stores sorted items in breadth-first order of
+ * a complete binary search tree. Items that are visited together
+ * end up next to each other in memory so descendants can be prefetched.
+ * @author Alicia Amarilla (smushyaa@gmail.com)
+ * @date   October 18, 2026
+*/
+#include "core/types.h"
+#include "core/attributes.h"
+#include "core/sort.h"
+
+/// @brief Find first item in sorted buffer that is not less than value.
+/// @param     len    Number of items in buffer.
+/// @param[in] buffer Pointer to sorted integers.
+/// @param     value  Value to search for.
+/// @return Index of first item >= @c value, @c len if every item is less than @c value.
+attr_core_api
+usize lower_bound_i32( usize len, const i32* buffer, i32 value );
+/// @brief Find first item in sorted buffer that is greater than value.
+/// @param     len    Number of items in buffer.
+/// @param[in] buffer Pointer to sorted integers.
+/// @param     value  Value to search for.
+/// @return Index of first item > @c value, @c len if no item is greater than @c value.
+attr_core_api
+usize upper_bound_i32( usize len, const i32* buffer, i32 value );
+/// @brief Search for value in unsorted buffer.
+/// @details
+/// Compares multiple items at a time with SIMD.
+/// Faster than binary search for short buffers.
+/// @param     len    Number of items in buffer.
+/// @param[in] buffer Pointer to integers.
+/// @param     value  Value to search for.
+/// @return Index of first item equal to @c value, @c len if not found.
+attr_core_api
+usize linear_search_i32( usize len, const i32* buffer, i32 value );
+/// @brief Find first item in Eytzinger layout buffer that is not less than value.
+/// @param     len  Number of items in tree.
+/// @param[in] tree Pointer to integers in Eytzinger layout, see #eytzinger_from_sorted().
+/// @param     value  Value to search for.
+/// @return Index in @c tree of first item >= @c value, @c len if every item is less than @c value.
+attr_core_api
+usize eytzinger_lower_bound_i32( usize len, const i32* tree, i32 value );
+/// @brief Binary search for value in sorted buffer.
+/// @param      len           Number of items in buffer.
+/// @param[in]  buffer        Pointer to sorted integers.
+/// @param      value         Value to search for.
+/// @param[out] opt_out_index (optional) Pointer to write index of value to.
+/// @return
+///     - @c true  : Found value.
+///     - @c false : Value is not in buffer.
+attr_always_inline attr_header
+b32 ordered_binary_search_i32(
+    usize len, const i32* buffer, i32 value, usize* opt_out_index
+) {
+    usize index = lower_bound_i32( len, buffer, value );
+    if( index < len && buffer[index] == value ) {
+        if( opt_out_index ) {
+            *opt_out_index = index;
+        }
+        return true;
+    }
+    return false;
+}
+/// @brief Search for value in Eytzinger layout buffer.
+/// @param      len           Number of items in tree.
+/// @param[in]  tree          Pointer to integers in Eytzinger layout, see #eytzinger_from_sorted().
+/// @param      value         Value to search for.
+/// @param[out] opt_out_index (optional) Pointer to write index in @c tree of value to.
+/// @return
+///     - @c true  : Found value.
+///     - @c false : Value is not in tree.
+attr_always_inline attr_header
+b32 eytzinger_search_i32(
+    usize len, const i32* tree, i32 value, usize* opt_out_index
+) {
+    usize index = eytzinger_lower_bound_i32( len, tree, value );
+    if( index < len && tree[index] == value ) {
+        if( opt_out_index ) {
+            *opt_out_index = index;
+        }
+        return true;
+    }
+    return false;
+}
+
+/// @brief Find first item in sorted buffer that is not less than value.
+/// @param     len    Number of items in buffer.
+/// @param[in] buffer Pointer to sorted unsigned integers.
+/// @param     value  Value to search for.
+/// @return Index of first item >= @c value, @c len if every item is less than @c value.
+attr_core_api
+usize lower_bound_u32( usize len, const u32* buffer, u32 value );
+/// @brief Find first item in sorted buffer that is greater than value.
+/// @param     len    Number of items in buffer.
+/// @param[in] buffer Pointer to sorted unsigned integers.
+/// @param     value  Value to search for.
+/// @return Index of first item > @c value, @c len if no item is greater than @c value.
+attr_core_api
+usize upper_bound_u32( usize len, const u32* buffer, u32 value );
+/// @brief Search for value in unsorted buffer.
+/// @details
+/// Compares multiple items at a time with SIMD.
+/// Faster than binary search for short buffers.
+/// @param     len    Number of items in buffer.
+/// @param[in] buffer Pointer to unsigned integers.
+/// @param     value  Value to search for.
+/// @return Index of first item equal to @c value, @c len if not found.
+attr_core_api
+usize linear_search_u32( usize len, const u32* buffer, u32 value );
+/// @brief Find first item in Eytzinger layout buffer that is not less than value.
+/// @param     len  Number of items in tree.
+/// @param[in] tree Pointer to unsigned integers in Eytzinger layout, see #eytzinger_from_sorted().
+/// @param     value  Value to search for.
+/// @return Index in @c tree of first item >= @c value, @c len if every item is less than @c value.
+attr_core_api
+usize eytzinger_lower_bound_u32( usize len, const u32* tree, u32 value );
+/// @brief Binary search for value in sorted buffer.
+/// @param      len           Number of items in buffer.
+/// @param[in]  buffer        Pointer to sorted unsigned integers.
+/// @param      value         Value to search for.
+/// @param[out] opt_out_index (optional) Pointer to write index of value to.
+/// @return
+///     - @c true  : Found value.
+///     - @c false : Value is not in buffer.
+attr_always_inline attr_header
+b32 ordered_binary_search_u32(
+    usize len, const u32* buffer, u32 value, usize* opt_out_index
+) {
+    usize index = lower_bound_u32( len, buffer, value );
+    if( index < len && buffer[index] == value ) {
+        if( opt_out_index ) {
+            *opt_out_index = index;
+        }
+        return true;
+    }
+    return false;
+}
+/// @brief Search for value in Eytzinger layout buffer.
+/// @param      len           Number of items in tree.
+/// @param[in]  tree          Pointer to unsigned integers in Eytzinger layout, see #eytzinger_from_sorted().
+/// @param      value         Value to search for.
+/// @param[out] opt_out_index (optional) Pointer to write index in @c tree of value to.
+/// @return
+///     - @c true  : Found value.
+///     - @c false : Value is not in tree.
+attr_always_inline attr_header
+b32 eytzinger_search_u32(
+    usize len, const u32* tree, u32 value, usize* opt_out_index
+) {
+    usize index = eytzinger_lower_bound_u32( len, tree, value );
+    if( index < len && tree[index] == value ) {
+        if( opt_out_index ) {
+            *opt_out_index = index;
+        }
+        return true;
+    }
+    return false;
+}
+
+/// @brief Find first item in sorted buffer that is not less than value.
+/// @param     len    Number of items in buffer.
+/// @param[in] buffer Pointer to sorted floats.
+/// @param     value  Value to search for.
+/// @return Index of first item >= @c value, @c len if every item is less than @c value.
+attr_core_api
+usize lower_bound_f32( usize len, const f32* buffer, f32 value );
+/// @brief Find first item in sorted buffer that is greater than value.
+/// @param     len    Number of items in buffer.
+/// @param[in] buffer Pointer to sorted floats.
+/// @param     value  Value to search for.
+/// @return Index of first item > @c value, @c len if no item is greater than @c value.
+attr_core_api
+usize upper_bound_f32( usize len, const f32* buffer, f32 value );
+/// @brief Search for value in unsorted buffer.
+/// @details
+/// Compares multiple items at a time with SIMD.
+/// Faster than binary search for short buffers.
+/// @param     len    Number of items in buffer.
+/// @param[in] buffer Pointer to floats.
+/// @param     value  Value to search for.
+/// @return Index of first item equal to @c value, @c len if not found.
+attr_core_api
+usize linear_search_f32( usize len, const f32* buffer, f32 value );
+/// @brief Find first item in Eytzinger layout buffer that is not less than value.
+/// @param     len  Number of items in tree.
+/// @param[in] tree Pointer to floats in Eytzinger layout, see #eytzinger_from_sorted().
+/// @param     value  Value to search for.
+/// @return Index in @c tree of first item >= @c value, @c len if every item is less than @c value.
+attr_core_api
+usize eytzinger_lower_bound_f32( usize len, const f32* tree, f32 value );
+/// @brief Binary search for value in sorted buffer.
+/// @param      len           Number of items in buffer.
+/// @param[in]  buffer        Pointer to sorted floats.
+/// @param      value         Value to search for.
+/// @param[out] opt_out_index (optional) Pointer to write index of value to.
+/// @return
+///     - @c true  : Found value.
+///     - @c false : Value is not in buffer.
+attr_always_inline attr_header
+b32 ordered_binary_search_f32(
+    usize len, const f32* buffer, f32 value, usize* opt_out_index
+) {
+    usize index = lower_bound_f32( len, buffer, value );
+    if( index < len && buffer[index] == value ) {
+        if( opt_out_index ) {
+            *opt_out_index = index;
+        }
+        return true;
+    }
+    return false;
+}
+/// @brief Search for value in Eytzinger layout buffer.
+/// @param      len           Number of items in tree.
+/// @param[in]  tree          Pointer to floats in Eytzinger layout, see #eytzinger_from_sorted().
+/// @param      value         Value to search for.
+/// @param[out] opt_out_index (optional) Pointer to write index in @c tree of value to.
+/// @return
+///     - @c true  : Found value.
+///     - @c false : Value is not in tree.
+attr_always_inline attr_header
+b32 eytzinger_search_f32(
+    usize len, const f32* tree, f32 value, usize* opt_out_index
+) {
+    usize index = eytzinger_lower_bound_f32( len, tree, value );
+    if( index < len && tree[index] == value ) {
+        if( opt_out_index ) {
+            *opt_out_index = index;
+        }
+        return true;
+    }
+    return false;
+}
+
+/// @brief Find first item in sorted buffer that is not less than value.
+/// @param     len    Number of items in buffer.
+/// @param[in] buffer Pointer to sorted unsigned integers.
+/// @param     value  Value to search for.
+/// @return Index of first item >= @c value, @c len if every item is less than @c value.
+attr_core_api
+usize lower_bound_u64( usize len, const u64* buffer, u64 value );
+/// @brief Find first item in sorted buffer that is greater than value.
+/// @param     len    Number of items in buffer.
+/// @param[in] buffer Pointer to sorted unsigned integers.
+/// @param     value  Value to search for.
+/// @return Index of first item > @c value, @c len if no item is greater than @c value.
+attr_core_api
+usize upper_bound_u64( usize len, const u64* buffer, u64 value );
+/// @brief Search for value in unsorted buffer.
+/// @details
+/// Compares multiple items at a time with SIMD.
+/// Faster than binary search for short buffers.
+/// @param     len    Number of items in buffer.
+/// @param[in] buffer Pointer to unsigned integers.
+/// @param     value  Value to search for.
+/// @return Index of first item equal to @c value, @c len if not found.
+attr_core_api
+usize linear_search_u64( usize len, const u64* buffer, u64 value );
+/// @brief Find first item in Eytzinger layout buffer that is not less than value.
+/// @param     len  Number of items in tree.
+/// @param[in] tree Pointer to unsigned integers in Eytzinger layout, see #eytzinger_from_sorted().
+/// @param     value  Value to search for.
+/// @return Index in @c tree of first item >= @c value, @c len if every item is less than @c value.
+attr_core_api
+usize eytzinger_lower_bound_u64( usize len, const u64* tree, u64 value );
+/// @brief Binary search for value in sorted buffer.
+/// @param      len           Number of items in buffer.
+/// @param[in]  buffer        Pointer to sorted unsigned integers.
+/// @param      value         Value to search for.
+/// @param[out] opt_out_index (optional) Pointer to write index of value to.
+/// @return
+///     - @c true  : Found value.
+///     - @c false : Value is not in buffer.
+attr_always_inline attr_header
+b32 ordered_binary_search_u64(
+    usize len, const u64* buffer, u64 value, usize* opt_out_index
+) {
+    usize index = lower_bound_u64( len, buffer, value );
+    if( index < len && buffer[index] == value ) {
+        if( opt_out_index ) {
+            *opt_out_index = index;
+        }
+        return true;
+    }
+    return false;
+}
+/// @brief Search for value in Eytzinger layout buffer.
+/// @param      len           Number of items in tree.
+/// @param[in]  tree          Pointer to unsigned integers in Eytzinger layout, see #eytzinger_from_sorted().
+/// @param      value         Value to search for.
+/// @param[out] opt_out_index (optional) Pointer to write index in @c tree of value to.
+/// @return
+///     - @c true  : Found value.
+///     - @c false : Value is not in tree.
+attr_always_inline attr_header
+b32 eytzinger_search_u64(
+    usize len, const u64* tree, u64 value, usize* opt_out_index
+) {
+    usize index = eytzinger_lower_bound_u64( len, tree, value );
+    if( index < len && tree[index] == value ) {
+        if( opt_out_index ) {
+            *opt_out_index = index;
+        }
+        return true;
+    }
+    return false;
+}
+
+/// @brief Find first item in sorted buffer that is not less than value.
+/// @param     len            Number of items in buffer.
+/// @param     stride         Size of each item in buffer.
+/// @param[in] buffer         Pointer to sorted items.
+/// @param[in] value          Pointer to value to search for.
+/// @param     cmp            Function that returns true if lhs is less than rhs.
+/// @param[in] opt_cmp_params (optional) Parameters for comparison function.
+/// @return Index of first item >= @c value, @c len if every item is less than @c value.
+attr_core_api
+usize lower_bound_generic(
+    usize len, usize stride, const void* buffer, const void* value,
+    SortCmpFN* cmp, void* opt_cmp_params );
+/// @brief Find first item in sorted buffer that is greater than value.
+/// @param     len            Number of items in buffer.
+/// @param     stride         Size of each item in buffer.
+/// @param[in] buffer         Pointer to sorted items.
+/// @param[in] value          Pointer to value to search for.
+/// @param     cmp            Function that returns true if lhs is less than rhs.
+/// @param[in] opt_cmp_params (optional) Parameters for comparison function.
+/// @return Index of first item > @c value, @c len if no item is greater than @c value.
+attr_core_api
+usize upper_bound_generic(
+    usize len, usize stride, const void* buffer, const void* value,
+    SortCmpFN* cmp, void* opt_cmp_params );
+/// @brief Binary search for value in sorted buffer.
+/// @param      len            Number of items in buffer.
+/// @param      stride         Size of each item in buffer.
+/// @param[in]  buffer         Pointer to sorted items.
+/// @param[in]  value          Pointer to value to search for.
+/// @param      cmp            Function that returns true if lhs is less than rhs.
+/// @param[in]  opt_cmp_params (optional) Parameters for comparison function.
+/// @param[out] opt_out_index  (optional) Pointer to write index of value to.
+/// @return
+///     - @c true  : Found value.
+///     - @c false : Value is not in buffer.
+attr_core_api
+b32 ordered_binary_search_generic(
+    usize len, usize stride, const void* buffer, const void* value,
+    SortCmpFN* cmp, void* opt_cmp_params, usize* opt_out_index );
+/// @brief Search for value in unsorted buffer.
+/// @param     len            Number of items in buffer.
+/// @param     stride         Size of each item in buffer.
+/// @param[in] buffer         Pointer to items.
+/// @param[in] value          Pointer to value to search for.
+/// @param     cmp            Function that returns true if lhs and rhs are equal.
+/// @param[in] opt_cmp_params (optional) Parameters for comparison function.
+/// @return Index of first item equal to @c value, @c len if not found.
+attr_core_api
+usize linear_search_generic(
+    usize len, usize stride, const void* buffer, const void* value,
+    SearchCmpFN* cmp, void* opt_cmp_params );
+/// @brief Find first item in Eytzinger layout buffer that is not less than value.
+/// @param     len            Number of items in tree.
+/// @param     stride         Size of each item in tree.
+/// @param[in] tree           Pointer to items in Eytzinger layout, see #eytzinger_from_sorted().
+/// @param[in] value          Pointer to value to search for.
+/// @param     cmp            Function that returns true if lhs is less than rhs.
+/// @param[in] opt_cmp_params (optional) Parameters for comparison function.
+/// @return Index in @c tree of first item >= @c value, @c len if every item is less than @c value.
+attr_core_api
+usize eytzinger_lower_bound_generic(
+    usize len, usize stride, const void* tree, const void* value,
+    SortCmpFN* cmp, void* opt_cmp_params );
+/// @brief Copy sorted items into Eytzinger layout.
+/// @details
+/// Item at tree index @c i has children at @c 2i+1 and @c 2i+2.
+/// Can also be used to lay out values that belong to sorted keys
+/// since items are placed by index only.
+/// @param     len      Number of items.
+/// @param     stride   Size of each item.
+/// @param[in] sorted   Pointer to sorted items.
+/// @param[in] out_tree Pointer to write items in Eytzinger layout to. Must be able to hold @c len items and must not overlap @c sorted.
+attr_core_api
+void eytzinger_from_sorted(
+    usize len, usize stride, const void* sorted, void* out_tree );
+
+#endif /* header guard */
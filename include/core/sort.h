@@ -9,6 +9,8 @@
 #include "core/types.h"
 #include "core/attributes.h"
 
+struct AllocatorInterface;
+
 /// @brief Comparison function prototype for sorting.
 /// @param[in] lhs, rhs Pointer to values to compare.
 /// @param size Size of each value to compare.
@@ -23,7 +25,12 @@ typedef b32 SortCmpFN( void* lhs, void* rhs, usize size, void* params );
 /// @return True if lhs and rhs are equal.
 typedef SortCmpFN SearchCmpFN;
 
+/// @brief Maximum number of items sorted by sort_network_*.
+#define SORT_NETWORK_MAX (32)
+
 /// @brief Quicksort algorithm for i32.
+/// @details
+/// Introsort, worst case is O(n log n). Not stable.
 /// @note Prefer this function over #quicksort_generic() when sorting integers.
 /// @param from_inclusive Start of sort range, must be positive.
 /// @param to_inclusive End of sort range, must be > from_inclusive and positive.
@@ -33,6 +40,8 @@ attr_core_api
 void quicksort_i32(
     isize from_inclusive, isize to_inclusive, i32* buffer, b32 reverse );
 /// @brief Quicksort algorithm for u32.
+/// @details
+/// Introsort, worst case is O(n log n). Not stable.
 /// @note Prefer this function over #quicksort_generic() when sorting unsigned integers.
 /// @param from_inclusive Start of sort range, must be positive.
 /// @param to_inclusive End of sort range, must be > from_inclusive and positive.
@@ -42,6 +51,8 @@ attr_core_api
 void quicksort_u32(
     isize from_inclusive, isize to_inclusive, u32* buffer, b32 reverse );
 /// @brief Quicksort algorithm for f32.
+/// @details
+/// Introsort, worst case is O(n log n). Not stable.
 /// @note Prefer this function over #quicksort_generic() when sorting floats.
 /// @param from_inclusive Start of sort range, must be positive.
 /// @param to_inclusive End of sort range, must be > from_inclusive and positive.
@@ -50,8 +61,44 @@ void quicksort_u32(
 attr_core_api
 void quicksort_f32(
     isize from_inclusive, isize to_inclusive, f32* buffer, b32 reverse );
+/// @brief Sort short buffer of integers with a sorting network.
+/// @details
+/// Buffer is padded to the next block of 4, 8, 16 or 32 items
+/// and sorted with a bitonic network, four compare-exchanges at a time.
+/// Not stable. Also used as the base case of #quicksort_i32().
+/// Falls back to insertion sort without SIMD and to quicksort when @c len > #SORT_NETWORK_MAX.
+/// @param     len     Number of items in buffer.
+/// @param[in] buffer  Pointer to integers to sort.
+/// @param     reverse If true, numbers are sorted from greatest -> least, otherwise least -> greatest.
+attr_core_api
+void sort_network_i32( usize len, i32* buffer, b32 reverse );
+/// @brief Sort short buffer of unsigned integers with a sorting network.
+/// @details
+/// Buffer is padded to the next block of 4, 8, 16 or 32 items
+/// and sorted with a bitonic network, four compare-exchanges at a time.
+/// Not stable. Also used as the base case of #quicksort_u32().
+/// Falls back to insertion sort without SIMD and to quicksort when @c len > #SORT_NETWORK_MAX.
+/// @param     len     Number of items in buffer.
+/// @param[in] buffer  Pointer to unsigned integers to sort.
+/// @param     reverse If true, numbers are sorted from greatest -> least, otherwise least -> greatest.
+attr_core_api
+void sort_network_u32( usize len, u32* buffer, b32 reverse );
+/// @brief Sort short buffer of floats with a sorting network.
+/// @details
+/// Buffer is padded to the next block of 4, 8, 16 or 32 items
+/// and sorted with a bitonic network, four compare-exchanges at a time.
+/// Not stable. Also used as the base case of #quicksort_f32().
+/// Falls back to insertion sort without SIMD and to quicksort when @c len > #SORT_NETWORK_MAX.
+/// @param     len     Number of items in buffer.
+/// @param[in] buffer  Pointer to floats to sort.
+/// @param     reverse If true, numbers are sorted from greatest -> least, otherwise least -> greatest.
+attr_core_api
+void sort_network_f32( usize len, f32* buffer, b32 reverse );
 
 /// @brief Generic quicksort algorithm.
+/// @details
+/// Introsort, worst case is O(n log n). Not stable.
+/// @c cmp should return true if lhs should be sorted before rhs.
 /// @param from_inclusive Start of sort range, must be positive.
 /// @param to_inclusive End of sort range, must be > from_inclusive and positive.
 /// @param stride Size of each value in buffer.
@@ -74,4 +121,419 @@ attr_core_api
 void sort_reverse(
     usize len, usize stride, void* buffer, void* swap_buffer );
 
+/// @brief Stable generic merge sort.
+/// @details
+/// Adaptive merge sort in the style of TimSort.
+/// Existing ascending and descending runs are detected and merged,
+/// so sorted, reversed and partially sorted input is close to O(n).
+/// Worst case is O(n log n). Equal items keep their order.
+/// @c cmp should return true if lhs should be sorted before rhs.
+/// @param[in] allocator      Pointer to allocator interface for scratch memory. Allocates up to (len / 2) + 1 items.
+/// @param     len            Number of items in buffer.
+/// @param     stride         Size of each value in buffer.
+/// @param[in] buffer         Pointer to values to sort.
+/// @param     cmp            Function to use for comparisons.
+/// @param[in] opt_cmp_params (optional) Parameters for comparison function.
+/// @return
+///     - @c true  : Sorted buffer.
+///     - @c false : Failed to allocate scratch memory, buffer is unchanged.
+attr_core_api
+b32 merge_sort_generic(
+    struct AllocatorInterface* allocator, usize len,
+    usize stride, void* buffer,
+    SortCmpFN* cmp, void* opt_cmp_params );
+/// @brief Get sorted order of items without moving them.
+/// @details
+/// Writes indices of items in sorted order to @c out_indices.
+/// Sort is stable so equal items are ordered by index.
+/// Prefer this over sorting buffer directly when stride is large,
+/// only indices are moved while sorting.
+/// @param[in]  allocator      Pointer to allocator interface for scratch memory.
+/// @param      len            Number of items in buffer.
+/// @param      stride         Size of each value in buffer.
+/// @param[in]  buffer         Pointer to values to sort.
+/// @param      cmp            Function to use for comparisons.
+/// @param[in]  opt_cmp_params (optional) Parameters for comparison function.
+/// @param[out] out_indices    Pointer to write indices to. Must be able to hold @c len indices.
+/// @return
+///     - @c true  : Wrote sorted indices.
+///     - @c false : Failed to allocate scratch memory.
+attr_core_api
+b32 sort_indices_generic(
+    struct AllocatorInterface* allocator, usize len,
+    usize stride, const void* buffer,
+    SortCmpFN* cmp, void* opt_cmp_params, usize* out_indices );
+/// @brief Reorder items in buffer so that item i is the item that was at indices[i].
+/// @details
+/// Each item is moved once.
+/// @param     len         Number of items in buffer and indices.
+/// @param     stride      Size of each item in buffer.
+/// @param[in] buffer      Pointer to items to reorder.
+/// @param[in] indices     Pointer to indices, for example from #sort_indices_generic(). Overwritten with 0..len-1.
+/// @param[in] swap_buffer Pointer to swap buffer, must be able to hold stride bytes.
+attr_core_api
+void sort_apply_indices(
+    usize len, usize stride, void* buffer, usize* indices, void* swap_buffer );
+
+/// @brief Partially sort integers so that nth item is in its sorted position.
+/// @details
+/// Introselect, average O(n). Items before nth are not greater
+/// than it and items after nth are not less than it, in no particular order.
+/// @param     len     Number of items in buffer.
+/// @param[in] buffer  Pointer to integers.
+/// @param     nth     Index of item to select. Nothing happens if >= @c len.
+/// @param     reverse If true, order is greatest -> least, otherwise least -> greatest.
+attr_core_api
+void select_nth_i32( usize len, i32* buffer, usize nth, b32 reverse );
+/// @brief Sort only first count items of integers.
+/// @details
+/// After sorting, first @c count items are the items that would be
+/// there if whole buffer was sorted. Rest of buffer is in no particular order.
+/// O(n + count log count).
+/// @param     len     Number of items in buffer.
+/// @param[in] buffer  Pointer to integers.
+/// @param     count   Number of items to sort. Clamped to @c len.
+/// @param     reverse If true, order is greatest -> least, otherwise least -> greatest.
+attr_core_api
+void partial_sort_i32( usize len, i32* buffer, usize count, b32 reverse );
+/// @brief Copy k first integers in sorted order without modifying buffer.
+/// @details
+/// Keeps a bounded heap of k items, O(n log k).
+/// Items that cannot make it into the heap are skipped with SIMD compares.
+/// @param      len     Number of items in buffer.
+/// @param[in]  buffer  Pointer to integers.
+/// @param      k       Number of items to copy.
+/// @param[out] out_top Pointer to write items to, in sorted order. Must be able to hold @c k items.
+/// @param      reverse If true, copies k greatest, otherwise k least.
+/// @return Number of items written to @c out_top, min(@c k, @c len).
+attr_core_api
+usize top_k_i32(
+    usize len, const i32* buffer, usize k, i32* out_top, b32 reverse );
+/// @brief Partially sort unsigned integers so that nth item is in its sorted position.
+/// @details
+/// Introselect, average O(n). Items before nth are not greater
+/// than it and items after nth are not less than it, in no particular order.
+/// @param     len     Number of items in buffer.
+/// @param[in] buffer  Pointer to unsigned integers.
+/// @param     nth     Index of item to select. Nothing happens if >= @c len.
+/// @param     reverse If true, order is greatest -> least, otherwise least -> greatest.
+attr_core_api
+void select_nth_u32( usize len, u32* buffer, usize nth, b32 reverse );
+/// @brief Sort only first count items of unsigned integers.
+/// @details
+/// After sorting, first @c count items are the items that would be
+/// there if whole buffer was sorted. Rest of buffer is in no particular order.
+/// O(n + count log count).
+/// @param     len     Number of items in buffer.
+/// @param[in] buffer  Pointer to unsigned integers.
+/// @param     count   Number of items to sort. Clamped to @c len.
+/// @param     reverse If true, order is greatest -> least, otherwise least -> greatest.
+attr_core_api
+void partial_sort_u32( usize len, u32* buffer, usize count, b32 reverse );
+/// @brief Copy k first unsigned integers in sorted order without modifying buffer.
+/// @details
+/// Keeps a bounded heap of k items, O(n log k).
+/// Items that cannot make it into the heap are skipped with SIMD compares.
+/// @param      len     Number of items in buffer.
+/// @param[in]  buffer  Pointer to unsigned integers.
+/// @param      k       Number of items to copy.
+/// @param[out] out_top Pointer to write items to, in sorted order. Must be able to hold @c k items.
+/// @param      reverse If true, copies k greatest, otherwise k least.
+/// @return Number of items written to @c out_top, min(@c k, @c len).
+attr_core_api
+usize top_k_u32(
+    usize len, const u32* buffer, usize k, u32* out_top, b32 reverse );
+/// @brief Partially sort floats so that nth item is in its sorted position.
+/// @details
+/// Introselect, average O(n). Items before nth are not greater
+/// than it and items after nth are not less than it, in no particular order.
+/// @param     len     Number of items in buffer.
+/// @param[in] buffer  Pointer to floats.
+/// @param     nth     Index of item to select. Nothing happens if >= @c len.
+/// @param     reverse If true, order is greatest -> least, otherwise least -> greatest.
+attr_core_api
+void select_nth_f32( usize len, f32* buffer, usize nth, b32 reverse );
+/// @brief Sort only first count items of floats.
+/// @details
+/// After sorting, first @c count items are the items that would be
+/// there if whole buffer was sorted. Rest of buffer is in no particular order.
+/// O(n + count log count).
+/// @param     len     Number of items in buffer.
+/// @param[in] buffer  Pointer to floats.
+/// @param     count   Number of items to sort. Clamped to @c len.
+/// @param     reverse If true, order is greatest -> least, otherwise least -> greatest.
+attr_core_api
+void partial_sort_f32( usize len, f32* buffer, usize count, b32 reverse );
+/// @brief Copy k first floats in sorted order without modifying buffer.
+/// @details
+/// Keeps a bounded heap of k items, O(n log k).
+/// Items that cannot make it into the heap are skipped with SIMD compares.
+/// @param      len     Number of items in buffer.
+/// @param[in]  buffer  Pointer to floats.
+/// @param      k       Number of items to copy.
+/// @param[out] out_top Pointer to write items to, in sorted order. Must be able to hold @c k items.
+/// @param      reverse If true, copies k greatest, otherwise k least.
+/// @return Number of items written to @c out_top, min(@c k, @c len).
+attr_core_api
+usize top_k_f32(
+    usize len, const f32* buffer, usize k, f32* out_top, b32 reverse );
+/// @brief Partially sort items so that nth item is in its sorted position.
+/// @details
+/// Introselect, average O(n). Items before nth are not sorted after
+/// it and items after nth are not sorted before it, in no particular order.
+/// @c cmp should return true if lhs should be sorted before rhs.
+/// @param     len            Number of items in buffer.
+/// @param     stride         Size of each value in buffer.
+/// @param[in] buffer         Pointer to values.
+/// @param     nth            Index of item to select. Nothing happens if >= @c len.
+/// @param     cmp            Function to use for comparisons.
+/// @param[in] opt_cmp_params (optional) Parameters for comparison function.
+/// @param[in] swap_buffer    Buffer for swapping values, must be able to hold >= stride.
+attr_core_api
+void select_nth_generic(
+    usize len, usize stride, void* buffer, usize nth,
+    SortCmpFN* cmp, void* opt_cmp_params, void* swap_buffer );
+/// @brief Sort only first count items.
+/// @details
+/// After sorting, first @c count items are the items that would be
+/// there if whole buffer was sorted. Rest of buffer is in no particular order.
+/// O(n + count log count). Not stable.
+/// @c cmp should return true if lhs should be sorted before rhs.
+/// @param     len            Number of items in buffer.
+/// @param     stride         Size of each value in buffer.
+/// @param[in] buffer         Pointer to values.
+/// @param     count          Number of items to sort. Clamped to @c len.
+/// @param     cmp            Function to use for comparisons.
+/// @param[in] opt_cmp_params (optional) Parameters for comparison function.
+/// @param[in] swap_buffer    Buffer for swapping values, must be able to hold >= stride.
+attr_core_api
+void partial_sort_generic(
+    usize len, usize stride, void* buffer, usize count,
+    SortCmpFN* cmp, void* opt_cmp_params, void* swap_buffer );
+/// @brief Copy k first items in sorted order without modifying buffer.
+/// @details
+/// Keeps a bounded heap of k items, O(n log k).
+/// @c cmp should return true if lhs should be sorted before rhs.
+/// @param      len            Number of items in buffer.
+/// @param      stride         Size of each value in buffer.
+/// @param[in]  buffer         Pointer to values.
+/// @param      k              Number of items to copy.
+/// @param[out] out_top        Pointer to write items to, in sorted order. Must be able to hold @c k items.
+/// @param      cmp            Function to use for comparisons.
+/// @param[in]  opt_cmp_params (optional) Parameters for comparison function.
+/// @param[in]  swap_buffer    Buffer for swapping values, must be able to hold >= stride.
+/// @return Number of items written to @c out_top, min(@c k, @c len).
+attr_core_api
+usize top_k_generic(
+    usize len, usize stride, const void* buffer, usize k, void* out_top,
+    SortCmpFN* cmp, void* opt_cmp_params, void* swap_buffer );
+
+/// @brief Radix sort for u32.
+/// @details
+/// LSD radix sort with 11-bit digits. Stable.
+/// Passes where every key has the same digit are skipped.
+/// @note Prefer this function over #quicksort_u32() for large arrays.
+/// @param[in] allocator Pointer to allocator interface for scratch memory.
+/// @param     len       Number of items in buffer.
+/// @param[in] buffer    Pointer to unsigned integers to sort.
+/// @param     reverse   If true, numbers are sorted from greatest -> least, otherwise least -> greatest.
+/// @return
+///     - @c true  : Sorted buffer.
+///     - @c false : Failed to allocate scratch memory, buffer is unchanged.
+attr_core_api
+b32 radix_sort_u32(
+    struct AllocatorInterface* allocator, usize len, u32* buffer, b32 reverse );
+/// @brief Radix sort for i32.
+/// @details
+/// LSD radix sort with 11-bit digits. Stable.
+/// Passes where every key has the same digit are skipped.
+/// @note Prefer this function over #quicksort_i32() for large arrays.
+/// @param[in] allocator Pointer to allocator interface for scratch memory.
+/// @param     len       Number of items in buffer.
+/// @param[in] buffer    Pointer to integers to sort.
+/// @param     reverse   If true, numbers are sorted from greatest -> least, otherwise least -> greatest.
+/// @return
+///     - @c true  : Sorted buffer.
+///     - @c false : Failed to allocate scratch memory, buffer is unchanged.
+attr_core_api
+b32 radix_sort_i32(
+    struct AllocatorInterface* allocator, usize len, i32* buffer, b32 reverse );
+/// @brief Radix sort for f32.
+/// @details
+/// LSD radix sort with 11-bit digits. Stable.
+/// Passes where every key has the same digit are skipped.
+/// Negative zero is sorted before zero and NaNs are sorted by sign to either end.
+/// @note Prefer this function over #quicksort_f32() for large arrays.
+/// @param[in] allocator Pointer to allocator interface for scratch memory.
+/// @param     len       Number of items in buffer.
+/// @param[in] buffer    Pointer to floats to sort.
+/// @param     reverse   If true, numbers are sorted from greatest -> least, otherwise least -> greatest.
+/// @return
+///     - @c true  : Sorted buffer.
+///     - @c false : Failed to allocate scratch memory, buffer is unchanged.
+attr_core_api
+b32 radix_sort_f32(
+    struct AllocatorInterface* allocator, usize len, f32* buffer, b32 reverse );
+/// @brief Radix sort for u64.
+/// @details
+/// LSD radix sort with 11-bit digits. Stable.
+/// Passes where every key has the same digit are skipped.
+/// @param[in] allocator Pointer to allocator interface for scratch memory.
+/// @param     len       Number of items in buffer.
+/// @param[in] buffer    Pointer to unsigned integers to sort.
+/// @param     reverse   If true, numbers are sorted from greatest -> least, otherwise least -> greatest.
+/// @return
+///     - @c true  : Sorted buffer.
+///     - @c false : Failed to allocate scratch memory, buffer is unchanged.
+attr_core_api
+b32 radix_sort_u64(
+    struct AllocatorInterface* allocator, usize len, u64* buffer, b32 reverse );
+/// @brief Radix sort for u32 keys with u32 values.
+/// @details
+/// Sorts keys and moves each value with its key,
+/// for example to get the sorted order of an array of indices.
+/// LSD radix sort with 11-bit digits. Stable.
+/// @param[in] allocator Pointer to allocator interface for scratch memory.
+/// @param     len       Number of keys and values.
+/// @param[in] keys      Pointer to keys to sort.
+/// @param[in] values    Pointer to values to reorder with keys.
+/// @param     reverse   If true, keys are sorted from greatest -> least, otherwise least -> greatest.
+/// @return
+///     - @c true  : Sorted keys and values.
+///     - @c false : Failed to allocate scratch memory, keys and values are unchanged.
+attr_core_api
+b32 radix_sort_kv_u32(
+    struct AllocatorInterface* allocator, usize len,
+    u32* keys, u32* values, b32 reverse );
+/// @brief Radix sort for i32 keys with u32 values.
+/// @details
+/// Sorts keys and moves each value with its key,
+/// for example to get the sorted order of an array of indices.
+/// LSD radix sort with 11-bit digits. Stable.
+/// @param[in] allocator Pointer to allocator interface for scratch memory.
+/// @param     len       Number of keys and values.
+/// @param[in] keys      Pointer to keys to sort.
+/// @param[in] values    Pointer to values to reorder with keys.
+/// @param     reverse   If true, keys are sorted from greatest -> least, otherwise least -> greatest.
+/// @return
+///     - @c true  : Sorted keys and values.
+///     - @c false : Failed to allocate scratch memory, keys and values are unchanged.
+attr_core_api
+b32 radix_sort_kv_i32(
+    struct AllocatorInterface* allocator, usize len,
+    i32* keys, u32* values, b32 reverse );
+/// @brief Radix sort for f32 keys with u32 values.
+/// @details
+/// Sorts keys and moves each value with its key,
+/// for example to get the sorted order of an array of indices.
+/// LSD radix sort with 11-bit digits. Stable.
+/// Negative zero is sorted before zero and NaNs are sorted by sign to either end.
+/// @param[in] allocator Pointer to allocator interface for scratch memory.
+/// @param     len       Number of keys and values.
+/// @param[in] keys      Pointer to keys to sort.
+/// @param[in] values    Pointer to values to reorder with keys.
+/// @param     reverse   If true, keys are sorted from greatest -> least, otherwise least -> greatest.
+/// @return
+///     - @c true  : Sorted keys and values.
+///     - @c false : Failed to allocate scratch memory, keys and values are unchanged.
+attr_core_api
+b32 radix_sort_kv_f32(
+    struct AllocatorInterface* allocator, usize len,
+    f32* keys, u32* values, b32 reverse );
+/// @brief Radix sort for u64 keys with u32 values.
+/// @details
+/// Sorts keys and moves each value with its key,
+/// for example to get the sorted order of an array of indices.
+/// LSD radix sort with 11-bit digits. Stable.
+/// @param[in] allocator Pointer to allocator interface for scratch memory.
+/// @param     len       Number of keys and values.
+/// @param[in] keys      Pointer to keys to sort.
+/// @param[in] values    Pointer to values to reorder with keys.
+/// @param     reverse   If true, keys are sorted from greatest -> least, otherwise least -> greatest.
+/// @return
+///     - @c true  : Sorted keys and values.
+///     - @c false : Failed to allocate scratch memory, keys and values are unchanged.
+attr_core_api
+b32 radix_sort_kv_u64(
+    struct AllocatorInterface* allocator, usize len,
+    u64* keys, u32* values, b32 reverse );
+
+#if !defined(CORE_PARALLEL_SORT_MAX_THREADS)
+    /// @brief Maximum number of threads used by parallel sort functions.
+    #define CORE_PARALLEL_SORT_MAX_THREADS (64)
+#endif
+
+/// @brief Parallel sort for i32.
+/// @details
+/// Buffer is split into one chunk per thread, chunks are sorted
+/// on worker threads with #quicksort_i32() and then merged with
+/// a multiway merge where each thread writes its own part of the result.
+/// Small buffers are sorted on the calling thread.
+/// @param[in] allocator        Pointer to allocator interface for scratch memory.
+/// @param     len              Number of items in buffer.
+/// @param[in] buffer           Pointer to integers to sort.
+/// @param     reverse          If true, numbers are sorted from greatest -> least, otherwise least -> greatest.
+/// @param     opt_thread_count (optional) Number of threads to use, including calling thread. Zero to use CPU count from #SystemInfo.
+/// @return
+///     - @c true  : Sorted buffer.
+///     - @c false : Failed to allocate scratch memory, buffer is unchanged.
+attr_core_api
+b32 parallel_sort_i32(
+    struct AllocatorInterface* allocator, usize len,
+    i32* buffer, b32 reverse, u32 opt_thread_count );
+/// @brief Parallel sort for u32.
+/// @details
+/// Same as #parallel_sort_i32() but for unsigned integers.
+/// @param[in] allocator        Pointer to allocator interface for scratch memory.
+/// @param     len              Number of items in buffer.
+/// @param[in] buffer           Pointer to integers to sort.
+/// @param     reverse          If true, numbers are sorted from greatest -> least, otherwise least -> greatest.
+/// @param     opt_thread_count (optional) Number of threads to use, including calling thread. Zero to use CPU count from #SystemInfo.
+/// @return
+///     - @c true  : Sorted buffer.
+///     - @c false : Failed to allocate scratch memory, buffer is unchanged.
+attr_core_api
+b32 parallel_sort_u32(
+    struct AllocatorInterface* allocator, usize len,
+    u32* buffer, b32 reverse, u32 opt_thread_count );
+/// @brief Parallel sort for f32.
+/// @details
+/// Same as #parallel_sort_i32() but for floats.
+/// @param[in] allocator        Pointer to allocator interface for scratch memory.
+/// @param     len              Number of items in buffer.
+/// @param[in] buffer           Pointer to floats to sort.
+/// @param     reverse          If true, numbers are sorted from greatest -> least, otherwise least -> greatest.
+/// @param     opt_thread_count (optional) Number of threads to use, including calling thread. Zero to use CPU count from #SystemInfo.
+/// @return
+///     - @c true  : Sorted buffer.
+///     - @c false : Failed to allocate scratch memory, buffer is unchanged.
+attr_core_api
+b32 parallel_sort_f32(
+    struct AllocatorInterface* allocator, usize len,
+    f32* buffer, b32 reverse, u32 opt_thread_count );
+/// @brief Generic parallel sort.
+/// @details
+/// Same as #parallel_sort_i32() but chunks are sorted with #quicksort_generic().
+/// @c cmp may be strict (<) or non-strict (<=).
+/// @warning @c cmp is called from multiple threads at the same time.
+/// @param[in] allocator        Pointer to allocator interface for scratch memory.
+/// @param     len              Number of items in buffer.
+/// @param     stride           Size of each value in buffer.
+/// @param[in] buffer           Pointer to values to sort.
+/// @param     cmp              Function to use for comparisons.
+/// @param[in] opt_cmp_params   (optional) Parameters for comparison function.
+/// @param     opt_thread_count (optional) Number of threads to use, including calling thread. Zero to use CPU count from #SystemInfo.
+/// @return
+///     - @c true  : Sorted buffer.
+///     - @c false : Failed to allocate scratch memory, buffer is unchanged.
+attr_core_api
+b32 parallel_sort_generic(
+    struct AllocatorInterface* allocator, usize len,
+    usize stride, void* buffer,
+    SortCmpFN* cmp, void* opt_cmp_params, u32 opt_thread_count );
+
+#if !defined(CORE_CPP_SORT_HPP)
+    #include "core/cpp/sort.hpp"
+#endif
+
 #endif /* header guard */
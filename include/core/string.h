@@ -84,6 +84,72 @@ typedef struct StringBufStreamTarget {
     struct _StringBufPOD* buf;
 } StringBufStreamTarget;
 
+/// @brief Maximum number of bytes in #ByteSet that are searched with SIMD.
+/// @details
+/// Larger sets are searched one byte at a time with bitmap lookups.
+#define BYTE_SET_SIMD_MAX (8)
+
+/// @brief Precompiled set of bytes for searching strings.
+/// @details
+/// Build once with #byte_set_from_string() and reuse for every search.
+typedef struct ByteSet {
+    /// @brief Bitmap of bytes in set.
+    u32 bits[8];
+    /// @brief Number of distinct bytes in set.
+    u32 count;
+    /// @brief Distinct bytes in set. Only valid if @c count <= #BYTE_SET_SIMD_MAX.
+    u8  members[BYTE_SET_SIMD_MAX];
+} ByteSet;
+
+/// @brief Needles up to this length are searched with SIMD instead of Two-Way.
+#define STRING_SEARCHER_SHORT_LEN (16)
+
+/// @brief Critical factorization of needle for Two-Way search.
+typedef struct StringSearcherFactor {
+    /// @brief Start of right half of needle.
+    usize critical;
+    /// @brief Shift after a full match of right half.
+    usize period;
+    /// @brief Number of bytes known to match after shifting by period.
+    usize memory;
+} StringSearcherFactor;
+
+/// @brief Precompiled needle for searching strings.
+/// @details
+/// Build once with #string_searcher_init() and reuse for every search.
+/// Needles longer than #STRING_SEARCHER_SHORT_LEN use Two-Way search,
+/// which is linear time even when haystack and needle are repetitive.
+typedef struct StringSearcher {
+    /// @brief Needle. Searcher does not copy needle, it must outlive searcher.
+    struct _StringPOD    needle;
+    /// @brief Bytes in needle.
+    ByteSet              set;
+    /// @brief Factorization for searching forwards.
+    StringSearcherFactor factor;
+    /// @brief Factorization for searching backwards.
+    StringSearcherFactor factor_rev;
+    /// @brief If true, case of ASCII letters is ignored.
+    b32                  nocase;
+} StringSearcher;
+
+/// @brief Number of code points between offsets stored in #StringUTF8Index.
+#define STRING_UTF8_INDEX_STRIDE (64)
+
+/// @brief Sparse index of code point offsets in UTF-8 string.
+/// @details
+/// Build once with #string_utf8_index_create().
+/// Stores byte offset of every #STRING_UTF8_INDEX_STRIDE th code point
+/// so indexing only scans from closest offset.
+/// Index is only valid for string it was built from.
+typedef struct StringUTF8Index {
+    /// @brief Number of code points in string.
+    usize  len;
+    /// @brief Number of offsets.
+    usize  count;
+    /// @brief Byte offset of every #STRING_UTF8_INDEX_STRIDE th code point.
+    usize* offsets;
+} StringUTF8Index;
+
 /// @brief Calculate ascii length of null terminated C string.
 /// @param[in] c_string Pointer to string.
 /// @return Ascii length of string excluding null terminator.
@@ -181,17 +247,73 @@ char string_index( struct _StringPOD str, usize index ) {
     return str.cbuf[index];
 }
 /// @brief Index into string, using UTF-8 index. Debug asserts that index is in bounds.
+/// @details
+/// Scans string from start, when indexing the same string
+/// repeatedly use #StringUTF8Index instead.
 /// @param str   String to index into.
 /// @param index UTF-8 index.
 /// @return Codepoint at given index.
 attr_core_api
 c32 string_index_utf8( struct _StringPOD str, usize index );
+/// @brief Build code point index of UTF-8 string.
+/// @note This function does not check if string is valid UTF-8!
+/// @param[in]  allocator Pointer to allocator interface.
+/// @param      str       String to index.
+/// @param[out] out_index Pointer to write index to.
+/// @return
+///     - @c true  : Built index.
+///     - @c false : Failed to allocate offsets.
+attr_core_api
+b32 string_utf8_index_create(
+    struct AllocatorInterface* allocator, struct _StringPOD str,
+    StringUTF8Index* out_index );
+/// @brief Free code point index.
+/// @param[in] allocator Pointer to allocator interface used to create index.
+/// @param[in] index     Pointer to index to free.
+attr_core_api
+void string_utf8_index_free(
+    struct AllocatorInterface* allocator, StringUTF8Index* index );
+/// @brief Get byte offset of code point using code point index.
+/// @param[in] index Pointer to index built from @c str.
+/// @param     str   String that index was built from.
+/// @param     at    UTF-8 index.
+/// @return Byte offset of code point, length of string if @c at is out of bounds.
+attr_core_api
+usize string_utf8_index_offset(
+    const StringUTF8Index* index, struct _StringPOD str, usize at );
+/// @brief Index into string using code point index. Debug asserts that index is in bounds.
+/// @param[in] index Pointer to index built from @c str.
+/// @param     str   String that index was built from.
+/// @param     at    UTF-8 index.
+/// @return Codepoint at given index.
+attr_core_api
+c32 string_utf8_index_query(
+    const StringUTF8Index* index, struct _StringPOD str, usize at );
 /// @brief Get next rune in string and advance.
 /// @param      src           String to get next codepoint from.
 /// @param[out] out_codepoint Pointer to write codepoint to.
 /// @return String advanced by number of bytes in rune.
 attr_core_api
 struct _StringPOD string_utf8_next( struct _StringPOD src, c32* out_codepoint );
+/// @brief Get next grapheme cluster in string and advance.
+/// @details
+/// Clusters are extended grapheme clusters as defined by UAX #29,
+/// see unicode_utf8_grapheme_len().
+/// Calling this function until string is empty iterates
+/// over every cluster without allocating.
+/// @param      src         String to get next grapheme cluster from.
+/// @param[out] out_cluster Pointer to write cluster to, slice of @c src.
+/// @return String advanced by number of bytes in cluster.
+attr_core_api
+struct _StringPOD string_grapheme_next(
+    struct _StringPOD src, struct _StringPOD* out_cluster );
+/// @brief Count grapheme clusters in UTF-8 string.
+/// @details
+/// Runs of ASCII are counted 16 bytes at a time.
+/// @param str String to count grapheme clusters of.
+/// @return Number of grapheme clusters.
+attr_core_api
+usize string_len_grapheme( struct _StringPOD str );
 /// @brief Get pointer to first character in string.
 /// @param str String to get pointer from.
 /// @return
@@ -237,6 +359,28 @@ char string_last_unchecked( struct _StringPOD str ) {
 ///     - @c false : @c a and @c b are not equal.
 attr_core_api
 b32 string_cmp( struct _StringPOD a, struct _StringPOD b );
+/// @brief Compare strings for equality, ignoring case of ASCII letters.
+/// @details
+/// Letters are folded and compared 16 bytes at a time,
+/// neither string is copied.
+/// @param a, b Strings to compare.
+/// @return
+///     - @c true  : @c a and @c b are equal in length and contents, ignoring case.
+///     - @c false : @c a and @c b are not equal.
+attr_core_api
+b32 string_cmp_ascii_nocase( struct _StringPOD a, struct _StringPOD b );
+/// @brief Compare UTF-8 strings for equality, ignoring case.
+/// @details
+/// Runes are compared after simple case folding with #unicode_fold(),
+/// so strings can be equal even if their lengths differ.
+/// Runs of ASCII are compared 16 bytes at a time.
+/// Invalid sequences only match identical bytes.
+/// @param a, b Strings to compare.
+/// @return
+///     - @c true  : @c a and @c b are equal, ignoring case.
+///     - @c false : @c a and @c b are not equal.
+attr_core_api
+b32 string_cmp_utf8_nocase( struct _StringPOD a, struct _StringPOD b );
 /// @brief Search for ascii character in string.
 /// @param      str           String to search in.
 /// @param      c             Character to search for.
@@ -262,6 +406,9 @@ usize string_find_count( struct _StringPOD str, char c );
 attr_core_api
 b32 string_find_rev( struct _StringPOD str, char c, usize* opt_out_index );
 /// @brief Search for any character in set in string.
+/// @note
+/// Builds a #ByteSet on every call,
+/// prefer #string_find_byte_set() when searching with same set repeatedly.
 /// @param      str           String to search in.
 /// @param      set           Set of characters to search for.
 /// @param[out] opt_out_index (optional) Pointer to write index of first character in set if any are found.
@@ -285,6 +432,56 @@ b32 string_find_set_rev( struct _StringPOD str, struct _StringPOD set, usize* op
 /// @return Number of times any character in @c set appears in @c str.
 attr_core_api
 usize string_find_set_count( struct _StringPOD str, struct _StringPOD set );
+/// @brief Create byte set from bytes in string.
+/// @param      set     Bytes to put in set. Duplicates are ignored.
+/// @param[out] out_set Pointer to write set to.
+attr_core_api
+void byte_set_from_string( struct _StringPOD set, ByteSet* out_set );
+/// @brief Insert byte into byte set.
+/// @param[in] set  Pointer to set.
+/// @param     byte Byte to insert.
+attr_core_api
+void byte_set_insert( ByteSet* set, u8 byte );
+/// @brief Check if byte set contains byte.
+/// @param[in] set  Pointer to set.
+/// @param     byte Byte to check.
+/// @return
+///     - @c true  : Byte is in set.
+///     - @c false : Byte is not in set.
+attr_always_inline attr_header
+b32 byte_set_contains( const ByteSet* set, u8 byte ) {
+    return (set->bits[byte >> 5] >> (byte & 31)) & 1;
+}
+/// @brief Search for any byte in byte set in string.
+/// @details
+/// Sets with up to #BYTE_SET_SIMD_MAX bytes are searched 16 bytes at a time.
+/// @param      str           String to search in.
+/// @param[in]  set           Pointer to set of bytes to search for.
+/// @param[out] opt_out_index (optional) Pointer to write index of first byte in set if any are found.
+/// @return
+///     - @c true  : Any byte from set was found. Index written to @c opt_out_index (if not null)
+///     - @c false : No bytes from set were found.
+attr_core_api
+b32 string_find_byte_set(
+    struct _StringPOD str, const ByteSet* set, usize* opt_out_index );
+/// @brief Search for any byte in byte set in string, searches from end of string.
+/// @details
+/// Sets with up to #BYTE_SET_SIMD_MAX bytes are searched 16 bytes at a time.
+/// @param      str           String to search in.
+/// @param[in]  set           Pointer to set of bytes to search for.
+/// @param[out] opt_out_index (optional) Pointer to write index of last byte in set if any are found.
+/// @return
+///     - @c true  : Any byte from set was found. Index written to @c opt_out_index (if not null)
+///     - @c false : No bytes from set were found.
+attr_core_api
+b32 string_find_byte_set_rev(
+    struct _StringPOD str, const ByteSet* set, usize* opt_out_index );
+/// @brief Tally number of times that any byte in byte set occurs in string.
+/// @param     str String.
+/// @param[in] set Pointer to set to tally.
+/// @return Number of times any byte in @c set appears in @c str.
+attr_core_api
+usize string_find_byte_set_count( struct _StringPOD str, const ByteSet* set );
 /// @brief Search for phrase in string.
 /// @param str String to search in.
 /// @param phrase Phrase to search for.
@@ -310,6 +507,56 @@ b32 string_find_phrase_rev(
 /// @return Number of times @c phrase appears in @c str.
 attr_core_api
 usize string_find_phrase_count( struct _StringPOD str, struct _StringPOD phrase );
+/// @brief Search for phrase in string, ignoring case of ASCII letters.
+/// @details
+/// Haystack is folded as it is searched so neither string is copied.
+/// @param str String to search in.
+/// @param phrase Phrase to search for.
+/// @param[out] opt_out_index (optional) Pointer to write index of first character of phrase. (if not null)
+/// @return 
+///     - @c true  : @c phrase was found in @c str.
+///     - @c false : @c phrase was not found.
+attr_core_api
+b32 string_find_phrase_nocase(
+    struct _StringPOD str, struct _StringPOD phrase, usize* opt_out_index );
+/// @brief Precompile needle for searching.
+/// @param      needle       Needle to search for. Must outlive searcher.
+/// @param[out] out_searcher Pointer to write searcher to.
+attr_core_api
+void string_searcher_init( struct _StringPOD needle, StringSearcher* out_searcher );
+/// @brief Precompile needle for searching, ignoring case of ASCII letters.
+/// @param      needle       Needle to search for. Must outlive searcher.
+/// @param[out] out_searcher Pointer to write searcher to.
+attr_core_api
+void string_searcher_init_nocase( struct _StringPOD needle, StringSearcher* out_searcher );
+/// @brief Search for needle in string.
+/// @param[in]  searcher      Pointer to searcher.
+/// @param      str           String to search in.
+/// @param[out] opt_out_index (optional) Pointer to write index of start of needle if found.
+/// @return
+///     - @c true  : Needle was found. Index written to @c opt_out_index (if not null)
+///     - @c false : Needle was not found or needle is empty.
+attr_core_api
+b32 string_searcher_find(
+    const StringSearcher* searcher, struct _StringPOD str, usize* opt_out_index );
+/// @brief Search for needle in string, searches from end of string.
+/// @param[in]  searcher      Pointer to searcher.
+/// @param      str           String to search in.
+/// @param[out] opt_out_index (optional) Pointer to write index of start of last needle if found.
+/// @return
+///     - @c true  : Needle was found. Index written to @c opt_out_index (if not null)
+///     - @c false : Needle was not found or needle is empty.
+attr_core_api
+b32 string_searcher_find_rev(
+    const StringSearcher* searcher, struct _StringPOD str, usize* opt_out_index );
+/// @brief Tally number of times that needle occurs in string.
+/// @details
+/// Occurrences do not overlap.
+/// @param[in] searcher Pointer to searcher.
+/// @param     str      String.
+/// @return Number of times needle appears in @c str.
+attr_core_api
+usize string_searcher_count( const StringSearcher* searcher, struct _StringPOD str );
 /// @brief Truncate length of string.
 /// @details
 /// Returns str if max is greater than length.
@@ -479,7 +726,11 @@ b32 string_split_whitespace(
     return false;
 }
 /// @brief Parse signed integer from source string.
-/// @details Parsing is successful if valid integer is found from start of string.
+/// @details
+/// Parsing is successful if valid integer is found from start of string.
+/// Accepts optional sign, optional radix prefix (0x, 0b or 0o,
+/// in any case) and digits. Values that do not fit in 64-bit
+/// signed integer fail to parse rather than wrapping.
 /// @param      str     String to parse integer from.
 /// @param[out] out_int Pointer to integer to receive result.
 /// @return
@@ -488,7 +739,10 @@ b32 string_split_whitespace(
 attr_core_api
 b32 string_parse_int( struct _StringPOD str, i64* out_int );
 /// @brief Parse unsigned integer from source string.
-/// @details Parsing is successful if valid integer is found from start of string.
+/// @details
+/// Parsing is successful if valid integer is found from start of string.
+/// Same syntax as #string_parse_int() except that only plus sign is accepted.
+/// Values that do not fit in 64-bit unsigned integer fail to parse.
 /// @param      str      String to parse integer from.
 /// @param[out] out_uint Pointer to integer to receive result.
 /// @return
@@ -496,8 +750,54 @@ b32 string_parse_int( struct _StringPOD str, i64* out_int );
 ///     - @c false : Failed to parse integer.
 attr_core_api
 b32 string_parse_uint( struct _StringPOD str, u64* out_uint );
+/// @brief Parse signed integer from start of string.
+/// @details
+/// Same as #string_parse_int() but returns where integer ends
+/// so that text after it can be parsed next.
+/// @param      str     String to parse integer from.
+/// @param[out] out_int Pointer to integer to receive result.
+/// @return Number of bytes parsed, zero if integer could not be parsed.
+attr_core_api
+usize string_parse_int_prefix( struct _StringPOD str, i64* out_int );
+/// @brief Parse unsigned integer from start of string.
+/// @details
+/// Same as #string_parse_uint() but returns where integer ends
+/// so that text after it can be parsed next.
+/// @param      str      String to parse integer from.
+/// @param[out] out_uint Pointer to integer to receive result.
+/// @return Number of bytes parsed, zero if integer could not be parsed.
+attr_core_api
+usize string_parse_uint_prefix( struct _StringPOD str, u64* out_uint );
+/// @brief Parse array of signed integers from source string.
+/// @details
+/// Numbers are separated by any run of whitespace and commas.
+/// Parsing stops at end of string, once @c cap integers are parsed
+/// or at first text that is not an integer.
+/// @param      str         String to parse integers from.
+/// @param      cap         Number of integers that @c out_ints can hold.
+/// @param[out] out_ints    Pointer to array to write integers to.
+/// @param[out] opt_out_len (optional) Pointer to write number of bytes up to end of last integer to.
+/// @return Number of integers parsed.
+attr_core_api
+usize string_parse_int_array(
+    struct _StringPOD str, usize cap, i64* out_ints, usize* opt_out_len );
+/// @brief Parse array of unsigned integers from source string.
+/// @details
+/// Same as #string_parse_int_array() but with unsigned integers.
+/// @param      str         String to parse integers from.
+/// @param      cap         Number of integers that @c out_uints can hold.
+/// @param[out] out_uints   Pointer to array to write integers to.
+/// @param[out] opt_out_len (optional) Pointer to write number of bytes up to end of last integer to.
+/// @return Number of integers parsed.
+attr_core_api
+usize string_parse_uint_array(
+    struct _StringPOD str, usize cap, u64* out_uints, usize* opt_out_len );
 /// @brief Parse float from source string.
-/// @details Parsing is successful if valid float is found from start of string.
+/// @details
+/// Parsing is successful if valid float is found from start of string.
+/// Accepts optional sign, digits with optional fraction and
+/// optional exponent (1.5e-3) as well as inf, infinity and nan
+/// in any case. Result is correctly rounded to nearest, ties to even.
 /// @param      str       String to parse float from.
 /// @param[out] out_float Pointer to float to receive result.
 /// @return
@@ -505,6 +805,45 @@ b32 string_parse_uint( struct _StringPOD str, u64* out_uint );
 ///     - @c false : Failed to parse float.
 attr_core_api
 b32 string_parse_float( struct _StringPOD str, f64* out_float );
+/// @brief Parse 32-bit float from source string.
+/// @details
+/// Same syntax as #string_parse_float(), result is
+/// correctly rounded to 32-bit float directly rather than
+/// rounded twice through 64-bit float.
+/// @param      str       String to parse float from.
+/// @param[out] out_float Pointer to float to receive result.
+/// @return
+///     - @c true  : Float was successfully parsed from string.
+///     - @c false : Failed to parse float.
+attr_core_api
+b32 string_parse_float32( struct _StringPOD str, f32* out_float );
+/// @brief Parse array of floats from source string.
+/// @details
+/// Numbers are separated by any run of whitespace and commas.
+/// Parsing stops at end of string, once @c cap floats are parsed
+/// or at first text that is not a float.
+/// When parsing a chunk of larger text, last number may be cut off
+/// by end of chunk, so text after last separator should be kept
+/// for next chunk.
+/// @param      str         String to parse floats from.
+/// @param      cap         Number of floats that @c out_floats can hold.
+/// @param[out] out_floats  Pointer to array to write floats to.
+/// @param[out] opt_out_len (optional) Pointer to write number of bytes up to end of last float to.
+/// @return Number of floats parsed.
+attr_core_api
+usize string_parse_float_array(
+    struct _StringPOD str, usize cap, f64* out_floats, usize* opt_out_len );
+/// @brief Parse array of 32-bit floats from source string.
+/// @details
+/// Same as #string_parse_float_array() but with 32-bit floats.
+/// @param      str         String to parse floats from.
+/// @param      cap         Number of floats that @c out_floats can hold.
+/// @param[out] out_floats  Pointer to array to write floats to.
+/// @param[out] opt_out_len (optional) Pointer to write number of bytes up to end of last float to.
+/// @return Number of floats parsed.
+attr_core_api
+usize string_parse_float32_array(
+    struct _StringPOD str, usize cap, f32* out_floats, usize* opt_out_len );
 /// @brief Reverse contents of string.
 /// @note String must be from mutable source (aka not from literal or read-only memory).
 /// @param str String to reverse.
@@ -526,20 +865,26 @@ void string_mut_to_upper( struct _StringPOD str );
 /// @param str String to modify.
 attr_core_api
 void string_mut_to_lower( struct _StringPOD str );
-/// @brief Convert all alphabetic ascii characters to upper case.
+/// @brief Convert all runes in UTF-8 string to upper case.
+/// @details
+/// Uses simple (single rune) case mapping, see unicode_to_upper().
+/// Invalid UTF-8 sequences are streamed unchanged.
 /// @param[in] stream Stream function.
 /// @param[in] target Target to stream to.
 /// @param     str    Source string.
-/// @return Number of characters that could not fit in stream.
+/// @return Number of bytes that could not fit in stream.
 /// @see #StreamBytesFN
 attr_core_api
 usize string_stream_to_upper(
     StreamBytesFN* stream, void* target, struct _StringPOD str );
-/// @brief Convert all alphabetic ascii characters to lower case.
+/// @brief Convert all runes in UTF-8 string to lower case.
+/// @details
+/// Uses simple (single rune) case mapping, see unicode_to_lower().
+/// Invalid UTF-8 sequences are streamed unchanged.
 /// @param[in] stream Stream function.
 /// @param[in] target Target to stream to.
 /// @param     str    Source string.
-/// @return Number of characters that could not fit in stream.
+/// @return Number of bytes that could not fit in stream.
 /// @see #StreamBytesFN
 attr_core_api
 usize string_stream_to_lower(
@@ -281,6 +281,8 @@ attr_always_inline attr_header
 u32 unicode_cp32_code_unit_count( UTFCodePoint32 cp32 );
 
 /// @brief Validate next UTF-8 code point.
+/// @details
+/// Rejects overlong encodings, surrogates and code points past U+10FFFF.
 /// @param      len             Length of string in code units. (bytes)
 /// @param[in]  utf8            UTF-8 String. This function will read 4 code units at most.
 /// @param[out] opt_out_rune    (optional) Pointer to write decoded rune if no error was encountered.
@@ -291,7 +293,25 @@ attr_core_api
 UnicodeValidationResult unicode_utf8_validate(
     usize len, const c8* utf8, rune32* opt_out_rune,
     const c8** opt_out_error, u32* opt_out_advance );
+/// @brief Validate entire UTF-8 string.
+/// @details
+/// Rejects overlong encodings, surrogates and code points past U+10FFFF.
+/// ASCII is skipped in blocks, everything else goes through a table driven DFA.
+/// @param      len                  Length of string in code units. (bytes)
+/// @param[in]  utf8                 UTF-8 String.
+/// @param[out] opt_out_error_offset (optional) Pointer to write offset of first code point
+///                                  that is invalid or unfinished if string is not valid.
+///                                  This is also length of longest valid prefix.
+/// @return
+///     - #UNICODE_RESULT_OK         : Entire string is valid.
+///     - #UNICODE_RESULT_UNFINISHED : String ends part way through otherwise valid code point.
+///     - #UNICODE_RESULT_INVALID    : String contains invalid code point.
+attr_core_api
+UnicodeValidationResult unicode_utf8_validate_string(
+    usize len, const c8* utf8, usize* opt_out_error_offset );
 /// @brief Validate next UTF-16 code point.
+/// @details
+/// Rejects unpaired surrogates.
 /// @param      len             Length of string in code units. (shorts)
 /// @param[in]  utf16           UTF-16 String. This function will read 2 code units at most.
 /// @param[out] opt_out_rune    (optional) Pointer to write decoded rune if no error was encountered.
@@ -303,6 +323,8 @@ UnicodeValidationResult unicode_utf16_validate(
     usize len, const c16* utf16, rune32* opt_out_rune,
     const c16** opt_out_error, u32* opt_out_advance );
 /// @brief Validate next UTF-32 code point.
+/// @details
+/// Rejects surrogates and code points past U+10FFFF.
 /// @param      len             Length of string in code units. (shorts)
 /// @param[in]  utf32           UTF-32 String. This function will read 1 code unit at most.
 /// @param[out] opt_out_rune    (optional) Pointer to write decoded rune if no error was encountered.
@@ -388,7 +410,125 @@ UTFCodePoint32 unicode_cp32_from_cp8( UTFCodePoint8 cp8 );
 attr_always_inline attr_header
 UTFCodePoint32 unicode_cp32_from_cp16( UTFCodePoint16 cp16 );
 
+/// @brief Calculate length of UTF-8 string converted from UTF-16 string.
+/// @param     len   Number of UTF-16 code units in string. (shorts)
+/// @param[in] utf16 UTF-16 string.
+/// @return Number of UTF-8 code units (bytes) required to hold converted string.
+attr_core_api
+usize unicode_utf8_len_from_utf16( usize len, const c16* utf16 );
+/// @brief Calculate length of UTF-8 string converted from UTF-32 string.
+/// @param     len   Number of UTF-32 code units in string. (ints)
+/// @param[in] utf32 UTF-32 string.
+/// @return Number of UTF-8 code units (bytes) required to hold converted string.
+attr_core_api
+usize unicode_utf8_len_from_utf32( usize len, const c32* utf32 );
+/// @brief Calculate length of UTF-16 string converted from UTF-8 string.
+/// @param     len   Number of UTF-8 code units in string. (bytes)
+/// @param[in] utf8  UTF-8 string.
+/// @return Number of UTF-16 code units (shorts) required to hold converted string.
+attr_core_api
+usize unicode_utf16_len_from_utf8( usize len, const c8* utf8 );
+/// @brief Calculate length of UTF-16 string converted from UTF-32 string.
+/// @param     len   Number of UTF-32 code units in string. (ints)
+/// @param[in] utf32 UTF-32 string.
+/// @return Number of UTF-16 code units (shorts) required to hold converted string.
+attr_core_api
+usize unicode_utf16_len_from_utf32( usize len, const c32* utf32 );
+/// @brief Calculate length of UTF-32 string converted from UTF-8 string.
+/// @param     len   Number of UTF-8 code units in string. (bytes)
+/// @param[in] utf8  UTF-8 string.
+/// @return Number of UTF-32 code units (ints) required to hold converted string.
+attr_core_api
+usize unicode_utf32_len_from_utf8( usize len, const c8* utf8 );
+/// @brief Calculate length of UTF-32 string converted from UTF-16 string.
+/// @param     len   Number of UTF-16 code units in string. (shorts)
+/// @param[in] utf16 UTF-16 string.
+/// @return Number of UTF-32 code units (ints) required to hold converted string.
+attr_core_api
+usize unicode_utf32_len_from_utf16( usize len, const c16* utf16 );
+
+/// @brief Convert UTF-16 string to UTF-8 string in buffer.
+/// @details
+/// Invalid sequences are replaced with U+FFFD.
+/// Stops before first code point that does not fit in buffer.
+/// @param      len          Number of UTF-16 code units in string. (shorts)
+/// @param[in]  utf16        UTF-16 string.
+/// @param      cap          Capacity of buffer in UTF-8 code units. (bytes)
+/// @param[out] buffer       Pointer to buffer to write UTF-8 code units to.
+/// @param[out] opt_out_read (optional) Pointer to write number of UTF-16 code units converted.
+/// @return Number of UTF-8 code units written to buffer.
+attr_core_api
+usize unicode_utf8_from_utf16_buffer(
+    usize len, const c16* utf16, usize cap, c8* buffer, usize* opt_out_read );
+/// @brief Convert UTF-32 string to UTF-8 string in buffer.
+/// @details
+/// Invalid sequences are replaced with U+FFFD.
+/// Stops before first code point that does not fit in buffer.
+/// @param      len          Number of UTF-32 code units in string. (ints)
+/// @param[in]  utf32        UTF-32 string.
+/// @param      cap          Capacity of buffer in UTF-8 code units. (bytes)
+/// @param[out] buffer       Pointer to buffer to write UTF-8 code units to.
+/// @param[out] opt_out_read (optional) Pointer to write number of UTF-32 code units converted.
+/// @return Number of UTF-8 code units written to buffer.
+attr_core_api
+usize unicode_utf8_from_utf32_buffer(
+    usize len, const c32* utf32, usize cap, c8* buffer, usize* opt_out_read );
+/// @brief Convert UTF-8 string to UTF-16 string in buffer.
+/// @details
+/// Invalid sequences are replaced with U+FFFD.
+/// Stops before first code point that does not fit in buffer.
+/// @param      len          Number of UTF-8 code units in string. (bytes)
+/// @param[in]  utf8         UTF-8 string.
+/// @param      cap          Capacity of buffer in UTF-16 code units. (shorts)
+/// @param[out] buffer       Pointer to buffer to write UTF-16 code units to.
+/// @param[out] opt_out_read (optional) Pointer to write number of UTF-8 code units converted.
+/// @return Number of UTF-16 code units written to buffer.
+attr_core_api
+usize unicode_utf16_from_utf8_buffer(
+    usize len, const c8* utf8, usize cap, c16* buffer, usize* opt_out_read );
+/// @brief Convert UTF-32 string to UTF-16 string in buffer.
+/// @details
+/// Invalid sequences are replaced with U+FFFD.
+/// Stops before first code point that does not fit in buffer.
+/// @param      len          Number of UTF-32 code units in string. (ints)
+/// @param[in]  utf32        UTF-32 string.
+/// @param      cap          Capacity of buffer in UTF-16 code units. (shorts)
+/// @param[out] buffer       Pointer to buffer to write UTF-16 code units to.
+/// @param[out] opt_out_read (optional) Pointer to write number of UTF-32 code units converted.
+/// @return Number of UTF-16 code units written to buffer.
+attr_core_api
+usize unicode_utf16_from_utf32_buffer(
+    usize len, const c32* utf32, usize cap, c16* buffer, usize* opt_out_read );
+/// @brief Convert UTF-8 string to UTF-32 string in buffer.
+/// @details
+/// Invalid sequences are replaced with U+FFFD.
+/// Stops before first code point that does not fit in buffer.
+/// @param      len          Number of UTF-8 code units in string. (bytes)
+/// @param[in]  utf8         UTF-8 string.
+/// @param      cap          Capacity of buffer in UTF-32 code units. (ints)
+/// @param[out] buffer       Pointer to buffer to write UTF-32 code units to.
+/// @param[out] opt_out_read (optional) Pointer to write number of UTF-8 code units converted.
+/// @return Number of UTF-32 code units written to buffer.
+attr_core_api
+usize unicode_utf32_from_utf8_buffer(
+    usize len, const c8* utf8, usize cap, c32* buffer, usize* opt_out_read );
+/// @brief Convert UTF-16 string to UTF-32 string in buffer.
+/// @details
+/// Invalid sequences are replaced with U+FFFD.
+/// Stops before first code point that does not fit in buffer.
+/// @param      len          Number of UTF-16 code units in string. (shorts)
+/// @param[in]  utf16        UTF-16 string.
+/// @param      cap          Capacity of buffer in UTF-32 code units. (ints)
+/// @param[out] buffer       Pointer to buffer to write UTF-32 code units to.
+/// @param[out] opt_out_read (optional) Pointer to write number of UTF-16 code units converted.
+/// @return Number of UTF-32 code units written to buffer.
+attr_core_api
+usize unicode_utf32_from_utf16_buffer(
+    usize len, const c16* utf16, usize cap, c32* buffer, usize* opt_out_read );
+
 /// @brief Convert UTF-16 string to UTF-8 string.
+/// @details
+/// Converted string is streamed in blocks.
 /// @param[in] stream Streaming function.
 /// @param[in] target Target for streaming function.
 /// @param     len    Number of UTF-16 code units in string. (shorts)
@@ -498,6 +638,7 @@ b32 unicode_is_mathematical_symbol( rune32 rune );
 ///
 /// @note
 /// This function checks against all characters used for writing.
+/// Upper-case runes are runes in general category Lu (Letter, uppercase).
 ///
 /// @param rune Unicode rune to check.
 /// @return
@@ -513,6 +654,7 @@ b32 unicode_is_alphabetic_upper( rune32 rune );
 ///
 /// @note
 /// This function checks against all characters used for writing.
+/// Lower-case runes are runes in general category Ll (Letter, lowercase).
 ///
 /// @param rune Unicode rune to check.
 /// @return
@@ -529,6 +671,7 @@ b32 unicode_is_alphabetic_lower( rune32 rune );
 /// @note
 /// This function checks if character is used for writing.
 /// Excludes emojis or other symbolic characters.
+/// Characters used for writing are runes in general category L (Letter).
 ///
 /// @param rune Unicode rune to check.
 /// @return
@@ -579,7 +722,8 @@ b32 unicode_is_ascii( rune32 rune );
 /// If @c rune does not have an upper-case representation,
 /// function returns @c rune.
 /// This function is designed only for characters
-/// that can be represented with a single rune.
+/// that can be represented with a single rune,
+/// it uses simple case mapping from UnicodeData.txt.
 ///
 /// @param rune Unicode rune to convert.
 /// @return Upper-case version.
@@ -591,12 +735,26 @@ rune32 unicode_to_upper( rune32 rune );
 /// If @c rune does not have an lower-case representation,
 /// function returns @c rune.
 /// This function is designed only for characters
-/// that can be represented with a single rune.
+/// that can be represented with a single rune,
+/// it uses simple case mapping from UnicodeData.txt.
 ///
 /// @param rune Unicode rune to convert.
 /// @return Lower-case version.
 attr_core_api
 rune32 unicode_to_lower( rune32 rune );
+/// @brief Fold case of rune for case-insensitive comparison.
+///
+/// @note
+/// Uses simple case folding (status C and S) from CaseFolding.txt,
+/// so folded rune is always a single rune.
+/// Unlike #unicode_to_lower(), runes that only differ in case
+/// such as U+017F LATIN SMALL LETTER LONG S and 's'
+/// fold to the same rune.
+///
+/// @param rune Unicode rune to fold.
+/// @return Case folded rune.
+attr_core_api
+rune32 unicode_fold( rune32 rune );
 
 /// @brief Convert upper-case grapheme cluster to lower-case.
 ///
@@ -620,6 +778,19 @@ GraphemeCluster unicode_cluster_to_upper( GraphemeCluster cluster );
 /// @return Upper-case version.
 attr_core_api
 GraphemeCluster unicode_cluster_to_lower( GraphemeCluster cluster );
+/// @brief Get length of first grapheme cluster in UTF-8 string.
+///
+/// @note
+/// Clusters are extended grapheme clusters as defined by UAX #29,
+/// using grapheme break properties from tables generated with
+/// './cbuild unicode'. Indic conjunct rule GB9c is not applied.
+/// Invalid sequences are treated as U+FFFD.
+///
+/// @param     len  Length of string in code units. (bytes)
+/// @param[in] utf8 UTF-8 String.
+/// @return Length of first grapheme cluster in bytes. Zero if @c len is zero.
+attr_core_api
+usize unicode_utf8_grapheme_len( usize len, const c8* utf8 );
 
 
 attr_always_inline attr_header
@@ -748,9 +919,9 @@ UTFCodePoint32 unicode_cp32_from_cp8( UTFCodePoint8 cp8 ) {
     } else if( (cp8.code_units[0] & 0xF8) ) {
 
         result.rune = cp8.code_units[0] & 0x07;
-        result.rune = (result.rune << 6) | (cp8.code_units[1] & 0x37);
-        result.rune = (result.rune << 6) | (cp8.code_units[2] & 0x37);
-        result.rune = (result.rune << 6) | (cp8.code_units[3] & 0x37);
+        result.rune = (result.rune << 6) | (cp8.code_units[1] & 0x3F);
+        result.rune = (result.rune << 6) | (cp8.code_units[2] & 0x3F);
+        result.rune = (result.rune << 6) | (cp8.code_units[3] & 0x3F);
 
     } else {
 
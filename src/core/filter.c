@@ -0,0 +1,368 @@
+/**
+ * @file   filter.c
+ * @brief  Probabilistic membership filter implementations.
+ * @author Alicia Amarilla (smushyaa@gmail.com)
+ * @date   October 18, 2026
+*/
+#include "core/prelude.h"
+#include "core/filter.h"
+#include "core/alloc.h"
+#include "core/memory.h"
+#include "core/assertions.h"
+#include "core/math/exponential.h"
+
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+    #include "core/internal/sse.h" // IWYU pragma: keep
+#endif
+
+#define BLOOM_FILTER_BLOCK_BITS  (BLOOM_FILTER_BLOCK_SIZE * 8)
+#define BLOOM_FILTER_MAX_HASHES  (16)
+#define CUCKOO_FILTER_MAX_KICKS  (500)
+#define CUCKOO_FILTER_LOAD_RATIO (0.95f)
+#define LN2                      (0.69314718056f)
+
+attr_always_inline inline attr_internal
+usize internal_filter_next_pow2( usize x ) {
+    usize result = 1;
+    while( result < x ) {
+        result <<= 1;
+    }
+    return result;
+}
+attr_internal
+f32 internal_filter_log2( f32 x ) {
+    // NOTE(alicia): split into exponent and mantissa in [1,2)
+    // as f32_ln is only accurate close to 1.
+    u32 bits;
+    memory_copy( &bits, &x, sizeof(bits) );
+
+    i32 exponent = (i32)((bits >> 23) & 0xFF) - 127;
+    bits         = (bits & 0x007FFFFF) | 0x3F800000;
+
+    f32 mantissa;
+    memory_copy( &mantissa, &bits, sizeof(mantissa) );
+
+    return (f32)exponent + (f32_ln( mantissa ) / LN2);
+}
+
+attr_core_api
+usize bloom_filter_calculate_size(
+    usize expected_count, f32 false_positive_rate, u32* out_hash_count
+) {
+    debug_assert(
+        false_positive_rate > 0.0f && false_positive_rate < 1.0f,
+        "bloom_filter_calculate_size: false positive rate must be in range (0, 1)!" );
+    usize n = expected_count ? expected_count : 1;
+
+    f32 bits_per_key = -internal_filter_log2( false_positive_rate ) / LN2;
+    u32 hash_count   = (u32)( (bits_per_key * LN2) + 0.5f );
+    if( hash_count < 1 ) {
+        hash_count = 1;
+    } else if( hash_count > BLOOM_FILTER_MAX_HASHES ) {
+        hash_count = BLOOM_FILTER_MAX_HASHES;
+    }
+
+    usize bits        = (usize)( bits_per_key * (f32)n ) + 1;
+    usize block_count = (bits + (BLOOM_FILTER_BLOCK_BITS - 1)) / BLOOM_FILTER_BLOCK_BITS;
+
+    *out_hash_count = hash_count;
+    return block_count * BLOOM_FILTER_BLOCK_SIZE;
+}
+attr_core_api
+b32 bloom_filter_create(
+    struct AllocatorInterface* allocator, usize expected_count,
+    f32 false_positive_rate, BloomFilter* out_filter
+) {
+    u32   hash_count = 0;
+    usize size       = bloom_filter_calculate_size(
+        expected_count, false_positive_rate, &hash_count );
+
+    void* blocks = allocator_alloc( allocator, size );
+    if( !blocks ) {
+        return false;
+    }
+
+    out_filter->block_count = size / BLOOM_FILTER_BLOCK_SIZE;
+    out_filter->hash_count  = hash_count;
+    out_filter->blocks      = blocks;
+    return true;
+}
+attr_core_api
+void bloom_filter_free(
+    struct AllocatorInterface* allocator, BloomFilter* filter
+) {
+    if( filter->blocks ) {
+        allocator_free(
+            allocator, filter->blocks, filter->block_count * BLOOM_FILTER_BLOCK_SIZE );
+    }
+    memory_zero( filter, sizeof(*filter) );
+}
+attr_core_api
+void bloom_filter_clear( BloomFilter* filter ) {
+    memory_zero( filter->blocks, filter->block_count * BLOOM_FILTER_BLOCK_SIZE );
+}
+attr_always_inline inline attr_internal
+u8* internal_bloom_filter_block(
+    const BloomFilter* filter, hash64 hash,
+    u64 out_mask[BLOOM_FILTER_BLOCK_SIZE / sizeof(u64)]
+) {
+    // NOTE(alicia): upper bits select block, remixed bits select
+    // bits in block with double hashing.
+    usize block = (usize)(((hash >> 32) * (u64)filter->block_count) >> 32);
+
+    u64 mixed = hash * 0x9E3779B97F4A7C15ULL;
+    u32 h1    = (u32)mixed;
+    u32 h2    = (u32)(mixed >> 32) | 1;
+
+    memory_zero( out_mask, BLOOM_FILTER_BLOCK_SIZE );
+    for( u32 i = 0; i < filter->hash_count; ++i ) {
+        u32 bit = (h1 + (i * h2)) >> (32 - 9);
+        out_mask[bit / 64] |= (u64)1 << (bit % 64);
+    }
+
+    return filter->blocks + (block * BLOOM_FILTER_BLOCK_SIZE);
+}
+attr_core_api
+void bloom_filter_insert( BloomFilter* filter, hash64 hash ) {
+    u64 mask[BLOOM_FILTER_BLOCK_SIZE / sizeof(u64)];
+    u64* block = (u64*)internal_bloom_filter_block( filter, hash, mask );
+
+    for( usize i = 0; i < static_array_len( mask ); ++i ) {
+        block[i] |= mask[i];
+    }
+}
+attr_core_api
+b32 bloom_filter_contains( const BloomFilter* filter, hash64 hash ) {
+    u64 mask[BLOOM_FILTER_BLOCK_SIZE / sizeof(u64)];
+    const u8* block = internal_bloom_filter_block( filter, hash, mask );
+
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+    __m128i result = _mm_set1_epi8( -1 );
+    for( usize i = 0; i < BLOOM_FILTER_BLOCK_SIZE; i += sizeof(__m128i) ) {
+        __m128i b = _mm_loadu_si128( (const __m128i*)(block + i) );
+        __m128i m = _mm_loadu_si128( (const __m128i*)((const u8*)mask + i) );
+        result    = _mm_and_si128( result, _mm_cmpeq_epi8( _mm_and_si128( b, m ), m ) );
+    }
+    return _mm_movemask_epi8( result ) == 0xFFFF;
+#else
+    const u64* words = (const u64*)block;
+    u64 missing = 0;
+    for( usize i = 0; i < static_array_len( mask ); ++i ) {
+        missing |= mask[i] & ~words[i];
+    }
+    return missing == 0;
+#endif
+}
+
+attr_core_api
+usize cuckoo_filter_calculate_size(
+    usize capacity, f32 false_positive_rate,
+    usize* out_bucket_count, u32* out_fingerprint_bits
+) {
+    debug_assert(
+        false_positive_rate > 0.0f && false_positive_rate < 1.0f,
+        "cuckoo_filter_calculate_size: false positive rate must be in range (0, 1)!" );
+    // NOTE(alicia): false positive rate ~= 2 * bucket size / 2^bits
+    f32 bits_f = internal_filter_log2(
+        (2.0f * CUCKOO_FILTER_BUCKET_SIZE) / false_positive_rate );
+    u32 bits   = (u32)bits_f;
+    if( (f32)bits < bits_f ) {
+        bits++;
+    }
+    // NOTE(alicia): fewer fingerprint bits than this means too few
+    // alternate buckets and inserts start failing at high load.
+    if( bits < 8 ) {
+        bits = 8;
+    } else if( bits > 16 ) {
+        bits = 16;
+    }
+
+    usize min_buckets = (usize)(
+        (f32)(capacity ? capacity : 1) /
+        ((f32)CUCKOO_FILTER_BUCKET_SIZE * CUCKOO_FILTER_LOAD_RATIO) ) + 1;
+    usize bucket_count = internal_filter_next_pow2( min_buckets );
+
+    *out_bucket_count     = bucket_count;
+    *out_fingerprint_bits = bits;
+    return bucket_count * CUCKOO_FILTER_BUCKET_SIZE * sizeof(u16);
+}
+attr_core_api
+b32 cuckoo_filter_create(
+    struct AllocatorInterface* allocator, usize capacity,
+    f32 false_positive_rate, CuckooFilter* out_filter
+) {
+    usize bucket_count = 0;
+    u32   bits         = 0;
+    usize size         = cuckoo_filter_calculate_size(
+        capacity, false_positive_rate, &bucket_count, &bits );
+
+    void* buckets = allocator_alloc( allocator, size );
+    if( !buckets ) {
+        return false;
+    }
+
+    memory_zero( out_filter, sizeof(*out_filter) );
+    out_filter->bucket_count     = bucket_count;
+    out_filter->fingerprint_mask = (u16)((1u << bits) - 1);
+    out_filter->buckets          = buckets;
+    return true;
+}
+attr_core_api
+void cuckoo_filter_free(
+    struct AllocatorInterface* allocator, CuckooFilter* filter
+) {
+    if( filter->buckets ) {
+        allocator_free(
+            allocator, filter->buckets,
+            filter->bucket_count * CUCKOO_FILTER_BUCKET_SIZE * sizeof(u16) );
+    }
+    memory_zero( filter, sizeof(*filter) );
+}
+attr_core_api
+void cuckoo_filter_clear( CuckooFilter* filter ) {
+    memory_zero(
+        filter->buckets,
+        filter->bucket_count * CUCKOO_FILTER_BUCKET_SIZE * sizeof(u16) );
+    filter->len        = 0;
+    filter->has_victim = false;
+}
+attr_always_inline inline attr_internal
+u16 internal_cuckoo_filter_fingerprint( const CuckooFilter* filter, hash64 hash ) {
+    u16 fp = (u16)(hash >> 48) & filter->fingerprint_mask;
+    // NOTE(alicia): zero marks an empty slot.
+    return fp ? fp : 1;
+}
+attr_always_inline inline attr_internal
+usize internal_cuckoo_filter_alt_index(
+    const CuckooFilter* filter, usize index, u16 fp
+) {
+    return (index ^ ((usize)fp * 0x5bd1e995)) & (filter->bucket_count - 1);
+}
+attr_always_inline inline attr_internal
+b32 internal_cuckoo_filter_bucket_has( const CuckooFilter* filter, usize index, u16 fp ) {
+    // NOTE(alicia): test all four fingerprints at once by
+    // checking for a zero lane after xor.
+    u64 bucket;
+    memory_copy( &bucket, filter->buckets + (index * CUCKOO_FILTER_BUCKET_SIZE), sizeof(bucket) );
+
+    u64 x = bucket ^ ((u64)fp * 0x0001000100010001ULL);
+    return ((x - 0x0001000100010001ULL) & ~x & 0x8000800080008000ULL) != 0;
+}
+attr_internal
+b32 internal_cuckoo_filter_bucket_insert( CuckooFilter* filter, usize index, u16 fp ) {
+    u16* bucket = filter->buckets + (index * CUCKOO_FILTER_BUCKET_SIZE);
+    for( usize i = 0; i < CUCKOO_FILTER_BUCKET_SIZE; ++i ) {
+        if( !bucket[i] ) {
+            bucket[i] = fp;
+            return true;
+        }
+    }
+    return false;
+}
+attr_internal
+b32 internal_cuckoo_filter_bucket_remove( CuckooFilter* filter, usize index, u16 fp ) {
+    u16* bucket = filter->buckets + (index * CUCKOO_FILTER_BUCKET_SIZE);
+    for( usize i = 0; i < CUCKOO_FILTER_BUCKET_SIZE; ++i ) {
+        if( bucket[i] == fp ) {
+            bucket[i] = 0;
+            return true;
+        }
+    }
+    return false;
+}
+attr_internal
+b32 internal_cuckoo_filter_place( CuckooFilter* filter, usize index, u16 fp ) {
+    usize i1 = index;
+    usize i2 = internal_cuckoo_filter_alt_index( filter, i1, fp );
+    if(
+        internal_cuckoo_filter_bucket_insert( filter, i1, fp ) ||
+        internal_cuckoo_filter_bucket_insert( filter, i2, fp )
+    ) {
+        return true;
+    }
+
+    usize current = (fp & 1) ? i2 : i1;
+    for( usize kick = 0; kick < CUCKOO_FILTER_MAX_KICKS; ++kick ) {
+        u16* bucket = filter->buckets + (current * CUCKOO_FILTER_BUCKET_SIZE);
+        usize slot  = (kick + fp) % CUCKOO_FILTER_BUCKET_SIZE;
+
+        u16 evicted  = bucket[slot];
+        bucket[slot] = fp;
+        fp           = evicted;
+
+        current = internal_cuckoo_filter_alt_index( filter, current, fp );
+        if( internal_cuckoo_filter_bucket_insert( filter, current, fp ) ) {
+            return true;
+        }
+    }
+
+    filter->has_victim         = true;
+    filter->victim_fingerprint = fp;
+    filter->victim_index       = current;
+    return true;
+}
+attr_core_api
+b32 cuckoo_filter_insert( CuckooFilter* filter, hash64 hash ) {
+    if( filter->has_victim ) {
+        return false;
+    }
+    u16   fp    = internal_cuckoo_filter_fingerprint( filter, hash );
+    usize index = (usize)hash & (filter->bucket_count - 1);
+
+    internal_cuckoo_filter_place( filter, index, fp );
+    filter->len++;
+    return true;
+}
+attr_core_api
+b32 cuckoo_filter_contains( const CuckooFilter* filter, hash64 hash ) {
+    u16   fp = internal_cuckoo_filter_fingerprint( filter, hash );
+    usize i1 = (usize)hash & (filter->bucket_count - 1);
+    usize i2 = internal_cuckoo_filter_alt_index( filter, i1, fp );
+
+    if(
+        filter->has_victim && filter->victim_fingerprint == fp &&
+        ( filter->victim_index == i1 || filter->victim_index == i2 )
+    ) {
+        return true;
+    }
+
+    return
+        internal_cuckoo_filter_bucket_has( filter, i1, fp ) ||
+        internal_cuckoo_filter_bucket_has( filter, i2, fp );
+}
+attr_core_api
+b32 cuckoo_filter_remove( CuckooFilter* filter, hash64 hash ) {
+    u16   fp = internal_cuckoo_filter_fingerprint( filter, hash );
+    usize i1 = (usize)hash & (filter->bucket_count - 1);
+    usize i2 = internal_cuckoo_filter_alt_index( filter, i1, fp );
+
+    if(
+        internal_cuckoo_filter_bucket_remove( filter, i1, fp ) ||
+        internal_cuckoo_filter_bucket_remove( filter, i2, fp )
+    ) {
+        filter->len--;
+        if( filter->has_victim ) {
+            // NOTE(alicia): there's room now, try to place victim again.
+            filter->has_victim = false;
+            internal_cuckoo_filter_place(
+                filter, filter->victim_index, filter->victim_fingerprint );
+        }
+        return true;
+    }
+
+    if(
+        filter->has_victim && filter->victim_fingerprint == fp &&
+        ( filter->victim_index == i1 || filter->victim_index == i2 )
+    ) {
+        filter->has_victim = false;
+        filter->len--;
+        return true;
+    }
+    return false;
+}
+
+#undef BLOOM_FILTER_BLOCK_BITS
+#undef BLOOM_FILTER_MAX_HASHES
+#undef CUCKOO_FILTER_MAX_KICKS
+#undef CUCKOO_FILTER_LOAD_RATIO
+#undef LN2
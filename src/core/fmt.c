@@ -16,17 +16,20 @@
 #include "core/macros.h"
 #include "core/constants.h"
 #include "core/math.h"
+#include "core/internal/bits.h"
 
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+    #include "core/internal/sse.h" // IWYU pragma: keep
+#endif
+
+#include "src/core/float_tables.c"
+
+// NOTE(alicia): digit tables are only read by scalar
+// binary and hexadecimal formatting.
+#if !defined(CORE_ENABLE_SSE_INSTRUCTIONS)
 attr_global
 char FMT_DIGITS_BINARY[2]   = { '0', '1' };
 attr_global
-char FMT_DIGITS_DECIMAL[10] = {
-    '0', '1', '2',
-    '3', '4', '5',
-    '6', '7', '8',
-    '9'
-};
-attr_global
 char FMT_DIGITS_HEXADECIMAL_UPPER[16] = {
     '0', '1', '2',
     '3', '4', '5',
@@ -44,10 +47,18 @@ char FMT_DIGITS_HEXADECIMAL_LOWER[16] = {
     'c', 'd', 'e',
     'f'
 };
+#endif
 #define BASE_BINARY      (2)
 #define BASE_DECIMAL     (10)
 #define BASE_HEXADECIMAL (16)
 #define NUMBER_FORMAT_BUFFER_SIZE (128)
+/// @brief Number of integers loaded from integer array at a time.
+#define INT_FORMAT_BLOCK_SIZE (32)
+/// @brief Size of buffer that formatted integers are streamed from.
+#define INT_FORMAT_BATCH_SIZE (512)
+// NOTE(alicia): sign, 309 integer digits and their commas,
+// decimal point, FMT_FLOAT_MAX_PRECISION digits and memory suffix.
+#define FLOAT_FORMAT_BUFFER_SIZE (1536)
 
 union FmtValue {
     const void*  ptr;
@@ -298,9 +309,10 @@ f64 internal_float_index(
     }
     return res;
 }
-attr_internal 
-void internal_float_fmt(
-    f64 value, b32 separate, int precision, struct _StringBufPOD* buf );
+attr_internal
+usize internal_float_fmt_index(
+    int bitdepth, const void* floats, usize index,
+    FormatFloatFlags flags, int precision, char* out );
 attr_internal
 void internal_memory_fmt(
     f64 value, int precision, b32 kibi, struct _StringBufPOD* buf );
@@ -319,9 +331,7 @@ usize stream_fmt_float(
         res += stream( target, 2, "{ " );
     }
 
-    char _buf[NUMBER_FORMAT_BUFFER_SIZE];
-    memory_zero( _buf, sizeof(_buf) );
-
+    char _buf[FLOAT_FORMAT_BUFFER_SIZE];
     struct _StringBufPOD buf = string_buf_new( sizeof(_buf), _buf );
 
     int precision = args->precision;
@@ -340,8 +350,6 @@ usize stream_fmt_float(
     int vector_counter   = 0;
     int max_counter      = 0;
 
-    b32 seperate = bitfield_check( args->flags, FMT_FLOAT_SEPARATE );
-
     switch( args->flags & FMT_FLOAT_VECTOR_MASK ) {
         case FMT_FLOAT_VECTOR2: {
             normalized_count *= 2;
@@ -372,12 +380,12 @@ usize stream_fmt_float(
                 res += stream( target, 2, "{ " );
             }
         }
-        f64 value = internal_float_index( bitdepth, floats, i );
-
         if( memory ) {
-            internal_memory_fmt( value, precision, kibi, &buf );
+            internal_memory_fmt(
+                internal_float_index( bitdepth, floats, i ), precision, kibi, &buf );
         } else {
-            internal_float_fmt( value, seperate, precision, &buf );
+            buf.len = internal_float_fmt_index(
+                bitdepth, floats, i, args->flags, precision, buf.buf );
         }
 
         struct _StringPOD output_string = string_new( buf.len, buf.cbuf );
@@ -412,49 +420,138 @@ usize stream_fmt_float(
     }
     return res;
 }
+/// @brief Load block of integers, sign or zero extended to 64 bits.
+/// @note Bit depth is switched on once per block instead of once per integer.
 attr_internal
-u64 internal_int_index(
-    b32 is_signed, int bitdepth, const void* integers, usize index
+void internal_int_load(
+    b32 is_signed, int bitdepth, const void* integers,
+    usize index, usize count, u64* out
 ) {
     if( is_signed ) {
-        i64 res = 0;
         switch( bitdepth ) {
             case 8: {
-                res = *((i8*)integers + index);
-            } break;
+                const i8* src = (const i8*)integers + index;
+                for( usize i = 0; i < count; ++i ) {
+                    out[i] = (u64)(i64)src[i];
+                }
+            } return;
             case 16: {
-                res = *((i16*)integers + index);
-            } break;
+                const i16* src = (const i16*)integers + index;
+                for( usize i = 0; i < count; ++i ) {
+                    out[i] = (u64)(i64)src[i];
+                }
+            } return;
             case 32: {
-                res = *((i32*)integers + index);
-            } break;
+                const i32* src = (const i32*)integers + index;
+                for( usize i = 0; i < count; ++i ) {
+                    out[i] = (u64)(i64)src[i];
+                }
+            } return;
             case 64: {
-                res = *((i64*)integers + index);
-            } break;
+                const i64* src = (const i64*)integers + index;
+                for( usize i = 0; i < count; ++i ) {
+                    out[i] = (u64)src[i];
+                }
+            } return;
         }
-        return rcast( u64, &res );
     } else {
         switch( bitdepth ) {
             case 8: {
-                return *((u8*)integers + index);
-            } break;
+                const u8* src = (const u8*)integers + index;
+                for( usize i = 0; i < count; ++i ) {
+                    out[i] = src[i];
+                }
+            } return;
             case 16: {
-                return *((u16*)integers + index);
-            } break;
+                const u16* src = (const u16*)integers + index;
+                for( usize i = 0; i < count; ++i ) {
+                    out[i] = src[i];
+                }
+            } return;
             case 32: {
-                return *((u32*)integers + index);
-            } break;
+                const u32* src = (const u32*)integers + index;
+                for( usize i = 0; i < count; ++i ) {
+                    out[i] = src[i];
+                }
+            } return;
             case 64: {
-                return *((u64*)integers + index);
-            } break;
+                const u64* src = (const u64*)integers + index;
+                for( usize i = 0; i < count; ++i ) {
+                    out[i] = src[i];
+                }
+            } return;
         }
     }
     unreachable();
 }
+/// @brief Formatted text that is collected before streaming it.
+typedef struct InternalFmtBatch {
+    StreamBytesFN* stream;
+    void*          target;
+    usize          res;
+    usize          len;
+    char           buf[INT_FORMAT_BATCH_SIZE];
+} InternalFmtBatch;
+
+attr_internal
+void internal_fmt_batch_flush( InternalFmtBatch* batch ) {
+    if( batch->len ) {
+        batch->res += batch->stream( batch->target, batch->len, batch->buf );
+        batch->len  = 0;
+    }
+}
+attr_internal
+void internal_fmt_batch_push(
+    InternalFmtBatch* batch, usize len, const char* text
+) {
+    if( batch->len + len > INT_FORMAT_BATCH_SIZE ) {
+        internal_fmt_batch_flush( batch );
+        if( len > INT_FORMAT_BATCH_SIZE ) {
+            batch->res += batch->stream( batch->target, len, text );
+            return;
+        }
+    }
+    memory_copy( batch->buf + batch->len, text, len );
+    batch->len += len;
+}
+attr_internal
+void internal_fmt_batch_repeat( InternalFmtBatch* batch, usize n, char c ) {
+    while( n ) {
+        if( batch->len == INT_FORMAT_BATCH_SIZE ) {
+            internal_fmt_batch_flush( batch );
+        }
+        usize space = INT_FORMAT_BATCH_SIZE - batch->len;
+        usize len   = n < space ? n : space;
+
+        memory_set( batch->buf + batch->len, (u8)c, len );
+        batch->len += len;
+        n          -= len;
+    }
+}
+attr_internal
+void internal_fmt_batch_padded(
+    InternalFmtBatch* batch, int padding,
+    char padding_c, usize len, const char* text
+) {
+    u32 upadding = num_abs( padding );
+    if( len > upadding ) {
+        upadding = 0;
+    } else {
+        upadding -= len;
+    }
+
+    if( padding < 0 ) {
+        internal_fmt_batch_push( batch, len, text );
+        internal_fmt_batch_repeat( batch, upadding, padding_c );
+    } else {
+        internal_fmt_batch_repeat( batch, upadding, padding_c );
+        internal_fmt_batch_push( batch, len, text );
+    }
+}
 attr_internal
-void internal_int_fmt(
+usize internal_int_fmt(
     u64 value, b32 is_signed, int bitdepth, int base,
-    enum FmtIntWidth width, struct _StringBufPOD* buf );
+    enum FmtIntWidth width, char* out );
 attr_core_api
 usize stream_fmt_int(
     StreamBytesFN* stream, void* target,
@@ -464,16 +561,6 @@ usize stream_fmt_int(
     if( !count ) {
         return 0;
     }
-    usize res = 0;
-
-    if( count > 1 ) {
-        res += stream( target, 2, "{ " );
-    }
-
-    char _buf[NUMBER_FORMAT_BUFFER_SIZE];
-    memory_zero( _buf, sizeof(_buf) );
-
-    struct _StringBufPOD buf = string_buf_new( sizeof(_buf), _buf );
 
     int bitdepth = 8;
     switch( args->flags & FMT_INT_BITDEPTH_MASK ) {
@@ -506,8 +593,8 @@ usize stream_fmt_int(
 
     b32 kibi             = bitfield_check( args->flags, FMT_INT_MEMORY_KIBI );
     u32 normalized_count = count;
-    int vector_counter   = 0;
-    int max_counter      = 0;
+    u32 vector_counter   = 0;
+    u32 max_counter      = 0;
     b32 is_signed        = bitfield_check( args->flags, FMT_INT_SIGNED );
 
     enum FmtIntWidth width = FMT_INT_WIDTH_NORMAL;
@@ -537,49 +624,67 @@ usize stream_fmt_int(
             memory = false;
             kibi   = false;
         } break;
-        default: {
-            vector_counter = -1;
-        } break;
+        default: break;
     }
 
-    for( u32 i = 0; i < normalized_count; ++i ) {
-        if( vector_counter >= 0 ) {
-            if( !vector_counter ) {
-                res += stream( target, 2, "{ " );
-            }
-        }
-        u64 value = internal_int_index( is_signed, bitdepth, integers, i );
+    // NOTE(alicia): integers, padding and separators are collected
+    // in batch so stream is called once per batch instead of
+    // several times per integer.
+    InternalFmtBatch batch;
+    batch.stream = stream;
+    batch.target = target;
+    batch.res    = 0;
+    batch.len    = 0;
 
-        if( memory ) {
-            internal_memory_fmt( (f64)value, 2, kibi, &buf );
-        } else {
-            internal_int_fmt(
-                value, is_signed, bitdepth,
-                base, width, &buf );
+    if( count > 1 ) {
+        internal_fmt_batch_push( &batch, 2, "{ " );
+    }
+
+    char text[NUMBER_FORMAT_BUFFER_SIZE];
+    u64  values[INT_FORMAT_BLOCK_SIZE];
+    for( u32 start = 0; start < normalized_count; start += INT_FORMAT_BLOCK_SIZE ) {
+        u32 block = normalized_count - start;
+        if( block > INT_FORMAT_BLOCK_SIZE ) {
+            block = INT_FORMAT_BLOCK_SIZE;
         }
+        internal_int_load( is_signed, bitdepth, integers, start, block, values );
 
-        res += stream_padded(
-            stream, target, pad, padding_c, buf.len, buf.cbuf );
+        for( u32 i = 0; i < block; ++i ) {
+            if( max_counter && !vector_counter ) {
+                internal_fmt_batch_push( &batch, 2, "{ " );
+            }
 
-        if( vector_counter >= 0 ) {
-            vector_counter++;
-            if( vector_counter >= max_counter ) {
-                res += stream( target, 2, " }" );
-                vector_counter = 0;
+            usize len = 0;
+            if( memory ) {
+                struct _StringBufPOD buf = string_buf_new( sizeof(text), text );
+                internal_memory_fmt( (f64)values[i], 2, kibi, &buf );
+                len = buf.len;
+            } else {
+                len = internal_int_fmt(
+                    values[i], is_signed, bitdepth, base, width, text );
             }
-        }
 
-        if( i + 1 < normalized_count ) {
-            res += stream( target, 2, ", " );
+            internal_fmt_batch_padded( &batch, pad, padding_c, len, text );
+
+            if( max_counter ) {
+                vector_counter++;
+                if( vector_counter >= max_counter ) {
+                    internal_fmt_batch_push( &batch, 2, " }" );
+                    vector_counter = 0;
+                }
+            }
+
+            if( start + i + 1 < normalized_count ) {
+                internal_fmt_batch_push( &batch, 2, ", " );
+            }
         }
-        string_buf_clear( &buf );
     }
 
     if( count > 1 ) {
-        res += stream( target, 2, " }" );
+        internal_fmt_batch_push( &batch, 2, " }" );
     }
-    return res;
-
+    internal_fmt_batch_flush( &batch );
+    return batch.res;
 }
 attr_core_api
 usize stream_fmt_args(
@@ -732,213 +837,802 @@ u32 internal_int_max_digits( int bitdepth, int base ) {
     }
     unreachable();
 }
+
+// NOTE(alicia): decimal digits are written right to left two at a time
+// from table of digit pairs so there is one division per two digits.
+// number of digits is known up front from leading zero count,
+// 1233 / 4096 approximates log10(2) and table of powers of ten
+// corrects estimate.
+
+attr_global const char global_fmt_digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+attr_global const u64 global_fmt_pow10_u64[20] = {
+    1ULL,
+    10ULL,
+    100ULL,
+    1000ULL,
+    10000ULL,
+    100000ULL,
+    1000000ULL,
+    10000000ULL,
+    100000000ULL,
+    1000000000ULL,
+    10000000000ULL,
+    100000000000ULL,
+    1000000000000ULL,
+    10000000000000ULL,
+    100000000000000ULL,
+    1000000000000000ULL,
+    10000000000000000ULL,
+    100000000000000000ULL,
+    1000000000000000000ULL,
+    10000000000000000000ULL,
+};
+
+/// @brief Count decimal digits in integer, zero has one digit.
+attr_always_inline inline attr_internal
+u32 internal_fmt_decimal_count( u64 value ) {
+    value |= 1;
+    u32 bits  = 64 - internal_bits_clz64( value );
+    u32 count = (bits * 1233) >> 12;
+    return count + (value >= global_fmt_pow10_u64[count]);
+}
+/// @brief Write decimal digits of integer.
+/// @details
+/// Writes exactly @c count digits, digits above
+/// most significant digit of @c value are zeroes.
+/// @param      value Integer to write.
+/// @param      count Number of digits to write, must be at least digit count of @c value.
+/// @param[out] out   Pointer to write digits to.
 attr_internal
-void internal_int_0(
-    enum FmtIntWidth width, int bitdepth, int base, struct _StringBufPOD* buf
-) {
-    switch( base ) {
-        case FMT_INT_BINARY: {
-            string_buf_try_push( buf, '0' );
-            string_buf_try_push( buf, 'b' );
-            switch( width ) {
-                case FMT_INT_WIDTH_NORMAL: {
-                    string_buf_try_push( buf, '0' );
-                } break;
-                case FMT_INT_WIDTH_SEPARATE: {
-                    for( int i = 0; i < bitdepth; ++i ) {
-                        string_buf_try_push( buf, '0' );
-                        if( i && !((i + 1) % 8) && (i + 1) != bitdepth ) {
-                            string_buf_try_push( buf, '\'' );
-                        }
-                    }
-                } break;
-                case FMT_INT_WIDTH_FULL: {
-                    for( int i = 0; i < bitdepth; ++i ) {
-                        string_buf_try_push( buf, '0' );
-                    }
-                } break;
-            }
-        } break;
-        case FMT_INT_HEX_LOWER:
-        case FMT_INT_HEX_UPPER: {
-            string_buf_try_push( buf, '0' );
-            string_buf_try_push( buf, 'x' );
-            switch( width ) {
-                case FMT_INT_WIDTH_NORMAL: {
-                    string_buf_try_push( buf, '0' );
-                } break;
-                case FMT_INT_WIDTH_SEPARATE: {
-                    int max = bitdepth / 4;
-                    for( int i = 0; i < max; ++i ) {
-                        string_buf_try_push( buf, '0' );
-                        if( i && !((i + 1) % 4) && (i + 1) != max ) {
-                            string_buf_try_push( buf, '\'' );
-                        }
-                    }
-                } break;
-                case FMT_INT_WIDTH_FULL: {
-                    int max = bitdepth / 4;
-                    for( int i = 0; i < max; ++i ) {
-                        string_buf_try_push( buf, '0' );
-                    }
-                } break;
-            }
-        } break;
-        case 0: {
-            switch( width ) {
-                case FMT_INT_WIDTH_NORMAL: {
-                    string_buf_try_push( buf, '0' );
-                } break;
-                case FMT_INT_WIDTH_SEPARATE: {
-                    string_buf_try_push( buf, '0' );
-                } break;
-                case FMT_INT_WIDTH_FULL: {
-                    u32 max = internal_int_max_digits( bitdepth, base );
-                    for( u32 i = 0; i < max; ++i ) {
-                        string_buf_try_push( buf, '0' );
-                    }
-                } break;
-            }
-        } break;
-        default: unreachable();
+void internal_fmt_write_decimal( u64 value, u32 count, char* out ) {
+    char* at = out + count;
+    while( value >= 100 ) {
+        const char* pair = global_fmt_digit_pairs + (value % 100) * 2;
+        value /= 100;
+
+        at   -= 2;
+        at[0] = pair[0];
+        at[1] = pair[1];
+    }
+    if( value >= 10 ) {
+        const char* pair = global_fmt_digit_pairs + value * 2;
+        at   -= 2;
+        at[0] = pair[0];
+        at[1] = pair[1];
+    } else {
+        *--at = (char)('0' + value);
+    }
+    while( at > out ) {
+        *--at = '0';
     }
 }
+/// @brief Write lowest @c count (<= 16) hexadecimal digits of integer.
 attr_internal
-void internal_int_fmt(
-    u64 value, b32 is_signed, int bitdepth, int base,
-    enum FmtIntWidth width, struct _StringBufPOD* in_buf
+void internal_fmt_write_hex( u64 value, u32 count, b32 upper, char* out ) {
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+    // NOTE(alicia): bytes are swapped so most significant nibble comes first,
+    // high and low nibbles are interleaved into 16 lanes and
+    // lanes above 9 are moved up to letters.
+    u64 swapped = internal_bits_bswap64( value );
+
+    __m128i nibble_mask = _mm_set1_epi8( 0x0F );
+    __m128i bytes       = _mm_loadl_epi64( (const __m128i*)&swapped );
+    __m128i high        = _mm_and_si128( _mm_srli_epi16( bytes, 4 ), nibble_mask );
+    __m128i low         = _mm_and_si128( bytes, nibble_mask );
+    __m128i nibbles     = _mm_unpacklo_epi8( high, low );
+
+    __m128i letters = _mm_and_si128(
+        _mm_cmpgt_epi8( nibbles, _mm_set1_epi8( 9 ) ),
+        _mm_set1_epi8( (char)((upper ? 'A' : 'a') - '0' - 10) ) );
+    __m128i text = _mm_add_epi8(
+        _mm_add_epi8( nibbles, _mm_set1_epi8( '0' ) ), letters );
+
+    char full[16];
+    _mm_storeu_si128( (__m128i*)full, text );
+    memory_copy( out, full + (16 - count), count );
+#else
+    const char* digits = upper ?
+        FMT_DIGITS_HEXADECIMAL_UPPER : FMT_DIGITS_HEXADECIMAL_LOWER;
+    for( u32 i = count; i-- > 0; ) {
+        out[i]  = digits[value & 0xF];
+        value >>= 4;
+    }
+#endif
+}
+/// @brief Write lowest @c count (<= 64) binary digits of integer.
+attr_internal
+void internal_fmt_write_binary( u64 value, u32 count, char* out ) {
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+    // NOTE(alicia): two bytes are broadcast to eight lanes each and
+    // every lane tests one bit, most significant bit first.
+    __m128i bits = _mm_set_epi8(
+        1, 2, 4, 8, 16, 32, 64, (char)0x80,
+        1, 2, 4, 8, 16, 32, 64, (char)0x80 );
+    __m128i zero = _mm_set1_epi8( '0' );
+
+    char full[64];
+    for( u32 i = 0; i < 4; ++i ) {
+        u32 shift = 48 - (i * 16);
+        __m128i bytes = _mm_unpacklo_epi64(
+            _mm_set1_epi8( (char)(value >> (shift + 8)) ),
+            _mm_set1_epi8( (char)(value >> shift) ) );
+        __m128i set = _mm_cmpeq_epi8( _mm_and_si128( bytes, bits ), bits );
+
+        // NOTE(alicia): set lanes are -1 so subtracting them gives '1'.
+        _mm_storeu_si128( (__m128i*)(full + (i * 16)), _mm_sub_epi8( zero, set ) );
+    }
+    memory_copy( out, full + (64 - count), count );
+#else
+    for( u32 i = count; i-- > 0; ) {
+        out[i]  = FMT_DIGITS_BINARY[value & 1];
+        value >>= 1;
+    }
+#endif
+}
+/// @brief Copy digits, inserting separator between groups counted from last digit.
+attr_internal
+u32 internal_fmt_write_separated(
+    const char* digits, u32 count, u32 group, char separator, char* out
 ) {
-    if( !value ) {
-        internal_int_0( width, bitdepth, base, in_buf );
-        return;
+    u32 first = count % group;
+    if( !first ) {
+        first = group;
     }
+    memory_copy( out, digits, first );
 
-    b32 neg = false;
-    u64 abs = value;
-
-    u32   max_digit_count = internal_int_max_digits( bitdepth, base );
-    char* digits          = NULL;
-    u64   base_num        = 0;
-    char  sep             = 0;
-    u32   sep_at          = 0;
+    u32 at = first;
+    for( u32 i = first; i < count; i += group ) {
+        out[at++] = separator;
+        memory_copy( out + at, digits + i, group );
+        at += group;
+    }
+    return at;
+}
+/// @brief Format integer.
+/// @param      value     Integer, sign extended to 64 bits if @c is_signed.
+/// @param      is_signed If integer is signed.
+/// @param      bitdepth  Bit depth of integer.
+/// @param      base      Base flags of integer.
+/// @param      width     Width of formatted integer.
+/// @param[out] out       Pointer to write to, must be able to hold #NUMBER_FORMAT_BUFFER_SIZE bytes.
+/// @return Number of bytes written.
+attr_internal
+usize internal_int_fmt(
+    u64 value, b32 is_signed, int bitdepth, int base,
+    enum FmtIntWidth width, char* out
+) {
+    u32 max_digit_count = internal_int_max_digits( bitdepth, base );
+    b32 separate        = width == FMT_INT_WIDTH_SEPARATE;
+
+    char  separated[64];
+    char* digits = separated;
+    usize at     = 0;
+    u32   count  = 0;
+    u32   group  = 0;
+    char  sep    = '\'';
     switch( base ) {
         // base 10
         case 0: {
-            if( is_signed ) {
-                i64 signed_value = rcast( i64, &value );
-                if( signed_value < 0 ) {
-                    neg = true;
-                    abs = num_abs( signed_value );
-                }
+            u64 abs = value;
+            if( is_signed && (i64)value < 0 ) {
+                out[at++] = '-';
+                abs       = 0 - value;
             }
-            base_num = 10;
-            digits   = FMT_DIGITS_DECIMAL;
-            sep      = ',';
-            sep_at   = 3;
-        } break;
-        case FMT_INT_BINARY: {
-            base_num = 2;
-            digits   = FMT_DIGITS_BINARY;
-            sep      = '\'';
-            sep_at   = 8;
+            if( !separate ) {
+                digits = out + at;
+            }
+            count = width == FMT_INT_WIDTH_FULL ?
+                max_digit_count : internal_fmt_decimal_count( abs );
+            group = 3;
+            sep   = ',';
 
-            string_buf_try_append( in_buf, string_text( "0b" ) );
+            internal_fmt_write_decimal( abs, count, digits );
         } break;
+        case FMT_INT_BINARY:
         case FMT_INT_HEX_UPPER:
         case FMT_INT_HEX_LOWER: {
-            base_num = 16;
-            digits   = (base == FMT_INT_HEX_UPPER) ?
-                FMT_DIGITS_HEXADECIMAL_UPPER : FMT_DIGITS_HEXADECIMAL_LOWER;
-            sep      = '\'';
-            sep_at   = 4;
+            // NOTE(alicia): only bits of original bit depth are formatted,
+            // signed integers are sign extended.
+            if( bitdepth < 64 ) {
+                value &= (1ULL << bitdepth) - 1;
+            }
+            out[at++] = '0';
+            out[at++] = base == FMT_INT_BINARY ? 'b' : 'x';
+            if( !separate ) {
+                digits = out + at;
+            }
+
+            u32 bits = 64 - internal_bits_clz64( value | 1 );
+            if( base == FMT_INT_BINARY ) {
+                count = width == FMT_INT_WIDTH_NORMAL ? bits : max_digit_count;
+                group = 8;
 
-            string_buf_try_append( in_buf, string_text( "0x" ) );
+                internal_fmt_write_binary( value, count, digits );
+            } else {
+                count = width == FMT_INT_WIDTH_NORMAL ? (bits + 3) / 4 : max_digit_count;
+                group = 4;
+
+                internal_fmt_write_hex(
+                    value, count, base == FMT_INT_HEX_UPPER, digits );
+            }
         } break;
         default: unreachable();
     }
 
-    if( neg ) {
-        string_buf_try_push( in_buf, '-' );
+    if( separate ) {
+        return at + internal_fmt_write_separated(
+            digits, count, group, sep, out + at );
     }
-    u32 rev_start = in_buf->len;
+    return at + count;
+}
+// NOTE(alicia): shortest float formatting follows Junekey Jeon's Dragonbox.
+// it finds shortest decimal in rounding interval of float and when
+// there are several, one closest to exact value, with 128-bit
+// significands of powers of ten shared with float parsing.
+// fixed and scientific formatting round shortest digits when
+// that is provably same as rounding exact value, otherwise exact
+// digits are generated with big integer arithmetic.
+
+/// @brief Parameters of binary floating point format.
+typedef struct InternalFmtFloatFormat {
+    i32 mantissa_bits;
+    i32 exponent_bits;
+    i32 exponent_bias;
+    i32 min_exponent;
+    i32 kappa;
+    u32 big_divisor;
+    u32 small_divisor;
+    i32 shorter_tie_exponent;
+} InternalFmtFloatFormat;
+
+attr_global const InternalFmtFloatFormat global_fmt_float_f64 = {
+    .mantissa_bits        = 52,
+    .exponent_bits        = 11,
+    .exponent_bias        = 1023,
+    .min_exponent         = -1074,
+    .kappa                = 2,
+    .big_divisor          = 1000,
+    .small_divisor        = 100,
+    .shorter_tie_exponent = -77,
+};
+attr_global const InternalFmtFloatFormat global_fmt_float_f32 = {
+    .mantissa_bits        = 23,
+    .exponent_bits        = 8,
+    .exponent_bias        = 127,
+    .min_exponent         = -149,
+    .kappa                = 1,
+    .big_divisor          = 100,
+    .small_divisor        = 10,
+    .shorter_tie_exponent = -35,
+};
 
-    for( u32 i = 0; i < max_digit_count; ++i ) {
-        char digit = digits[abs % base_num];
+/// @brief Float as decimal significand and power of ten.
+typedef struct InternalFmtDecimal {
+    u64 significand;
+    i32 exponent;
+} InternalFmtDecimal;
+
+/// @brief 128-bit unsigned integer.
+typedef struct InternalFmtU128 {
+    u64 high;
+    u64 low;
+} InternalFmtU128;
+
+/// @brief floor(e * log10(2)), valid for e in [-1700, 1700].
+attr_always_inline inline attr_internal
+i32 internal_fmt_floor_log10_pow2( i32 e ) {
+    return (e * 315653) >> 20;
+}
+/// @brief floor(e * log2(10)), valid for e in [-1233, 1233].
+attr_always_inline inline attr_internal
+i32 internal_fmt_floor_log2_pow10( i32 e ) {
+    return (e * 1741647) >> 19;
+}
+/// @brief floor(e * log10(2) - log10(4 / 3)), valid for e in [-1700, 1700].
+attr_always_inline inline attr_internal
+i32 internal_fmt_floor_log10_pow2_minus_log10_4_over_3( i32 e ) {
+    return ((e * 631305) - 261663) >> 21;
+}
+/// @brief Significand of 10^k rounded up to 128 bits.
+attr_always_inline inline attr_internal
+InternalFmtU128 internal_fmt_pow10_cache( i32 k ) {
+    usize index = (usize)(k - FLOAT_POW5_MIN) * 2;
+
+    InternalFmtU128 result;
+    result.high = global_float_pow5_128[index];
+    result.low  = global_float_pow5_128[index + 1];
+    // NOTE(alicia): table is only exact or rounded up for k in [-27, 55].
+    if( k < -27 || k > 55 ) {
+        result.low++;
+        result.high += !result.low;
+    }
+    return result;
+}
+/// @brief Upper 128 bits of 192-bit product.
+attr_always_inline inline attr_internal
+InternalFmtU128 internal_fmt_mul_upper( u64 x, InternalFmtU128 y ) {
+    InternalFmtU128 result;
+    u64 carry = 0;
+    result.low = internal_bits_mul64( x, y.high, &result.high );
+    internal_bits_mul64( x, y.low, &carry );
+    result.low  += carry;
+    result.high += result.low < carry;
+    return result;
+}
+/// @brief Parity of integer part of x * 2^beta * 10^k and if fractional part is zero.
+attr_always_inline inline attr_internal
+b32 internal_fmt_mul_parity( u64 x, InternalFmtU128 cache, i32 beta, b32* out_is_integer ) {
+    u64 high = 0;
+    u64 low  = internal_bits_mul64( x, cache.low, &high );
+    high += x * cache.high;
+
+    *out_is_integer = ((high << beta) | (low >> (64 - beta))) == 0;
+    return (high >> (64 - beta)) & 1;
+}
+/// @brief Remove trailing zeros from decimal significand.
+attr_always_inline inline attr_internal
+void internal_fmt_remove_trailing_zeros( InternalFmtDecimal* decimal ) {
+    if( !(decimal->significand % 100000000) ) {
+        decimal->significand /= 100000000;
+        decimal->exponent    += 8;
+    }
+    while( !(decimal->significand % 10) ) {
+        decimal->significand /= 10;
+        decimal->exponent++;
+    }
+}
+/// @brief Shortest decimal of power of two, lower half of its rounding interval is narrower.
+attr_internal
+InternalFmtDecimal internal_fmt_float_shortest_boundary(
+    i32 exponent, const InternalFmtFloatFormat* format
+) {
+    InternalFmtDecimal result;
+    i32 minus_k = internal_fmt_floor_log10_pow2_minus_log10_4_over_3( exponent );
+    i32 beta    = exponent + internal_fmt_floor_log2_pow10( -minus_k );
+    i32 shift   = 64 - format->mantissa_bits - 1 - beta;
+
+    InternalFmtU128 cache = internal_fmt_pow10_cache( -minus_k );
+
+    u64 xi = (cache.high - (cache.high >> (format->mantissa_bits + 2))) >> shift;
+    u64 zi = (cache.high + (cache.high >> (format->mantissa_bits + 1))) >> shift;
+    // NOTE(alicia): left endpoint is only an integer for exponents 2 and 3.
+    if( exponent < 2 || exponent > 3 ) {
+        xi++;
+    }
 
-        string_buf_try_push( in_buf, digit );
+    result.significand = zi / 10;
+    if( (result.significand * 10) >= xi ) {
+        result.exponent = minus_k + 1;
+        internal_fmt_remove_trailing_zeros( &result );
+        return result;
+    }
 
-        abs /= base_num;
-        switch( width ) {
-            case FMT_INT_WIDTH_NORMAL: {
-                if( !abs ) {
-                    goto internal_int_fmt_end;
-                }
-            } break;
-            case FMT_INT_WIDTH_SEPARATE: {
-                if( !base && !abs ) {
-                    goto internal_int_fmt_end;
-                }
-                if( i && !((i + 1) % sep_at) && (i + 1) != max_digit_count ) {
-                    string_buf_try_push( in_buf, sep );
-                }
-            } break;
-            case FMT_INT_WIDTH_FULL: break;
+    result.significand = ((cache.high >> (shift - 1)) + 1) / 2;
+    result.exponent    = minus_k;
+    if( exponent == format->shorter_tie_exponent ) {
+        result.significand &= ~1ULL;
+    } else if( result.significand < xi ) {
+        result.significand++;
+    }
+    return result;
+}
+/// @brief Shortest decimal that converts back to same float.
+/// @param bits Bits of float without sign, must be finite and non-zero.
+attr_always_inline inline attr_internal
+InternalFmtDecimal internal_fmt_float_shortest(
+    u64 bits, const InternalFmtFloatFormat* format
+) {
+    InternalFmtDecimal result;
+    u64 significand = bits & ((1ULL << format->mantissa_bits) - 1);
+    i32 exponent    = (i32)(bits >> format->mantissa_bits);
+    if( exponent ) {
+        exponent -= format->exponent_bias + format->mantissa_bits;
+        if( !significand ) {
+            return internal_fmt_float_shortest_boundary( exponent, format );
+        }
+        significand |= 1ULL << format->mantissa_bits;
+    } else {
+        exponent = format->min_exponent;
+    }
+
+    b32 include_ends = !(significand & 1);
+    i32 minus_k      = internal_fmt_floor_log10_pow2( exponent ) - format->kappa;
+    i32 beta         = exponent + internal_fmt_floor_log2_pow10( -minus_k );
+
+    InternalFmtU128 cache = internal_fmt_pow10_cache( -minus_k );
+
+    // NOTE(alicia): try dividing center of interval by 10^(kappa + 1) first,
+    // delta is width of interval in same units.
+    u32 delta  = (u32)(cache.high >> (63 - beta));
+    u64 two_fc = significand << 1;
+
+    InternalFmtU128 z = internal_fmt_mul_upper( (two_fc | 1) << beta, cache );
+
+    result.significand = z.high / format->big_divisor;
+    u32 r = (u32)(z.high - (format->big_divisor * result.significand));
+    if( r < delta ) {
+        if( !r && !z.low && !include_ends ) {
+            result.significand--;
+            r = format->big_divisor;
+            goto internal_fmt_float_shortest_small;
+        }
+    } else if( r > delta ) {
+        goto internal_fmt_float_shortest_small;
+    } else {
+        b32 x_is_integer = false;
+        b32 x_parity     = internal_fmt_mul_parity( two_fc - 1, cache, beta, &x_is_integer );
+        if( !(x_parity || (x_is_integer && include_ends)) ) {
+            goto internal_fmt_float_shortest_small;
+        }
+    }
+    result.exponent = minus_k + format->kappa + 1;
+    internal_fmt_remove_trailing_zeros( &result );
+    return result;
+
+internal_fmt_float_shortest_small:
+    // NOTE(alicia): one more digit, closest to center of interval.
+    result.significand *= 10;
+    result.exponent     = minus_k + format->kappa;
+
+    u32 half     = format->small_divisor / 2;
+    u32 dist     = r - (delta / 2) + half;
+    b32 y_parity = ((dist ^ half) & 1) != 0;
+    b32 exact    = !(dist % format->small_divisor);
+
+    result.significand += dist / format->small_divisor;
+    if( exact ) {
+        b32 is_integer = false;
+        if( internal_fmt_mul_parity( two_fc, cache, beta, &is_integer ) != y_parity ) {
+            result.significand--;
+        } else if( is_integer && (result.significand & 1) ) {
+            result.significand--;
         }
     }
+    return result;
+}
 
-internal_int_fmt_end:
+/// @brief Most digits in exact decimal value of f64, rounded up to multiple of 9.
+#define FMT_FLOAT_EXACT_DIGITS (774)
+/// @brief Limbs needed to hold largest f64 mantissa * 5^1074.
+#define FMT_BIGINT_LIMBS (80)
 
-    string_mut_reverse( string_advance_by( in_buf->slice, rev_start ) );
+/// @brief Arbitrary precision unsigned integer, least significant limb first.
+typedef struct InternalFmtBigInt {
+    u32 len;
+    u32 limbs[FMT_BIGINT_LIMBS];
+} InternalFmtBigInt;
+
+/// @brief Multiply big integer by 32-bit integer.
+attr_internal
+void internal_fmt_bigint_mul( InternalFmtBigInt* big, u32 x ) {
+    u64 carry = 0;
+    for( u32 i = 0; i < big->len; ++i ) {
+        u64 product    = ((u64)big->limbs[i] * x) + carry;
+        big->limbs[i]  = (u32)product;
+        carry          = product >> 32;
+    }
+    if( carry ) {
+        big->limbs[big->len++] = (u32)carry;
+    }
 }
+/// @brief Shift big integer left.
 attr_internal
-void internal_float_fmt(
-    f64 value, b32 seperate, int precision, struct _StringBufPOD* buf 
+void internal_fmt_bigint_shift_left( InternalFmtBigInt* big, u32 shift ) {
+    u32 limbs = shift / 32;
+    u32 bits  = shift % 32;
+    if( bits ) {
+        u32 carry = 0;
+        for( u32 i = 0; i < big->len; ++i ) {
+            u32 limb      = big->limbs[i];
+            big->limbs[i] = (limb << bits) | carry;
+            carry         = limb >> (32 - bits);
+        }
+        if( carry ) {
+            big->limbs[big->len++] = carry;
+        }
+    }
+    if( limbs ) {
+        for( u32 i = big->len; i-- > 0; ) {
+            big->limbs[i + limbs] = big->limbs[i];
+        }
+        for( u32 i = 0; i < limbs; ++i ) {
+            big->limbs[i] = 0;
+        }
+        big->len += limbs;
+    }
+}
+/// @brief Divide big integer by 32-bit integer.
+/// @return Remainder.
+attr_internal
+u32 internal_fmt_bigint_div( InternalFmtBigInt* big, u32 divisor ) {
+    u64 remainder = 0;
+    for( u32 i = big->len; i-- > 0; ) {
+        u64 current   = (remainder << 32) | big->limbs[i];
+        big->limbs[i] = (u32)(current / divisor);
+        remainder     = current % divisor;
+    }
+    while( big->len && !big->limbs[big->len - 1] ) {
+        big->len--;
+    }
+    return (u32)remainder;
+}
+/// @brief Exact decimal digits of mantissa * 2^exponent.
+/// @param[out] out_digits Buffer, must hold #FMT_FLOAT_EXACT_DIGITS digits.
+/// @param[out] out_point  Position of decimal point relative to first digit.
+/// @return Number of digits, without trailing zeros.
+attr_internal
+u32 internal_fmt_float_exact(
+    u64 mantissa, i32 exponent, char* out_digits, i32* out_point
 ) {
-    // TODO(alicia): Grisu3
-    if( f64_isnan( value ) ) {
-        string_buf_try_append( buf, string_text( "NaN" ) );
-        return;
-    } else if( value == F64_POS_INFINITY ) {
-        string_buf_try_append( buf, string_text( "INF" ) );
-        return;
-    } else if( value == F64_NEG_INFINITY ) {
-        string_buf_try_append( buf, string_text( "-INF" ) );
-        return;
-    }
-
-    i64 whole = (i64)value;
-    f64 fract = num_abs( value ) - (f64)num_abs(whole);
-
-    if( !whole && value < 0.0f ) {
-        string_buf_try_push( buf, '-' );
-    }
-    internal_int_fmt(
-        rcast( u64, &whole ),
-        true, // is_signed
-        64,   // bitdepth
-        0,    // base:  BASE_DECIMAL
-        seperate ? FMT_INT_WIDTH_SEPARATE : FMT_INT_WIDTH_NORMAL,
-        buf );
-    if( fract <= 0.0000001 ) {
-        if( precision ) {
-            string_buf_try_push( buf, '.' );
-            for( int i = 0; i < precision; ++i ) {
-                string_buf_try_push( buf, '0' );
+    InternalFmtBigInt big;
+    big.len      = 2;
+    big.limbs[0] = (u32)mantissa;
+    big.limbs[1] = (u32)(mantissa >> 32);
+    if( !big.limbs[1] ) {
+        big.len = 1;
+    }
+
+    // NOTE(alicia): m * 2^-e is m * 5^e / 10^e,
+    // so only decimal point moves for negative exponents.
+    if( exponent >= 0 ) {
+        internal_fmt_bigint_shift_left( &big, (u32)exponent );
+    } else {
+        i32 power = -exponent;
+        while( power >= 13 ) {
+            internal_fmt_bigint_mul( &big, 1220703125 );
+            power -= 13;
+        }
+        u32 small = 1;
+        while( power-- ) {
+            small *= 5;
+        }
+        internal_fmt_bigint_mul( &big, small );
+    }
+
+    char* end = out_digits + FMT_FLOAT_EXACT_DIGITS;
+    char* at  = end;
+    while( big.len ) {
+        u32 chunk = internal_fmt_bigint_div( &big, 1000000000 );
+        at -= 9;
+        internal_fmt_write_decimal( chunk, 9, at );
+    }
+    while( *at == '0' ) {
+        at++;
+    }
+
+    u32 len = (u32)(end - at);
+    *out_point = (i32)len + (exponent < 0 ? exponent : 0);
+    memory_move( out_digits, at, len );
+    while( out_digits[len - 1] == '0' ) {
+        len--;
+    }
+    return len;
+}
+/// @brief Round digits to first @c count digits, ties to even.
+/// @details Digits must not have trailing zeros.
+/// @return Number of digits left, without trailing zeros.
+attr_internal
+u32 internal_fmt_float_round( char* digits, u32 len, i32 count, i32* io_point ) {
+    if( count >= (i32)len ) {
+        return len;
+    }
+    if( count < 0 ) {
+        return 0;
+    }
+
+    char next = digits[count];
+    b32  up   = next > '5';
+    if( next == '5' ) {
+        up = ((u32)count + 1) < len || (count && ((digits[count - 1] - '0') & 1));
+    }
+
+    len = (u32)count;
+    if( up ) {
+        while( len && digits[len - 1] == '9' ) {
+            len--;
+        }
+        if( !len ) {
+            digits[len++] = '1';
+            (*io_point)++;
+        } else {
+            digits[len - 1]++;
+        }
+    }
+    while( len && digits[len - 1] == '0' ) {
+        len--;
+    }
+    return len;
+}
+/// @brief Write integer part of digits, separated by commas every 3 digits.
+attr_internal
+usize internal_fmt_float_integer(
+    const char* digits, u32 len, i32 point, b32 separate, char* out
+) {
+    if( point <= 0 ) {
+        out[0] = '0';
+        return 1;
+    }
+    usize at = 0;
+    for( i32 i = 0; i < point; ++i ) {
+        if( separate && i && !((point - i) % 3) ) {
+            out[at++] = ',';
+        }
+        out[at++] = i < (i32)len ? digits[i] : '0';
+    }
+    return at;
+}
+/// @brief Write @c count digits starting at @c first, digits outside are zeros.
+attr_internal
+usize internal_fmt_float_digits(
+    const char* digits, u32 len, i32 first, i32 count, char* out
+) {
+    for( i32 i = 0; i < count; ++i ) {
+        i32 index = first + i;
+        out[i] = (index >= 0 && index < (i32)len) ? digits[index] : '0';
+    }
+    return (usize)count;
+}
+/// @brief Write exponent with sign and at least two digits.
+attr_internal
+usize internal_fmt_float_exponent( i32 exponent, char* out ) {
+    usize at = 0;
+    out[at++] = 'e';
+    out[at++] = exponent < 0 ? '-' : '+';
+
+    u32 abs = (u32)(exponent < 0 ? -exponent : exponent);
+    if( abs >= 100 ) {
+        out[at++] = (char)('0' + (abs / 100));
+    }
+    out[at++] = (char)('0' + ((abs / 10) % 10));
+    out[at++] = (char)('0' + (abs % 10));
+    return at;
+}
+attr_internal
+usize internal_float_fmt(
+    u64 bits, const InternalFmtFloatFormat* format,
+    FormatFloatFlags flags, int precision, char* out
+) {
+    i32 sign_shift = format->mantissa_bits + format->exponent_bits;
+    u64 exponent   = (bits >> format->mantissa_bits) & ((1ULL << format->exponent_bits) - 1);
+    u64 mantissa   = bits & ((1ULL << format->mantissa_bits) - 1);
+    b32 negative   = (bits >> sign_shift) & 1;
+    bits          &= ~(1ULL << sign_shift);
+
+    usize at = 0;
+    if( exponent == ((1ULL << format->exponent_bits) - 1) ) {
+        if( mantissa ) {
+            memory_copy( out, "NaN", 3 );
+            return 3;
+        }
+        if( negative ) {
+            out[at++] = '-';
+        }
+        memory_copy( out + at, "INF", 3 );
+        return at + 3;
+    }
+    if( negative ) {
+        out[at++] = '-';
+    }
+
+    char digits[FMT_FLOAT_EXACT_DIGITS];
+    u32  len   = 0;
+    i32  point = 0;
+    if( bits ) {
+        InternalFmtDecimal decimal = internal_fmt_float_shortest( bits, format );
+
+        len   = internal_fmt_decimal_count( decimal.significand );
+        point = (i32)len + decimal.exponent;
+        internal_fmt_write_decimal( decimal.significand, len, digits );
+    }
+
+    b32 scientific = bitfield_check( flags, FMT_FLOAT_SCIENTIFIC );
+    if( bitfield_check( flags, FMT_FLOAT_SHORTEST ) ) {
+        if( !len ) {
+            out[at++] = '0';
+            return scientific ? at + internal_fmt_float_exponent( 0, out + at ) : at;
+        }
+        // NOTE(alicia): same notation as JavaScript, decimal point
+        // for leading digit between 10^-6 and 10^20.
+        if( scientific || point <= -6 || point > 21 ) {
+            out[at++] = digits[0];
+            if( len > 1 ) {
+                out[at++] = '.';
+                memory_copy( out + at, digits + 1, len - 1 );
+                at += len - 1;
             }
+            return at + internal_fmt_float_exponent( point - 1, out + at );
+        }
+        at += internal_fmt_float_integer(
+            digits, len, point, bitfield_check( flags, FMT_FLOAT_SEPARATE ), out + at );
+        if( (i32)len > point ) {
+            out[at++] = '.';
+            at += internal_fmt_float_digits( digits, len, point, (i32)len - point, out + at );
         }
-        return;
+        return at;
     }
 
-    if( !precision ) {
-        return;
+    if( len ) {
+        i32 count = scientific ? precision + 1 : point + precision;
+        b32 exact = false;
+        if( count < (i32)len ) {
+            // NOTE(alicia): only if shortest digits end exactly
+            // halfway could rounding them differ from exact value.
+            exact = count == (i32)(len - 1) && digits[count] == '5';
+        } else {
+            // NOTE(alicia): padding with zeros is only exact when
+            // float is closer to shortest digits than half of last digit.
+            i32 e2 = exponent ?
+                (i32)exponent - format->exponent_bias - format->mantissa_bits :
+                format->min_exponent;
+            i32 last = point - count;
+            if( scientific && len == 1 && digits[0] == '1' ) {
+                // NOTE(alicia): float may be just below power of ten.
+                last--;
+            }
+            exact = last < -400 || e2 > internal_fmt_floor_log2_pow10( last );
+        }
+
+        if( exact ) {
+            if( exponent ) {
+                mantissa |= 1ULL << format->mantissa_bits;
+                len = internal_fmt_float_exact(
+                    mantissa, (i32)exponent - format->exponent_bias - format->mantissa_bits,
+                    digits, &point );
+            } else {
+                len = internal_fmt_float_exact( mantissa, format->min_exponent, digits, &point );
+            }
+            count = scientific ? precision + 1 : point + precision;
+        }
+        len = internal_fmt_float_round( digits, len, count, &point );
     }
 
-    string_buf_try_push( buf, '.' );
-    for( int i = 0; i < precision; ++i ) {
-        fract *= 10.0;
-        u64  idx   = (u64)fract % 10;
-        char digit = FMT_DIGITS_DECIMAL[idx];
-        string_buf_try_push( buf, digit );
+    if( scientific ) {
+        out[at++] = len ? digits[0] : '0';
+        if( precision ) {
+            out[at++] = '.';
+            at += internal_fmt_float_digits( digits, len, 1, precision, out + at );
+        }
+        return at + internal_fmt_float_exponent( len ? point - 1 : 0, out + at );
+    }
+
+    at += internal_fmt_float_integer(
+        digits, len, point, bitfield_check( flags, FMT_FLOAT_SEPARATE ), out + at );
+    if( precision ) {
+        out[at++] = '.';
+        at += internal_fmt_float_digits( digits, len, point, precision, out + at );
+    }
+    return at;
+}
+attr_internal
+usize internal_float_fmt_index(
+    int bitdepth, const void* floats, usize index,
+    FormatFloatFlags flags, int precision, char* out
+) {
+    switch( bitdepth ) {
+        case 32: {
+            union { f32 f; u32 bits; } number;
+            number.f = *((const f32*)floats + index);
+            return internal_float_fmt(
+                number.bits, &global_fmt_float_f32, flags, precision, out );
+        } break;
+        case 64: {
+            union { f64 f; u64 bits; } number;
+            number.f = *((const f64*)floats + index);
+            return internal_float_fmt(
+                number.bits, &global_fmt_float_f64, flags, precision, out );
+        } break;
+        default: unreachable();
     }
 }
 attr_internal
@@ -971,7 +1665,13 @@ void internal_memory_fmt(
         }
     }
 
-    internal_float_fmt( f, true, precision, buf );
+    union { f64 f; u64 bits; } number;
+    number.f = f;
+
+    char  text[FLOAT_FORMAT_BUFFER_SIZE];
+    usize text_len = internal_float_fmt(
+        number.bits, &global_fmt_float_f64, FMT_FLOAT_SEPARATE, precision, text );
+    string_buf_try_append( buf, string_new( text_len, text ) );
     struct _StringPOD storage_text = string_text( " B" );
     switch( storage ) {
         case KB: {
@@ -998,6 +1698,11 @@ void internal_memory_fmt(
 }
 
 #undef NUMBER_FORMAT_BUFFER_SIZE
+#undef INT_FORMAT_BLOCK_SIZE
+#undef INT_FORMAT_BATCH_SIZE
+#undef FLOAT_FORMAT_BUFFER_SIZE
+#undef FMT_FLOAT_EXACT_DIGITS
+#undef FMT_BIGINT_LIMBS
 #undef BASE_BINARY     
 #undef BASE_DECIMAL    
 #undef BASE_HEXADECIMAL
@@ -1326,7 +2031,7 @@ b32 internal_fmt_parse_args(
                         if( !string_parse_uint( prec, &precision ) ) {
                             return false;
                         }
-                        args->floating.precision = num_clamp( (int)precision, 0, 6 );
+                        args->floating.precision = (int)num_min( precision, FMT_FLOAT_MAX_PRECISION );
                     }
 
                     skip();
@@ -1435,6 +2140,28 @@ b32 internal_fmt_parse_args(
                 break;
         }
 
+        // float arguments only.
+        switch( args->type ) {
+            case FT_FLOAT: {
+                if( arg.len == 1 ) {
+                    switch( arg.cbuf[0] ) {
+                        case 'r': {
+                            args->floating.flags |= FMT_FLOAT_SHORTEST;
+                            skip();
+                        } break;
+                        case 'e': {
+                            args->floating.flags |= FMT_FLOAT_SCIENTIFIC;
+                            skip();
+                        } break;
+                        default: break;
+                    }
+                }
+            } break;
+            case FT_ANY: case FT_BOOL: case FT_CHAR:
+            case FT_STRING: case FT_INT: case FT_TIME:
+                break;
+        }
+
         // time arguments only.
         switch( args->type ) {
             case FT_TIME: {
@@ -6,6 +6,13 @@
 */
 #include "core/hash.h"
 #include "core/memory.h"
+#include "core/string.h"
+#include "core/internal/bits.h"
+
+/// @brief How many keys ahead to prefetch in batch functions.
+#define HASH_BATCH_PREFETCH_DISTANCE (8)
+/// @brief Number of keys hashed in lock-step by fixed-width batch functions.
+#define HASH_BATCH_LANES (4)
 
 attr_core_api
 hash64 hash_elf_64( usize len, const void* buf ) {
@@ -131,17 +138,39 @@ u32 internal_hash_bswap_32( u32 v ) {
     return v;
 }
 #undef __swap
-attr_internal
-u64 internal_hash_fetch_64( const char* p ) {
+/// @brief Fold ASCII upper-case letters in word to lower-case.
+attr_always_inline inline attr_internal
+u64 internal_hash_fold_64( u64 word ) {
+    // NOTE(alicia): adding to low 7 bits of each byte never carries
+    // into next byte, high bit of each sum is set when
+    // byte is >= 'A' and > 'Z' respectively.
+    u64 low   = word & 0x7F7F7F7F7F7F7F7FULL;
+    u64 ge_a  = low + 0x3F3F3F3F3F3F3F3FULL;
+    u64 gt_z  = low + 0x2525252525252525ULL;
+    u64 upper = ge_a & ~gt_z & ~word & 0x8080808080808080ULL;
+    return word | (upper >> 2);
+}
+attr_always_inline inline attr_internal
+u8 internal_hash_fold_8( u8 byte ) {
+    return byte | ((u8)(byte - 'A') < 26 ? 0x20 : 0);
+}
+attr_always_inline inline attr_internal
+u64 internal_hash_fetch_64( const char* p, b32 fold ) {
     u64 result = internal_hash_unaligned_load_64( p );
+    if( fold ) {
+        result = internal_hash_fold_64( result );
+    }
 #if defined(CORE_ARCH_BIG_ENDIAN)
     result = internal_hash_bswap_64(result);
 #endif
     return result;
 }
-attr_internal
-u32 internal_fetch_32( const char* p ) {
+attr_always_inline inline attr_internal
+u32 internal_fetch_32( const char* p, b32 fold ) {
     u32 result = internal_hash_unaligned_load_32( p );
+    if( fold ) {
+        result = (u32)internal_hash_fold_64( result );
+    }
 #if defined(CORE_ARCH_BIG_ENDIAN)
     result = internal_hash_bswap_32(result);
 #endif
@@ -159,15 +188,15 @@ struct InternalHashPair internal_hash_weak_hash_len_32_with_seeds_0(
     b += internal_hash_rotate( a, 44 );
     return (struct InternalHashPair){ .x=a + z, .y=b + c };
 }
-attr_internal
+attr_always_inline inline attr_internal
 struct InternalHashPair internal_hash_weak_hash_len_32_with_seeds_1(
-    const char* s, u64 a, u64 b
+    const char* s, u64 a, u64 b, b32 fold
 ) {
     return internal_hash_weak_hash_len_32_with_seeds_0(
-        internal_hash_fetch_64(s),
-        internal_hash_fetch_64(s + 8),
-        internal_hash_fetch_64(s + 16),
-        internal_hash_fetch_64(s + 24),
+        internal_hash_fetch_64( s, fold ),
+        internal_hash_fetch_64( s + 8, fold ),
+        internal_hash_fetch_64( s + 16, fold ),
+        internal_hash_fetch_64( s + 24, fold ),
         a, b );
 }
 attr_internal
@@ -193,26 +222,31 @@ u64 internal_hash_len_16_1( u64 u, u64 v, u64 mul ) {
     b *= mul;
     return b;
 }
-attr_internal
-hash64 internal_hash_len_0_to_16( usize len, const char* s ) {
+attr_always_inline inline attr_internal
+hash64 internal_hash_len_0_to_16( usize len, const char* s, b32 fold ) {
     if( len >= 8 ) {
         u64 mul = K2 + len * 2;
-        u64 a = internal_hash_fetch_64( s ) + K2;
-        u64 b = internal_hash_fetch_64( s + len - 8 );
+        u64 a = internal_hash_fetch_64( s, fold ) + K2;
+        u64 b = internal_hash_fetch_64( s + len - 8, fold );
         u64 c = internal_hash_rotate( b, 37 ) * mul + a;
         u64 d = (internal_hash_rotate( a, 25 ) + b) * mul;
         return internal_hash_len_16_1( c, d, mul );
     }
     if( len >= 4 ) {
         u64 mul = K2 + len * 2;
-        u64 a   = internal_fetch_32( s );
+        u64 a   = internal_fetch_32( s, fold );
         return internal_hash_len_16_1(
-            len + (a << 3), internal_fetch_32( s + len - 4 ), mul );
+            len + (a << 3), internal_fetch_32( s + len - 4, fold ), mul );
     }
     if( len > 0 ) {
         u8 a = ((u8*)s)[0];
         u8 b = ((u8*)s)[len >> 1];
         u8 c = ((u8*)s)[len - 1];
+        if( fold ) {
+            a = internal_hash_fold_8( a );
+            b = internal_hash_fold_8( b );
+            c = internal_hash_fold_8( c );
+        }
         u32 y = (u32)a + ((u32)b << 1);
         u32 z = (u32)len + ((u32)c << 2);
         return internal_hash_shift_mix( y * K2 ^ z * K0 ) * K2;
@@ -220,28 +254,28 @@ hash64 internal_hash_len_0_to_16( usize len, const char* s ) {
 
     return K2;
 }
-attr_internal
-hash64 internal_hash_len_17_to_32( usize len, const char* s ) {
+attr_always_inline inline attr_internal
+hash64 internal_hash_len_17_to_32( usize len, const char* s, b32 fold ) {
     u64 mul = K2 + len * 2;
-    u64 a   = internal_hash_fetch_64( s ) * K1;
-    u64 b   = internal_hash_fetch_64( s + 8 );
-    u64 c   = internal_hash_fetch_64( s + len - 8 ) * mul;
-    u64 d   = internal_hash_fetch_64( s + len - 16 ) * K2;
+    u64 a   = internal_hash_fetch_64( s, fold ) * K1;
+    u64 b   = internal_hash_fetch_64( s + 8, fold );
+    u64 c   = internal_hash_fetch_64( s + len - 8, fold ) * mul;
+    u64 d   = internal_hash_fetch_64( s + len - 16, fold ) * K2;
     return internal_hash_len_16_1(
         internal_hash_rotate( a + b, 43 ) + internal_hash_rotate( c, 30 ) + d,
         a + internal_hash_rotate( b + K2, 18 ) + c, mul );
 }
-attr_internal
-hash64 internal_hash_len_33_to_64( usize len, const char* s ) {
+attr_always_inline inline attr_internal
+hash64 internal_hash_len_33_to_64( usize len, const char* s, b32 fold ) {
     u64 mul = K2 + len * 2;
-    u64 a   = internal_hash_fetch_64( s ) * K2;
-    u64 b   = internal_hash_fetch_64( s + 8 );
-    u64 c   = internal_hash_fetch_64( s + len - 24 );
-    u64 d   = internal_hash_fetch_64( s + len - 32 );
-    u64 e   = internal_hash_fetch_64( s + 16 ) * K2;
-    u64 f   = internal_hash_fetch_64( s + 24 ) * 9;
-    u64 g   = internal_hash_fetch_64( s + len - 8 );
-    u64 h   = internal_hash_fetch_64( s + len - 16 ) * mul;
+    u64 a   = internal_hash_fetch_64( s, fold ) * K2;
+    u64 b   = internal_hash_fetch_64( s + 8, fold );
+    u64 c   = internal_hash_fetch_64( s + len - 24, fold );
+    u64 d   = internal_hash_fetch_64( s + len - 32, fold );
+    u64 e   = internal_hash_fetch_64( s + 16, fold ) * K2;
+    u64 f   = internal_hash_fetch_64( s + 24, fold ) * 9;
+    u64 g   = internal_hash_fetch_64( s + len - 8, fold );
+    u64 h   = internal_hash_fetch_64( s + len - 16, fold ) * mul;
     u64 u   = internal_hash_rotate( a + g, 43 ) +
         ( internal_hash_rotate( b, 30 ) + c ) * 9;
     u64 v   = ( ( a + g ) ^ d ) + f + 1;
@@ -253,45 +287,45 @@ hash64 internal_hash_len_33_to_64( usize len, const char* s ) {
     b       = internal_hash_shift_mix( ( z + a ) * mul + d + h ) * mul;
     return b + x;
 }
-attr_core_api
-hash64 hash_city_64( usize len, const void* _buf ) {
-    const char* buf = _buf;
+/// @brief Cityhash, optionally with ASCII upper-case letters
+/// folded to lower-case as they are loaded.
+attr_always_inline inline attr_internal
+hash64 internal_hash_city_64( usize len, const char* buf, b32 fold ) {
     if( len <= 32 ) {
         if( len <= 16 ) {
-            return internal_hash_len_0_to_16( len, buf );
+            return internal_hash_len_0_to_16( len, buf, fold );
         } else {
-            return internal_hash_len_17_to_32( len, buf );
+            return internal_hash_len_17_to_32( len, buf, fold );
         }
     } else if( len <= 64 ) {
-        return internal_hash_len_33_to_64( len, buf );
+        return internal_hash_len_33_to_64( len, buf, fold );
     }
 
-    u64 x = internal_hash_fetch_64( buf + len - 40 );
-    u64 y = internal_hash_fetch_64(
-        buf + len - 16 ) + internal_hash_fetch_64( buf + len - 56 );
+    u64 x = internal_hash_fetch_64( buf + len - 40, fold );
+    u64 y = internal_hash_fetch_64( buf + len - 16, fold ) + internal_hash_fetch_64( buf + len - 56, fold );
     u64 z = internal_hash_len_16_0(
-        internal_hash_fetch_64( buf + len - 48 ) + len,
-        internal_hash_fetch_64( buf + len - 24));
+        internal_hash_fetch_64( buf + len - 48, fold ) + len,
+        internal_hash_fetch_64( buf + len - 24, fold ));
 
     struct InternalHashPair v =
-        internal_hash_weak_hash_len_32_with_seeds_1( buf + len - 64, len, z );
+        internal_hash_weak_hash_len_32_with_seeds_1( buf + len - 64, len, z, fold );
     struct InternalHashPair w =
-        internal_hash_weak_hash_len_32_with_seeds_1( buf + len - 32, y + K1, x );
+        internal_hash_weak_hash_len_32_with_seeds_1( buf + len - 32, y + K1, x, fold );
 
-    x = x * K1 + internal_hash_fetch_64( buf );
+    x = x * K1 + internal_hash_fetch_64( buf, fold );
 
     len = (len - 1) & ~((usize)63);
     do {
         x = internal_hash_rotate(
-            x + y + v.x + internal_hash_fetch_64( buf + 8), 37 ) * K1;
+            x + y + v.x + internal_hash_fetch_64( buf + 8, fold ), 37 ) * K1;
         y = internal_hash_rotate(
-            y + v.y + internal_hash_fetch_64( buf + 48 ), 42 ) * K1;
+            y + v.y + internal_hash_fetch_64( buf + 48, fold ), 42 ) * K1;
         x ^= w.y;
-        y += v.x + internal_hash_fetch_64( buf + 40 );
+        y += v.x + internal_hash_fetch_64( buf + 40, fold );
         z = internal_hash_rotate( z + w.x, 33 ) * K1;
-        v = internal_hash_weak_hash_len_32_with_seeds_1( buf, v.y * K1, x + w.x );
+        v = internal_hash_weak_hash_len_32_with_seeds_1( buf, v.y * K1, x + w.x, fold );
         w = internal_hash_weak_hash_len_32_with_seeds_1(
-            buf + 32, z + w.y, y + internal_hash_fetch_64( buf + 16 ) );
+            buf + 32, z + w.y, y + internal_hash_fetch_64( buf + 16, fold ), fold );
 
         {
             u64 tmp = z;
@@ -307,6 +341,120 @@ hash64 hash_city_64( usize len, const void* _buf ) {
         internal_hash_len_16_0( v.x, w.x ) + internal_hash_shift_mix(y) * K1 + z,
         internal_hash_len_16_0( v.y, w.y ) + x );
 }
+attr_core_api
+hash64 hash_city_64( usize len, const void* buf ) {
+    return internal_hash_city_64( len, buf, false );
+}
+attr_core_api
+hash64 hash_city_64_ascii_nocase( usize len, const void* buf ) {
+    return internal_hash_city_64( len, buf, true );
+}
+
+
+attr_core_api
+void hash_elf_64_batch(
+    usize count, const struct _StringPOD* keys, hash64* out_hashes
+) {
+    for( usize i = 0; i < count; ++i ) {
+        if( i + HASH_BATCH_PREFETCH_DISTANCE < count ) {
+            internal_prefetch( keys[i + HASH_BATCH_PREFETCH_DISTANCE].cbuf );
+        }
+        out_hashes[i] = hash_elf_64( keys[i].len, keys[i].cbuf );
+    }
+}
+attr_core_api
+void hash_murmur2_64_batch(
+    usize count, const struct _StringPOD* keys, hash64* out_hashes
+) {
+    for( usize i = 0; i < count; ++i ) {
+        if( i + HASH_BATCH_PREFETCH_DISTANCE < count ) {
+            internal_prefetch( keys[i + HASH_BATCH_PREFETCH_DISTANCE].cbuf );
+        }
+        out_hashes[i] = hash_murmur2_64( keys[i].len, keys[i].cbuf );
+    }
+}
+attr_core_api
+void hash_city_64_batch(
+    usize count, const struct _StringPOD* keys, hash64* out_hashes
+) {
+    for( usize i = 0; i < count; ++i ) {
+        if( i + HASH_BATCH_PREFETCH_DISTANCE < count ) {
+            internal_prefetch( keys[i + HASH_BATCH_PREFETCH_DISTANCE].cbuf );
+        }
+        out_hashes[i] = hash_city_64( keys[i].len, keys[i].cbuf );
+    }
+}
+attr_core_api
+void hash_murmur2_64_batch_fixed(
+    usize count, usize key_size, const void* keys, hash64* out_hashes
+) {
+    #define M 0xc6a4a7935bd1e995
+    #define R 47
+    #define SEED 0xA13F346234624
+
+    const char* bytes = (const char*)keys;
+    usize words       = key_size / sizeof(u64);
+    usize tail        = key_size & 7;
+
+    // NOTE(alicia): every key has the same length so every lane
+    // goes through the same rounds. Lanes are independent so
+    // multiplies from different keys can be in flight at the same time.
+    // SSE2 has no 64-bit multiply so lanes are kept in scalar registers.
+    usize i = 0;
+    for( ; i + HASH_BATCH_LANES <= count; i += HASH_BATCH_LANES ) {
+        const char* lane[HASH_BATCH_LANES];
+        u64 h[HASH_BATCH_LANES];
+        for( usize l = 0; l < HASH_BATCH_LANES; ++l ) {
+            lane[l] = bytes + ((i + l) * key_size);
+            h[l]    = SEED ^ ( key_size * M );
+        }
+        internal_prefetch( bytes + ((i + HASH_BATCH_LANES * 2) * key_size) );
+
+        for( usize w = 0; w < words; ++w ) {
+            for( usize l = 0; l < HASH_BATCH_LANES; ++l ) {
+                u64 k = internal_hash_unaligned_load_64( lane[l] + (w * sizeof(u64)) );
+
+                k *= M;
+                k ^= k >> R;
+                k *= M;
+
+                h[l] ^= k;
+                h[l] *= M;
+            }
+        }
+
+        if( tail ) {
+            for( usize l = 0; l < HASH_BATCH_LANES; ++l ) {
+                const u8* data2 = (const u8*)(lane[l] + (words * sizeof(u64)));
+                u64 k = 0;
+                for( usize b = 0; b < tail; ++b ) {
+                    k |= (u64)(data2[b]) << (b * 8);
+                }
+                h[l] ^= k;
+                h[l] *= M;
+            }
+        }
+
+        for( usize l = 0; l < HASH_BATCH_LANES; ++l ) {
+            h[l] ^= h[l] >> R;
+            h[l] *= M;
+            h[l] ^= h[l] >> R;
+
+            out_hashes[i + l] = h[l];
+        }
+    }
+
+    for( ; i < count; ++i ) {
+        out_hashes[i] = hash_murmur2_64( key_size, bytes + (i * key_size) );
+    }
+
+    #undef SEED
+    #undef M
+    #undef R
+}
+
+#undef HASH_BATCH_PREFETCH_DISTANCE
+#undef HASH_BATCH_LANES
 
 #undef K0
 #undef K1
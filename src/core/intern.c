@@ -0,0 +1,277 @@
+/**
+ * @file   intern.c
+ * @brief  String interning implementation.
+ * @author Alicia Amarilla (smushyaa@gmail.com)
+ * @date   October 18, 2026
+*/
+#include "core/prelude.h"
+#include "core/intern.h"
+#include "core/hash.h"
+#include "core/alloc.h"
+#include "core/memory.h"
+#include "core/sync.h"
+
+#define INTERNER_INITIAL_SLOT_CAP  (64)
+#define INTERNER_INITIAL_ENTRY_CAP (32)
+
+struct InternBlock {
+    struct InternBlock* next;
+    usize               cap;
+    usize               len;
+};
+
+attr_always_inline inline attr_internal
+InternShard* internal_interner_shard( StringInterner* interner, hash64 hash ) {
+    return interner->shards + ((hash >> 32) & (CORE_INTERNER_SHARD_COUNT - 1));
+}
+attr_always_inline inline attr_internal
+InternHandle internal_interner_handle( u32 shard, u32 index ) {
+    return ((index + 1) * CORE_INTERNER_SHARD_COUNT) + shard;
+}
+attr_internal
+b32 internal_interner_search(
+    InternShard* shard, struct _StringPOD str, hash64 hash,
+    u32* out_slot, u32* out_index
+) {
+    if( !shard->slot_cap ) {
+        return false;
+    }
+    u32 mask = shard->slot_cap - 1;
+    u32 slot = (u32)hash & mask;
+    for( ;; ) {
+        u32 value = shard->slots[slot];
+        if( !value ) {
+            *out_slot = slot;
+            return false;
+        }
+        InternEntry* entry = shard->entries + (value - 1);
+        if( entry->hash == hash && string_cmp( entry->str, str ) ) {
+            *out_slot  = slot;
+            *out_index = value - 1;
+            return true;
+        }
+        slot = (slot + 1) & mask;
+    }
+}
+attr_internal
+b32 internal_interner_grow_slots(
+    StringInterner* interner, InternShard* shard
+) {
+    u32 new_cap = shard->slot_cap ? shard->slot_cap * 2 : INTERNER_INITIAL_SLOT_CAP;
+    u32* slots  = allocator_alloc( interner->allocator, sizeof(u32) * new_cap );
+    if( !slots ) {
+        return false;
+    }
+
+    u32 mask = new_cap - 1;
+    for( u32 i = 0; i < shard->len; ++i ) {
+        u32 slot = (u32)shard->entries[i].hash & mask;
+        while( slots[slot] ) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = i + 1;
+    }
+
+    if( shard->slots ) {
+        allocator_free(
+            interner->allocator, shard->slots, sizeof(u32) * shard->slot_cap );
+    }
+    shard->slots    = slots;
+    shard->slot_cap = new_cap;
+    return true;
+}
+attr_internal
+char* internal_interner_arena_push(
+    StringInterner* interner, InternShard* shard, usize size
+) {
+    struct InternBlock* block = shard->block;
+    if( block && (block->cap - block->len) >= size ) {
+        char* result = (char*)(block + 1) + block->len;
+        block->len  += size;
+        return result;
+    }
+
+    usize cap = size > interner->block_size ? size : interner->block_size;
+    struct InternBlock* new_block = allocator_alloc(
+        interner->allocator, sizeof(struct InternBlock) + cap );
+    if( !new_block ) {
+        return NULL;
+    }
+    new_block->cap = cap;
+    new_block->len = size;
+
+    // NOTE(alicia): oversized strings get their own block
+    // so that the current block can continue to be filled.
+    if( block && cap == size ) {
+        new_block->next = block->next;
+        block->next     = new_block;
+    } else {
+        new_block->next = block;
+        shard->block    = new_block;
+    }
+    return (char*)(new_block + 1);
+}
+
+attr_core_api
+void interner_init(
+    struct AllocatorInterface* allocator,
+    usize opt_block_size, StringInterner* out_interner
+) {
+    memory_zero( out_interner, sizeof(*out_interner) );
+    out_interner->allocator  = allocator;
+    out_interner->block_size =
+        opt_block_size ? opt_block_size : CORE_INTERNER_DEFAULT_BLOCK_SIZE;
+    for( usize i = 0; i < CORE_INTERNER_SHARD_COUNT; ++i ) {
+        mutex_init( &out_interner->shards[i].mtx );
+    }
+}
+attr_core_api
+void interner_free( StringInterner* interner ) {
+    for( usize i = 0; i < CORE_INTERNER_SHARD_COUNT; ++i ) {
+        InternShard* shard = interner->shards + i;
+
+        struct InternBlock* block = shard->block;
+        while( block ) {
+            struct InternBlock* next = block->next;
+            allocator_free(
+                interner->allocator, block, sizeof(struct InternBlock) + block->cap );
+            block = next;
+        }
+        if( shard->slots ) {
+            allocator_free(
+                interner->allocator, shard->slots, sizeof(u32) * shard->slot_cap );
+        }
+        if( shard->entries ) {
+            allocator_free(
+                interner->allocator, shard->entries, sizeof(InternEntry) * shard->cap );
+        }
+        memory_zero( shard, sizeof(*shard) );
+    }
+}
+attr_core_api
+b32 interner_intern(
+    StringInterner* interner, struct _StringPOD str,
+    InternHandle* opt_out_handle, struct _StringPOD* opt_out_string
+) {
+    hash64       hash  = hash_city_64( str.len, str.cbuf );
+    InternShard* shard = internal_interner_shard( interner, hash );
+    u32 shard_index    = (u32)(shard - interner->shards);
+
+    mutex_lock( &shard->mtx );
+
+    u32 slot = 0, index = 0;
+    if( internal_interner_search( shard, str, hash, &slot, &index ) ) {
+        if( opt_out_string ) {
+            *opt_out_string = shard->entries[index].str;
+        }
+        mutex_unlock( &shard->mtx );
+        if( opt_out_handle ) {
+            *opt_out_handle = internal_interner_handle( shard_index, index );
+        }
+        return true;
+    }
+
+    // NOTE(alicia): keep load factor under 3/4.
+    if( ((shard->len + 1) * 4) > (shard->slot_cap * 3) ) {
+        if( !internal_interner_grow_slots( interner, shard ) ) {
+            mutex_unlock( &shard->mtx );
+            return false;
+        }
+        internal_interner_search( shard, str, hash, &slot, &index );
+    }
+
+    if( shard->len == shard->cap ) {
+        u32 new_cap = shard->cap ? shard->cap * 2 : INTERNER_INITIAL_ENTRY_CAP;
+        void* entries = allocator_realloc(
+            interner->allocator, shard->entries,
+            sizeof(InternEntry) * shard->cap, sizeof(InternEntry) * new_cap );
+        if( !entries ) {
+            mutex_unlock( &shard->mtx );
+            return false;
+        }
+        shard->entries = entries;
+        shard->cap     = new_cap;
+    }
+
+    char* bytes = internal_interner_arena_push( interner, shard, str.len + 1 );
+    if( !bytes ) {
+        mutex_unlock( &shard->mtx );
+        return false;
+    }
+    memory_copy( bytes, str.cbuf, str.len );
+    bytes[str.len] = 0;
+
+    index = shard->len++;
+    InternEntry* entry = shard->entries + index;
+    entry->str   = string_new( str.len, bytes );
+    entry->hash  = hash;
+    shard->slots[slot] = index + 1;
+
+    mutex_unlock( &shard->mtx );
+
+    if( opt_out_handle ) {
+        *opt_out_handle = internal_interner_handle( shard_index, index );
+    }
+    if( opt_out_string ) {
+        *opt_out_string = string_new( str.len, bytes );
+    }
+    return true;
+}
+attr_core_api
+b32 interner_find(
+    StringInterner* interner, struct _StringPOD str,
+    InternHandle* opt_out_handle, struct _StringPOD* opt_out_string
+) {
+    hash64       hash  = hash_city_64( str.len, str.cbuf );
+    InternShard* shard = internal_interner_shard( interner, hash );
+
+    mutex_lock( &shard->mtx );
+
+    u32 slot = 0, index = 0;
+    b32 found = internal_interner_search( shard, str, hash, &slot, &index );
+    if( found && opt_out_string ) {
+        *opt_out_string = shard->entries[index].str;
+    }
+
+    mutex_unlock( &shard->mtx );
+
+    if( found && opt_out_handle ) {
+        *opt_out_handle = internal_interner_handle(
+            (u32)(shard - interner->shards), index );
+    }
+    return found;
+}
+attr_core_api
+struct _StringPOD interner_query_string(
+    StringInterner* interner, InternHandle handle
+) {
+    if( handle < CORE_INTERNER_SHARD_COUNT ) {
+        return string_empty();
+    }
+    InternShard* shard = interner->shards + (handle % CORE_INTERNER_SHARD_COUNT);
+    u32 index          = (handle / CORE_INTERNER_SHARD_COUNT) - 1;
+
+    struct _StringPOD result = string_empty();
+
+    mutex_lock( &shard->mtx );
+    if( index < shard->len ) {
+        result = shard->entries[index].str;
+    }
+    mutex_unlock( &shard->mtx );
+
+    return result;
+}
+attr_core_api
+usize interner_query_count( StringInterner* interner ) {
+    usize result = 0;
+    for( usize i = 0; i < CORE_INTERNER_SHARD_COUNT; ++i ) {
+        InternShard* shard = interner->shards + i;
+        mutex_lock( &shard->mtx );
+        result += shard->len;
+        mutex_unlock( &shard->mtx );
+    }
+    return result;
+}
+
+#undef INTERNER_INITIAL_SLOT_CAP
+#undef INTERNER_INITIAL_ENTRY_CAP
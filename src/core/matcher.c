@@ -0,0 +1,435 @@
+/**
+ * @file   matcher.c
+ * @brief  Multi-pattern string matching implementation.
+ * @author Alicia Amarilla (smushyaa@gmail.com)
+ * @date   October 18, 2026
+*/
+#include "core/prelude.h"
+#include "core/matcher.h"
+#include "core/alloc.h"
+#include "core/memory.h"
+
+#define MATCHER_MIN_HISTORY (256)
+
+attr_internal
+usize internal_matcher_memory_size(
+    usize state_count, usize class_count, usize pattern_count
+) {
+    return
+        (sizeof(u32) * state_count * class_count) +
+        (sizeof(MultiMatcherState) * state_count) +
+        (sizeof(u32) * pattern_count * 2);
+}
+attr_always_inline inline attr_internal
+b32 internal_matcher_report( MultiMatcherStream* stream, const MultiMatch* match ) {
+    stream->match_count++;
+    if( !stream->callback( match, stream->params ) ) {
+        stream->stopped = true;
+        return false;
+    }
+    return true;
+}
+attr_always_inline inline attr_internal
+usize internal_matcher_skip(
+    const MultiMatcher* matcher, const u8* data, usize pos, usize end
+) {
+    usize skip = 0;
+    if( !string_find_byte_set( string_new( end - pos, data ), &matcher->start_set, &skip ) ) {
+        return end;
+    }
+    return pos + skip;
+}
+/// @brief Run automaton over bytes [cursor, end), byte at pos is data[(pos - base) & mask].
+attr_internal
+void internal_matcher_run_all(
+    MultiMatcherStream* stream, const u8* data, usize base, usize mask, usize end
+) {
+    const MultiMatcher*      matcher     = stream->matcher;
+    const u32*               transitions = matcher->transitions;
+    const MultiMatcherState* states      = matcher->states;
+    u32 class_count = matcher->class_count;
+
+    // NOTE(alicia): prefilter needs contiguous bytes.
+    b32 prefilter = (mask == USIZE_MAX) &&
+        matcher->start_set.count && (matcher->start_set.count <= BYTE_SET_SIMD_MAX);
+
+    u32   state = stream->state;
+    usize pos   = stream->cursor;
+    while( pos < end ) {
+        if( prefilter && !state ) {
+            pos = internal_matcher_skip( matcher, data + (pos - base), pos, end );
+            if( pos == end ) {
+                break;
+            }
+        }
+        state = transitions[
+            (state * class_count) + matcher->byte_class[data[(pos - base) & mask]] ];
+        pos++;
+
+        u32 output = states[state].pattern ? state : states[state].dictionary;
+        while( output ) {
+            for( u32 p = states[output].pattern; p; p = matcher->pattern_next[p - 1] ) {
+                MultiMatch match;
+                match.pattern = p - 1;
+                match.len     = matcher->pattern_len[p - 1];
+                match.start   = pos - match.len;
+                if( !internal_matcher_report( stream, &match ) ) {
+                    stream->state  = state;
+                    stream->cursor = pos;
+                    return;
+                }
+            }
+            output = states[output].dictionary;
+        }
+    }
+    stream->state  = state;
+    stream->cursor = end;
+}
+/// @brief Report leftmost-longest candidate and restart automaton after it.
+attr_always_inline inline attr_internal
+b32 internal_matcher_commit( MultiMatcherStream* stream ) {
+    stream->has_best = false;
+    stream->state    = 0;
+    stream->cursor   = stream->best.start + stream->best.len;
+    return internal_matcher_report( stream, &stream->best );
+}
+/// @brief Run automaton over bytes [cursor, end), byte at pos is data[(pos - base) & mask].
+attr_internal
+void internal_matcher_run_leftmost_longest(
+    MultiMatcherStream* stream, const u8* data, usize base, usize mask, usize end
+) {
+    const MultiMatcher*      matcher     = stream->matcher;
+    const u32*               transitions = matcher->transitions;
+    const MultiMatcherState* states      = matcher->states;
+    u32 class_count = matcher->class_count;
+
+    b32 prefilter = (mask == USIZE_MAX) &&
+        matcher->start_set.count && (matcher->start_set.count <= BYTE_SET_SIMD_MAX);
+
+    u32   state = stream->state;
+    usize pos   = stream->cursor;
+    while( pos < end ) {
+        if( prefilter && !state && !stream->has_best ) {
+            pos = internal_matcher_skip( matcher, data + (pos - base), pos, end );
+            if( pos == end ) {
+                break;
+            }
+        }
+        state = transitions[
+            (state * class_count) + matcher->byte_class[data[(pos - base) & mask]] ];
+        pos++;
+
+        // NOTE(alicia): outputs along dictionary links get shorter,
+        // first output is longest and therefore leftmost match ending here.
+        u32 output = states[state].pattern ? state : states[state].dictionary;
+        if( output ) {
+            u32   pattern = states[output].pattern - 1;
+            usize len     = matcher->pattern_len[pattern];
+            usize start   = pos - len;
+            if(
+                !stream->has_best ||
+                start < stream->best.start ||
+                (start == stream->best.start && len > stream->best.len)
+            ) {
+                stream->has_best     = true;
+                stream->best.pattern = pattern;
+                stream->best.start   = start;
+                stream->best.len     = len;
+            }
+        }
+
+        // NOTE(alicia): once every partial match starts after candidate,
+        // nothing can start at or before it so it is final.
+        if( stream->has_best && (pos - states[state].depth) > stream->best.start ) {
+            if( !internal_matcher_commit( stream ) ) {
+                return;
+            }
+            state = 0;
+            pos   = stream->cursor;
+        }
+    }
+    stream->state  = state;
+    stream->cursor = end;
+}
+attr_internal
+void internal_matcher_flush(
+    MultiMatcherStream* stream, const u8* data, usize base, usize mask, usize end
+) {
+    while( stream->has_best && !stream->stopped ) {
+        if( !internal_matcher_commit( stream ) ) {
+            return;
+        }
+        internal_matcher_run_leftmost_longest( stream, data, base, mask, end );
+    }
+}
+
+attr_core_api
+b32 multi_matcher_create(
+    struct AllocatorInterface* allocator, usize pattern_count,
+    const struct _StringPOD* patterns, MultiMatcher* out_matcher
+) {
+    memory_zero( out_matcher, sizeof(*out_matcher) );
+
+    // NOTE(alicia): bytes that appear in patterns get their own column,
+    // every other byte shares column zero which always leads back to root
+    // unless a shorter suffix matches.
+    usize total = 1;
+    for( usize i = 0; i < pattern_count; ++i ) {
+        struct _StringPOD pattern = patterns[i];
+        for( usize j = 0; j < pattern.len; ++j ) {
+            out_matcher->byte_class[pattern.bytes[j]] = 1;
+        }
+        if( pattern.len ) {
+            byte_set_insert( &out_matcher->start_set, pattern.bytes[0] );
+        }
+        if( pattern.len > out_matcher->max_len ) {
+            out_matcher->max_len = pattern.len;
+        }
+        total += pattern.len;
+    }
+    if( total > U32_MAX ) {
+        return false;
+    }
+
+    u32 class_count = 1;
+    for( usize i = 0; i < 256; ++i ) {
+        if( out_matcher->byte_class[i] ) {
+            out_matcher->byte_class[i] = (u16)class_count++;
+        }
+    }
+
+    // NOTE(alicia): build trie with upper bound on state count
+    // then copy into exact sized tables.
+    usize scratch_size =
+        internal_matcher_memory_size( total, class_count, pattern_count ) +
+        (sizeof(u32) * total * 2);
+    u8* scratch = allocator_alloc( allocator, scratch_size );
+    if( !scratch ) {
+        return false;
+    }
+    u32*               transitions  = (u32*)scratch;
+    MultiMatcherState* states       = (MultiMatcherState*)(transitions + (total * class_count));
+    u32*               pattern_len  = (u32*)(states + total);
+    u32*               pattern_next = pattern_len + pattern_count;
+    u32*               fail         = pattern_next + pattern_count;
+    u32*               queue        = fail + total;
+
+    // NOTE(alicia): insert in reverse so that duplicate patterns
+    // are chained from lowest index.
+    u32 state_count = 1;
+    for( usize i = pattern_count; i-- > 0; ) {
+        struct _StringPOD pattern = patterns[i];
+        pattern_len[i] = (u32)pattern.len;
+        if( !pattern.len ) {
+            continue;
+        }
+
+        u32 state = 0;
+        for( usize j = 0; j < pattern.len; ++j ) {
+            u32* next = transitions +
+                (state * class_count) + out_matcher->byte_class[pattern.bytes[j]];
+            if( !*next ) {
+                *next = state_count;
+                states[state_count].depth = states[state].depth + 1;
+                state_count++;
+            }
+            state = *next;
+        }
+        pattern_next[i]       = states[state].pattern;
+        states[state].pattern = (u32)i + 1;
+    }
+
+    // NOTE(alicia): breadth first so that failure state of each state
+    // already has a complete row when state is reached.
+    u32 head = 0, tail = 0;
+    for( u32 c = 0; c < class_count; ++c ) {
+        u32 child = transitions[c];
+        if( child ) {
+            fail[child]   = 0;
+            queue[tail++] = child;
+        }
+    }
+    while( head < tail ) {
+        u32  state = queue[head++];
+        u32* row   = transitions + (state * class_count);
+        u32* fail_row = transitions + (fail[state] * class_count);
+        for( u32 c = 0; c < class_count; ++c ) {
+            u32 child = row[c];
+            if( child ) {
+                u32 link    = fail_row[c];
+                fail[child] = link;
+                states[child].dictionary =
+                    states[link].pattern ? link : states[link].dictionary;
+                queue[tail++] = child;
+            } else {
+                row[c] = fail_row[c];
+            }
+        }
+    }
+
+    usize memory_size = internal_matcher_memory_size( state_count, class_count, pattern_count );
+    u8*   memory      = allocator_alloc( allocator, memory_size );
+    if( !memory ) {
+        allocator_free( allocator, scratch, scratch_size );
+        return false;
+    }
+
+    out_matcher->pattern_count = pattern_count;
+    out_matcher->state_count   = state_count;
+    out_matcher->class_count   = class_count;
+    out_matcher->memory_size   = memory_size;
+
+    out_matcher->transitions  = (u32*)memory;
+    out_matcher->states       =
+        (MultiMatcherState*)(out_matcher->transitions + (state_count * class_count));
+    out_matcher->pattern_len  = (u32*)(out_matcher->states + state_count);
+    out_matcher->pattern_next = out_matcher->pattern_len + pattern_count;
+
+    memory_copy(
+        out_matcher->transitions, transitions,
+        sizeof(u32) * state_count * class_count );
+    memory_copy(
+        out_matcher->states, states, sizeof(MultiMatcherState) * state_count );
+    memory_copy(
+        out_matcher->pattern_len, pattern_len, sizeof(u32) * pattern_count * 2 );
+
+    allocator_free( allocator, scratch, scratch_size );
+    return true;
+}
+attr_core_api
+void multi_matcher_free(
+    struct AllocatorInterface* allocator, MultiMatcher* matcher
+) {
+    if( matcher->transitions ) {
+        allocator_free( allocator, matcher->transitions, matcher->memory_size );
+    }
+    memory_zero( matcher, sizeof(*matcher) );
+}
+attr_core_api
+usize multi_matcher_find(
+    const MultiMatcher* matcher, MultiMatchKind kind, struct _StringPOD str,
+    MultiMatchFN* callback, void* opt_params
+) {
+    MultiMatcherStream stream;
+    memory_zero( &stream, sizeof(stream) );
+    stream.matcher  = matcher;
+    stream.kind     = kind;
+    stream.callback = callback;
+    stream.params   = opt_params;
+    stream.offset   = str.len;
+
+    switch( kind ) {
+        case MULTI_MATCH_ALL: {
+            internal_matcher_run_all( &stream, str.bytes, 0, USIZE_MAX, str.len );
+        } break;
+        case MULTI_MATCH_LEFTMOST_LONGEST: {
+            internal_matcher_run_leftmost_longest( &stream, str.bytes, 0, USIZE_MAX, str.len );
+            internal_matcher_flush( &stream, str.bytes, 0, USIZE_MAX, str.len );
+        } break;
+    }
+    return stream.match_count;
+}
+attr_internal
+b32 internal_matcher_find_first_callback( const MultiMatch* match, void* params ) {
+    *(MultiMatch*)params = *match;
+    return false;
+}
+attr_core_api
+b32 multi_matcher_find_first(
+    const MultiMatcher* matcher, struct _StringPOD str, MultiMatch* opt_out_match
+) {
+    MultiMatch match;
+    usize count = multi_matcher_find(
+        matcher, MULTI_MATCH_ALL, str, internal_matcher_find_first_callback, &match );
+    if( count && opt_out_match ) {
+        *opt_out_match = match;
+    }
+    return count != 0;
+}
+
+attr_core_api
+b32 multi_matcher_stream_init(
+    struct AllocatorInterface* allocator, const MultiMatcher* matcher,
+    MultiMatchKind kind, MultiMatchFN* callback, void* opt_params,
+    MultiMatcherStream* out_stream
+) {
+    memory_zero( out_stream, sizeof(*out_stream) );
+    out_stream->matcher  = matcher;
+    out_stream->kind     = kind;
+    out_stream->callback = callback;
+    out_stream->params   = opt_params;
+
+    if( kind != MULTI_MATCH_LEFTMOST_LONGEST ) {
+        return true;
+    }
+
+    // NOTE(alicia): candidate can be rescanned from up to max_len
+    // bytes before end of last chunk so history keeps at least that
+    // many bytes and new chunks fill the rest.
+    usize cap = MATCHER_MIN_HISTORY;
+    while( cap < (matcher->max_len * 2) ) {
+        cap <<= 1;
+    }
+    out_stream->history = allocator_alloc( allocator, cap );
+    if( !out_stream->history ) {
+        return false;
+    }
+    out_stream->history_cap = cap;
+    return true;
+}
+attr_core_api
+void multi_matcher_stream_free(
+    struct AllocatorInterface* allocator, MultiMatcherStream* stream
+) {
+    if( stream->history ) {
+        allocator_free( allocator, stream->history, stream->history_cap );
+    }
+    memory_zero( stream, sizeof(*stream) );
+}
+attr_core_api
+usize multi_matcher_stream_write( void* target, usize count, const void* bytes ) {
+    MultiMatcherStream* stream = target;
+    const u8*           chunk  = bytes;
+    if( stream->stopped ) {
+        return 0;
+    }
+
+    if( stream->kind != MULTI_MATCH_LEFTMOST_LONGEST ) {
+        internal_matcher_run_all(
+            stream, chunk, stream->offset, USIZE_MAX, stream->offset + count );
+        stream->offset += count;
+        return 0;
+    }
+
+    usize mask  = stream->history_cap - 1;
+    usize piece = stream->history_cap - stream->matcher->max_len;
+    while( count && !stream->stopped ) {
+        usize len   = count < piece ? count : piece;
+        usize at    = stream->offset & mask;
+        usize first = stream->history_cap - at;
+        if( first > len ) {
+            first = len;
+        }
+        memory_copy( stream->history + at, chunk, first );
+        memory_copy( stream->history, chunk + first, len - first );
+
+        stream->offset += len;
+        internal_matcher_run_leftmost_longest(
+            stream, stream->history, 0, mask, stream->offset );
+
+        chunk += len;
+        count -= len;
+    }
+    return 0;
+}
+attr_core_api
+usize multi_matcher_stream_finish( MultiMatcherStream* stream ) {
+    if( stream->kind == MULTI_MATCH_LEFTMOST_LONGEST ) {
+        internal_matcher_flush(
+            stream, stream->history, 0, stream->history_cap - 1, stream->offset );
+    }
+    stream->stopped = true;
+    return stream->match_count;
+}
+
+#undef MATCHER_MIN_HISTORY
@@ -61,6 +61,7 @@ b32 posix_thread_join_timed( ThreadHandle* handle, u32 ms, int* opt_out_exit_cod
         }
         return false;
     }
+    handle->opaque.handle = NULL;
 
     if( opt_out_exit_code ) {
         *opt_out_exit_code = (int)(isize)ret_code;
@@ -324,13 +324,18 @@ void platform_thread_destroy( ThreadHandle* handle ) {
     memory_zero( handle, sizeof(*handle) );
 }
 void platform_thread_free( ThreadHandle* handle ) {
-    pthread_detach( (pthread_t)handle->opaque.handle );
+    // NOTE(alicia): handle is cleared when thread is joined,
+    // detaching a joined thread is undefined.
+    if( handle->opaque.handle ) {
+        pthread_detach( (pthread_t)handle->opaque.handle );
+    }
     memory_zero( handle, sizeof(*handle) );
 }
 void posix_thread_join( ThreadHandle* handle, int* opt_out_exit_code ) {
     // TODO(alicia): handle error?
     void* ret_code = 0;
     pthread_join( (pthread_t)handle->opaque.handle, &ret_code );
+    handle->opaque.handle = NULL;
 
     read_write_barrier();
 
@@ -346,6 +351,7 @@ b32 posix_thread_join_timed( ThreadHandle* handle, u32 ms, int* opt_out_exit_cod
 
     void* ret_code = 0;
     pthread_join( (pthread_t)handle->opaque.handle, &ret_code );
+    handle->opaque.handle = NULL;
     read_write_barrier();
 
     if( opt_out_exit_code ) {
@@ -373,6 +379,7 @@ b32 platform_thread_exit_code( ThreadHandle* handle, int* out_exit_code ) {
 
     void* ret_code = 0;
     pthread_join( (pthread_t)handle->opaque.handle, &ret_code );
+    handle->opaque.handle = NULL;
 
     *out_exit_code = (int)(isize)ret_code;
     return true;
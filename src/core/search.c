@@ -0,0 +1,374 @@
+/**
+ * @file   search.c
+ * @brief  Searching algorithm implementations.
+ * @author Alicia Amarilla (smushyaa@gmail.com)
+ * @date   October 18, 2026
+*/
+#include "core/prelude.h"
+#include "core/search.h"
+#include "core/memory.h"
+#include "core/internal/bits.h"
+
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+    #include "core/internal/sse.h" // IWYU pragma: keep
+#endif
+
+/// @brief Size of one prefetched cache line in bytes.
+/// @details
+/// Eytzinger search prefetches item k * (EYTZINGER_PREFETCH_BYTES / item size),
+/// the cache line that holds all descendants of node k several levels down.
+#define EYTZINGER_PREFETCH_BYTES (64)
+
+attr_core_api
+usize lower_bound_i32( usize len, const i32* buffer, i32 value ) {
+    if( !len ) {
+        return 0;
+    }
+    const i32* base = buffer;
+    usize n = len;
+    while( n > 1 ) {
+        usize half = n / 2;
+        base  = (base[half - 1] < value) ? base + half : base;
+        n    -= half;
+    }
+    return (usize)(base - buffer) + (*base < value);
+}
+attr_core_api
+usize upper_bound_i32( usize len, const i32* buffer, i32 value ) {
+    if( !len ) {
+        return 0;
+    }
+    const i32* base = buffer;
+    usize n = len;
+    while( n > 1 ) {
+        usize half = n / 2;
+        base  = (value < base[half - 1]) ? base : base + half;
+        n    -= half;
+    }
+    return (usize)(base - buffer) + !(value < *base);
+}
+attr_core_api
+usize eytzinger_lower_bound_i32( usize len, const i32* tree, i32 value ) {
+    usize k = 1;
+    while( k <= len ) {
+        internal_prefetch( tree + (k * (EYTZINGER_PREFETCH_BYTES / sizeof(i32))) - 1 );
+        k = (2 * k) + (tree[k - 1] < value);
+    }
+    // NOTE(alicia): every right turn shifted in a 1,
+    // strip them and the last left turn to get the answer.
+    k >>= internal_bits_ctz64( ~(u64)k ) + 1;
+    return k ? k - 1 : len;
+}
+attr_core_api
+usize lower_bound_u32( usize len, const u32* buffer, u32 value ) {
+    if( !len ) {
+        return 0;
+    }
+    const u32* base = buffer;
+    usize n = len;
+    while( n > 1 ) {
+        usize half = n / 2;
+        base  = (base[half - 1] < value) ? base + half : base;
+        n    -= half;
+    }
+    return (usize)(base - buffer) + (*base < value);
+}
+attr_core_api
+usize upper_bound_u32( usize len, const u32* buffer, u32 value ) {
+    if( !len ) {
+        return 0;
+    }
+    const u32* base = buffer;
+    usize n = len;
+    while( n > 1 ) {
+        usize half = n / 2;
+        base  = (value < base[half - 1]) ? base : base + half;
+        n    -= half;
+    }
+    return (usize)(base - buffer) + !(value < *base);
+}
+attr_core_api
+usize eytzinger_lower_bound_u32( usize len, const u32* tree, u32 value ) {
+    usize k = 1;
+    while( k <= len ) {
+        internal_prefetch( tree + (k * (EYTZINGER_PREFETCH_BYTES / sizeof(u32))) - 1 );
+        k = (2 * k) + (tree[k - 1] < value);
+    }
+    // NOTE(alicia): every right turn shifted in a 1,
+    // strip them and the last left turn to get the answer.
+    k >>= internal_bits_ctz64( ~(u64)k ) + 1;
+    return k ? k - 1 : len;
+}
+attr_core_api
+usize lower_bound_f32( usize len, const f32* buffer, f32 value ) {
+    if( !len ) {
+        return 0;
+    }
+    const f32* base = buffer;
+    usize n = len;
+    while( n > 1 ) {
+        usize half = n / 2;
+        base  = (base[half - 1] < value) ? base + half : base;
+        n    -= half;
+    }
+    return (usize)(base - buffer) + (*base < value);
+}
+attr_core_api
+usize upper_bound_f32( usize len, const f32* buffer, f32 value ) {
+    if( !len ) {
+        return 0;
+    }
+    const f32* base = buffer;
+    usize n = len;
+    while( n > 1 ) {
+        usize half = n / 2;
+        base  = (value < base[half - 1]) ? base : base + half;
+        n    -= half;
+    }
+    return (usize)(base - buffer) + !(value < *base);
+}
+attr_core_api
+usize eytzinger_lower_bound_f32( usize len, const f32* tree, f32 value ) {
+    usize k = 1;
+    while( k <= len ) {
+        internal_prefetch( tree + (k * (EYTZINGER_PREFETCH_BYTES / sizeof(f32))) - 1 );
+        k = (2 * k) + (tree[k - 1] < value);
+    }
+    // NOTE(alicia): every right turn shifted in a 1,
+    // strip them and the last left turn to get the answer.
+    k >>= internal_bits_ctz64( ~(u64)k ) + 1;
+    return k ? k - 1 : len;
+}
+attr_core_api
+usize lower_bound_u64( usize len, const u64* buffer, u64 value ) {
+    if( !len ) {
+        return 0;
+    }
+    const u64* base = buffer;
+    usize n = len;
+    while( n > 1 ) {
+        usize half = n / 2;
+        base  = (base[half - 1] < value) ? base + half : base;
+        n    -= half;
+    }
+    return (usize)(base - buffer) + (*base < value);
+}
+attr_core_api
+usize upper_bound_u64( usize len, const u64* buffer, u64 value ) {
+    if( !len ) {
+        return 0;
+    }
+    const u64* base = buffer;
+    usize n = len;
+    while( n > 1 ) {
+        usize half = n / 2;
+        base  = (value < base[half - 1]) ? base : base + half;
+        n    -= half;
+    }
+    return (usize)(base - buffer) + !(value < *base);
+}
+attr_core_api
+usize eytzinger_lower_bound_u64( usize len, const u64* tree, u64 value ) {
+    usize k = 1;
+    while( k <= len ) {
+        internal_prefetch( tree + (k * (EYTZINGER_PREFETCH_BYTES / sizeof(u64))) - 1 );
+        k = (2 * k) + (tree[k - 1] < value);
+    }
+    // NOTE(alicia): every right turn shifted in a 1,
+    // strip them and the last left turn to get the answer.
+    k >>= internal_bits_ctz64( ~(u64)k ) + 1;
+    return k ? k - 1 : len;
+}
+
+attr_core_api
+usize linear_search_i32( usize len, const i32* buffer, i32 value ) {
+    return linear_search_u32( len, (const u32*)buffer, (u32)value );
+}
+attr_core_api
+usize linear_search_u32( usize len, const u32* buffer, u32 value ) {
+    usize i = 0;
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+    __m128i needle = _mm_set1_epi32( (int)value );
+    for( ; (i + 8) <= len; i += 8 ) {
+        __m128i a = _mm_cmpeq_epi32(
+            _mm_loadu_si128( (const __m128i*)(buffer + i) ), needle );
+        __m128i b = _mm_cmpeq_epi32(
+            _mm_loadu_si128( (const __m128i*)(buffer + i + 4) ), needle );
+        u32 mask =
+            (u32)_mm_movemask_ps( _mm_castsi128_ps( a ) ) |
+            ((u32)_mm_movemask_ps( _mm_castsi128_ps( b ) ) << 4);
+        if( mask ) {
+            return i + internal_bits_ctz32( mask );
+        }
+    }
+#endif
+    for( ; i < len; ++i ) {
+        if( buffer[i] == value ) {
+            return i;
+        }
+    }
+    return len;
+}
+attr_core_api
+usize linear_search_f32( usize len, const f32* buffer, f32 value ) {
+    usize i = 0;
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+    __m128 needle = _mm_set1_ps( value );
+    for( ; (i + 8) <= len; i += 8 ) {
+        __m128 a = _mm_cmpeq_ps( _mm_loadu_ps( buffer + i ), needle );
+        __m128 b = _mm_cmpeq_ps( _mm_loadu_ps( buffer + i + 4 ), needle );
+        u32 mask = (u32)_mm_movemask_ps( a ) | ((u32)_mm_movemask_ps( b ) << 4);
+        if( mask ) {
+            return i + internal_bits_ctz32( mask );
+        }
+    }
+#endif
+    for( ; i < len; ++i ) {
+        if( buffer[i] == value ) {
+            return i;
+        }
+    }
+    return len;
+}
+attr_core_api
+usize linear_search_u64( usize len, const u64* buffer, u64 value ) {
+    usize i = 0;
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+    // NOTE(alicia): SSE2 has no 64-bit compare,
+    // 64-bit lanes are equal when both 32-bit halves are equal.
+    __m128i needle = _mm_set1_epi64x( (long long)value );
+    for( ; (i + 4) <= len; i += 4 ) {
+        __m128i a = _mm_cmpeq_epi32(
+            _mm_loadu_si128( (const __m128i*)(buffer + i) ), needle );
+        __m128i b = _mm_cmpeq_epi32(
+            _mm_loadu_si128( (const __m128i*)(buffer + i + 2) ), needle );
+        a = _mm_and_si128( a, _mm_shuffle_epi32( a, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+        b = _mm_and_si128( b, _mm_shuffle_epi32( b, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+        u32 mask =
+            (u32)_mm_movemask_pd( _mm_castsi128_pd( a ) ) |
+            ((u32)_mm_movemask_pd( _mm_castsi128_pd( b ) ) << 2);
+        if( mask ) {
+            return i + internal_bits_ctz32( mask );
+        }
+    }
+#endif
+    for( ; i < len; ++i ) {
+        if( buffer[i] == value ) {
+            return i;
+        }
+    }
+    return len;
+}
+
+#define SEARCH_AT( index ) ((void*)(bytes + ((index) * stride)))
+
+attr_core_api
+usize lower_bound_generic(
+    usize len, usize stride, const void* buffer, const void* value,
+    SortCmpFN* cmp_fn, void* opt_cmp_params
+) {
+    if( !len ) {
+        return 0;
+    }
+    const u8* bytes = buffer;
+    usize base = 0, n = len;
+    while( n > 1 ) {
+        usize half = n / 2;
+        base += cmp_fn(
+            SEARCH_AT( base + half - 1 ), (void*)value,
+            stride, opt_cmp_params ) ? half : 0;
+        n    -= half;
+    }
+    return base + (cmp_fn( SEARCH_AT( base ), (void*)value, stride, opt_cmp_params ) ? 1 : 0);
+}
+attr_core_api
+usize upper_bound_generic(
+    usize len, usize stride, const void* buffer, const void* value,
+    SortCmpFN* cmp_fn, void* opt_cmp_params
+) {
+    if( !len ) {
+        return 0;
+    }
+    const u8* bytes = buffer;
+    usize base = 0, n = len;
+    while( n > 1 ) {
+        usize half = n / 2;
+        base += cmp_fn(
+            (void*)value, SEARCH_AT( base + half - 1 ),
+            stride, opt_cmp_params ) ? 0 : half;
+        n    -= half;
+    }
+    return base + (cmp_fn( (void*)value, SEARCH_AT( base ), stride, opt_cmp_params ) ? 0 : 1);
+}
+attr_core_api
+b32 ordered_binary_search_generic(
+    usize len, usize stride, const void* buffer, const void* value,
+    SortCmpFN* cmp_fn, void* opt_cmp_params, usize* opt_out_index
+) {
+    const u8* bytes = buffer;
+    usize index = lower_bound_generic(
+        len, stride, buffer, value, cmp_fn, opt_cmp_params );
+    if(
+        index < len &&
+        !cmp_fn( (void*)value, SEARCH_AT( index ), stride, opt_cmp_params )
+    ) {
+        if( opt_out_index ) {
+            *opt_out_index = index;
+        }
+        return true;
+    }
+    return false;
+}
+attr_core_api
+usize linear_search_generic(
+    usize len, usize stride, const void* buffer, const void* value,
+    SearchCmpFN* cmp_fn, void* opt_cmp_params
+) {
+    const u8* bytes = buffer;
+    for( usize i = 0; i < len; ++i ) {
+        if( cmp_fn( SEARCH_AT( i ), (void*)value, stride, opt_cmp_params ) ) {
+            return i;
+        }
+    }
+    return len;
+}
+attr_core_api
+usize eytzinger_lower_bound_generic(
+    usize len, usize stride, const void* tree, const void* value,
+    SortCmpFN* cmp_fn, void* opt_cmp_params
+) {
+    const u8* bytes  = tree;
+    usize     ahead = stride < EYTZINGER_PREFETCH_BYTES ?
+        EYTZINGER_PREFETCH_BYTES / stride : 1;
+    usize k = 1;
+    while( k <= len ) {
+        internal_prefetch( bytes + (((k * ahead) - 1) * stride) );
+        k = (2 * k) + (cmp_fn( SEARCH_AT( k - 1 ), (void*)value, stride, opt_cmp_params ) ? 1 : 0);
+    }
+    k >>= internal_bits_ctz64( ~(u64)k ) + 1;
+    return k ? k - 1 : len;
+}
+
+attr_internal
+usize internal_eytzinger_fill(
+    usize len, usize stride, const u8* sorted,
+    u8* out_tree, usize source, usize k
+) {
+    // NOTE(alicia): in-order traversal of tree visits items in sorted order.
+    // depth is bounded by log2(len) so recursion is fine.
+    if( k <= len ) {
+        source = internal_eytzinger_fill( len, stride, sorted, out_tree, source, 2 * k );
+        memory_copy( out_tree + ((k - 1) * stride), sorted + (source * stride), stride );
+        source = internal_eytzinger_fill( len, stride, sorted, out_tree, source + 1, (2 * k) + 1 );
+    }
+    return source;
+}
+attr_core_api
+void eytzinger_from_sorted(
+    usize len, usize stride, const void* sorted, void* out_tree
+) {
+    internal_eytzinger_fill( len, stride, sorted, out_tree, 0, 1 );
+}
+
+#undef SEARCH_AT
+#undef EYTZINGER_PREFETCH_BYTES
@@ -6,217 +6,984 @@
 #include "core/prelude.h"
 #include "core/sort.h"
 #include "core/memory.h"
+#include "core/alloc.h"
+#include "core/thread.h"
+#include "core/system.h"
+#include "core/sync.h"
+#include "core/internal/bits.h"
 
-attr_internal
-isize quicksort_partition_i32(
-    isize low, isize high, i32* buffer, b32 reverse
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+    #include "core/internal/sse.h" // IWYU pragma: keep
+#endif
+
+/// @brief Ranges at or below this length are sorted with insertion sort or sorting network.
+#define SORT_INSERTION_THRESHOLD (16)
+/// @brief Ranges above this length use ninther for pivot selection.
+#define SORT_NINTHER_THRESHOLD   (128)
+
+#define RADIX_DIGIT_BITS  (11)
+#define RADIX_DIGIT_COUNT (1 << RADIX_DIGIT_BITS)
+#define RADIX_DIGIT_MASK  (RADIX_DIGIT_COUNT - 1)
+#define RADIX_PASSES_32   (3)
+#define RADIX_PASSES_64   (6)
+
+/// @brief Minimum number of items each parallel sort thread gets.
+#define PARALLEL_SORT_MIN_CHUNK (32768)
+
+/// @brief Merge sort ranges below this length are sorted with binary insertion sort.
+#define MERGE_SORT_MIN_MERGE (64)
+/// @brief Maximum number of pending runs in merge sort.
+#define MERGE_SORT_MAX_RUNS  (96)
+
+attr_always_inline inline attr_internal
+void internal_sort_copy( void* dst, const void* src, usize size ) {
+    switch( size ) {
+        case 4: {
+            *(u32*)dst = *(const u32*)src;
+        } break;
+        case 8: {
+            *(u64*)dst = *(const u64*)src;
+        } break;
+        case 16: {
+            ((u64*)dst)[0] = ((const u64*)src)[0];
+            ((u64*)dst)[1] = ((const u64*)src)[1];
+        } break;
+        default: {
+            memory_copy( dst, src, size );
+        } break;
+    }
+}
+attr_always_inline inline attr_internal
+void internal_sort_swap(
+    void* a, void* b, void* swap_buffer, usize size
 ) {
-    i32* pivot = buffer + high;
+    // NOTE(alicia): common strides are swapped in registers,
+    // swap_buffer is only used for other sizes.
+    switch( size ) {
+        case 4: {
+            u32 temp    = *(u32*)a;
+            *(u32*)a    = *(u32*)b;
+            *(u32*)b    = temp;
+        } break;
+        case 8: {
+            u64 temp    = *(u64*)a;
+            *(u64*)a    = *(u64*)b;
+            *(u64*)b    = temp;
+        } break;
+        case 16: {
+            u64 temp0   = ((u64*)a)[0];
+            u64 temp1   = ((u64*)a)[1];
+            ((u64*)a)[0] = ((u64*)b)[0];
+            ((u64*)a)[1] = ((u64*)b)[1];
+            ((u64*)b)[0] = temp0;
+            ((u64*)b)[1] = temp1;
+        } break;
+        default: {
+            memory_copy( swap_buffer, a, size );
+            memory_copy( a, b, size );
+            memory_copy( b, swap_buffer, size );
+        } break;
+    }
+}
+/// @brief Calculate how many times introsort can partition before falling back to heapsort.
+attr_always_inline inline attr_internal
+usize internal_sort_depth_limit( isize len ) {
+    usize depth = 0;
+    while( len > 1 ) {
+        len >>= 1;
+        depth++;
+    }
+    return depth * 2;
+}
+
+enum InternalRadixKey {
+    INTERNAL_RADIX_KEY_UNSIGNED,
+    INTERNAL_RADIX_KEY_SIGNED,
+    INTERNAL_RADIX_KEY_FLOAT,
+};
 
-    isize i = low - 1;
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
 
-    for( isize j = low; j <= high - 1; ++j ) {
-        i32* at_j = buffer + j;
+// NOTE(alicia): sorting networks work on signed 32-bit keys,
+// u32 and f32 are mapped to keys that sort the same way as signed integers.
+// blocks are sorted with bitonic merges, each compare-exchange
+// handles four pairs at a time.
 
-        b32 cmp = reverse ? *pivot < *at_j : *at_j < *pivot;
-        if( cmp ) {
-            ++i;
-            i32* at_i = buffer + i;
-            i32 temp = *at_j;
-            *at_j = *at_i;
-            *at_i = temp;
+attr_always_inline inline attr_internal
+void internal_sort_network_minmax( __m128i* lo, __m128i* hi ) {
+    __m128i swap = _mm_and_si128(
+        _mm_xor_si128( *lo, *hi ), _mm_cmpgt_epi32( *lo, *hi ) );
+    *lo = _mm_xor_si128( *lo, swap );
+    *hi = _mm_xor_si128( *hi, swap );
+}
+/// @brief Compare-exchange lanes 0-1 and 2-3.
+attr_always_inline inline attr_internal
+__m128i internal_sort_network_pairs( __m128i v ) {
+    __m128i lo = v;
+    __m128i hi = _mm_shuffle_epi32( v, _MM_SHUFFLE( 2, 3, 0, 1 ) );
+    internal_sort_network_minmax( &lo, &hi );
+    v = _mm_castps_si128( _mm_shuffle_ps(
+        _mm_castsi128_ps( lo ), _mm_castsi128_ps( hi ), _MM_SHUFFLE( 2, 0, 2, 0 ) ) );
+    return _mm_shuffle_epi32( v, _MM_SHUFFLE( 3, 1, 2, 0 ) );
+}
+/// @brief Sort bitonic register.
+attr_always_inline inline attr_internal
+__m128i internal_sort_network_clean4( __m128i v ) {
+    __m128i lo = v;
+    __m128i hi = _mm_shuffle_epi32( v, _MM_SHUFFLE( 1, 0, 3, 2 ) );
+    internal_sort_network_minmax( &lo, &hi );
+    return internal_sort_network_pairs( _mm_unpacklo_epi64( lo, hi ) );
+}
+attr_always_inline inline attr_internal
+__m128i internal_sort_network_reverse4( __m128i v ) {
+    return _mm_shuffle_epi32( v, _MM_SHUFFLE( 0, 1, 2, 3 ) );
+}
+attr_always_inline inline attr_internal
+__m128i internal_sort_network_sort4( __m128i v ) {
+    v = internal_sort_network_pairs( v );
+    v = _mm_shuffle_epi32( v, _MM_SHUFFLE( 2, 3, 1, 0 ) );
+    return internal_sort_network_clean4( v );
+}
+/// @brief Sort bitonic sequence of registers.
+attr_always_inline inline attr_internal
+void internal_sort_network_clean( usize count, __m128i* v ) {
+    for( usize distance = count / 2; distance; distance /= 2 ) {
+        for( usize i = 0; i < count; ++i ) {
+            if( !(i & distance) ) {
+                internal_sort_network_minmax( v + i, v + i + distance );
+            }
         }
     }
+    for( usize i = 0; i < count; ++i ) {
+        v[i] = internal_sort_network_clean4( v[i] );
+    }
+}
+/// @brief Merge two sorted halves of registers.
+attr_always_inline inline attr_internal
+void internal_sort_network_merge( usize count, __m128i* v ) {
+    // NOTE(alicia): reversing second half makes whole sequence bitonic.
+    usize half = count / 2;
+    for( usize i = 0; i < (half / 2); ++i ) {
+        __m128i temp     = v[half + i];
+        v[half + i]      = v[count - 1 - i];
+        v[count - 1 - i] = temp;
+    }
+    for( usize i = half; i < count; ++i ) {
+        v[i] = internal_sort_network_reverse4( v[i] );
+    }
+    internal_sort_network_clean( count, v );
+}
+attr_always_inline inline attr_internal
+void internal_sort_network_sort16( __m128i* v ) {
+    // NOTE(alicia): sort columns, then transpose
+    // so that each register holds a sorted row.
+    internal_sort_network_minmax( v + 0, v + 1 );
+    internal_sort_network_minmax( v + 2, v + 3 );
+    internal_sort_network_minmax( v + 0, v + 2 );
+    internal_sort_network_minmax( v + 1, v + 3 );
+    internal_sort_network_minmax( v + 1, v + 2 );
 
-    i32 temp = *(buffer + ( i + 1 ));
-    *(buffer + (i + 1)) = *(buffer + high);
-    *(buffer + high) = temp;
+    __m128i t0 = _mm_unpacklo_epi32( v[0], v[1] );
+    __m128i t1 = _mm_unpacklo_epi32( v[2], v[3] );
+    __m128i t2 = _mm_unpackhi_epi32( v[0], v[1] );
+    __m128i t3 = _mm_unpackhi_epi32( v[2], v[3] );
+    v[0] = _mm_unpacklo_epi64( t0, t1 );
+    v[1] = _mm_unpackhi_epi64( t0, t1 );
+    v[2] = _mm_unpacklo_epi64( t2, t3 );
+    v[3] = _mm_unpackhi_epi64( t2, t3 );
 
-    return i + 1;
+    internal_sort_network_merge( 2, v );
+    internal_sort_network_merge( 2, v + 2 );
+    internal_sort_network_merge( 4, v );
 }
-attr_core_api
-void quicksort_i32(
-    isize from_inclusive, isize to_inclusive, i32* buffer, b32 reverse
+attr_always_inline inline attr_internal
+void internal_sort_network_sort( usize count, __m128i* v ) {
+    switch( count ) {
+        case 1: {
+            v[0] = internal_sort_network_sort4( v[0] );
+        } break;
+        case 2: {
+            v[0] = internal_sort_network_sort4( v[0] );
+            v[1] = internal_sort_network_sort4( v[1] );
+            internal_sort_network_merge( 2, v );
+        } break;
+        case 4: {
+            internal_sort_network_sort16( v );
+        } break;
+        default: {
+            internal_sort_network_sort16( v );
+            internal_sort_network_sort16( v + 4 );
+            internal_sort_network_merge( 8, v );
+        } break;
+    }
+}
+/// @brief Map values to keys that sort correctly as signed integers and back.
+attr_always_inline inline attr_internal
+__m128i internal_sort_network_key( __m128i x, enum InternalRadixKey kind ) {
+    switch( kind ) {
+        case INTERNAL_RADIX_KEY_UNSIGNED: {
+            x = _mm_xor_si128( x, _mm_set1_epi32( (int)0x80000000u ) );
+        } break;
+        case INTERNAL_RADIX_KEY_SIGNED: break;
+        case INTERNAL_RADIX_KEY_FLOAT: {
+            // NOTE(alicia): negative floats have magnitude flipped
+            // so that larger magnitude sorts first.
+            x = _mm_xor_si128( x, _mm_and_si128(
+                _mm_srai_epi32( x, 31 ), _mm_set1_epi32( 0x7FFFFFFF ) ) );
+        } break;
+    }
+    return x;
+}
+attr_always_inline inline attr_internal
+void internal_sort_network(
+    usize len, u32* buffer, enum InternalRadixKey kind, b32 reverse
 ) {
+    __m128i v[SORT_NETWORK_MAX / 4];
+    __m128i flip  = _mm_set1_epi32( reverse ? -1 : 0 );
+    usize   full  = len / 4;
+    usize   count = 1;
+    while( (count * 4) < len ) {
+        count *= 2;
+    }
+
+    for( usize i = 0; i < full; ++i ) {
+        v[i] = _mm_xor_si128( internal_sort_network_key(
+            _mm_loadu_si128( (const __m128i*)(buffer + (i * 4)) ), kind ), flip );
+    }
+    // NOTE(alicia): padding keys are the greatest signed key
+    // so they always end up past len.
+    __m128i pad = _mm_set1_epi32( 0x7FFFFFFF );
+    usize   rem = len % 4;
+    if( rem ) {
+        u32 tail[4];
+        for( usize i = 0; i < rem; ++i ) {
+            tail[i] = buffer[(full * 4) + i];
+        }
+        for( usize i = rem; i < 4; ++i ) {
+            tail[i] = 0;
+        }
+        // NOTE(alicia): lanes past rem are replaced with padding after mapping.
+        __m128i mask = _mm_cmplt_epi32(
+            _mm_set_epi32( 3, 2, 1, 0 ), _mm_set1_epi32( (int)rem ) );
+        __m128i key  = _mm_xor_si128( internal_sort_network_key(
+            _mm_loadu_si128( (const __m128i*)tail ), kind ), flip );
+        v[full] = _mm_or_si128(
+            _mm_and_si128( mask, key ), _mm_andnot_si128( mask, pad ) );
+    }
+    for( usize i = full + (rem ? 1 : 0); i < count; ++i ) {
+        v[i] = pad;
+    }
 
-    while( from_inclusive < to_inclusive ) {
-        isize partition_index =
-            quicksort_partition_i32( from_inclusive, to_inclusive, buffer, reverse );
+    internal_sort_network_sort( count, v );
 
-        if(
-            (partition_index - from_inclusive) <
-            (to_inclusive - partition_index)
-        ) {
-            quicksort_i32( from_inclusive, partition_index - 1, buffer, reverse );
-            from_inclusive = partition_index + 1;
-        } else {
-            quicksort_i32( partition_index + 1, to_inclusive, buffer, reverse );
-            to_inclusive = partition_index - 1;
+    for( usize i = 0; i < full; ++i ) {
+        _mm_storeu_si128(
+            (__m128i*)(buffer + (i * 4)),
+            internal_sort_network_key( _mm_xor_si128( v[i], flip ), kind ) );
+    }
+    if( rem ) {
+        u32 tail[4];
+        _mm_storeu_si128(
+            (__m128i*)tail,
+            internal_sort_network_key( _mm_xor_si128( v[full], flip ), kind ) );
+        for( usize i = 0; i < rem; ++i ) {
+            buffer[(full * 4) + i] = tail[i];
         }
     }
 }
 
+#endif /* CORE_ENABLE_SSE_INSTRUCTIONS */
+
+// NOTE(alicia): quicksort_* are introsort:
+// median of three or ninther pivot, Hoare partition,
+// insertion sort for short ranges and heapsort once
+// recursion gets too deep so worst case is O(n log n).
+
 attr_always_inline inline attr_internal
-void internal_sort_swap(
-    void* a, void* b, void* swap_buffer, usize size
+b32 internal_sort_less_i32( i32 a, i32 b, b32 reverse ) {
+    return reverse ? b < a : a < b;
+}
+#if !defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+attr_internal
+void internal_sort_insertion_i32( isize len, i32* buffer, b32 reverse ) {
+    for( isize i = 1; i < len; ++i ) {
+        i32 value = buffer[i];
+        isize j   = i;
+        while( j > 0 && internal_sort_less_i32( value, buffer[j - 1], reverse ) ) {
+            buffer[j] = buffer[j - 1];
+            j--;
+        }
+        buffer[j] = value;
+    }
+}
+#endif
+attr_internal
+void internal_sort_sift_down_i32(
+    isize root, isize len, i32* buffer, b32 reverse
 ) {
-    memory_copy( swap_buffer, a, size );
-    memory_copy( a, b, size );
-    memory_copy( b, swap_buffer, size );
+    i32 value = buffer[root];
+    for( ;; ) {
+        isize child = (root * 2) + 1;
+        if( child >= len ) {
+            break;
+        }
+        if(
+            (child + 1) < len &&
+            internal_sort_less_i32( buffer[child], buffer[child + 1], reverse )
+        ) {
+            child++;
+        }
+        if( !internal_sort_less_i32( value, buffer[child], reverse ) ) {
+            break;
+        }
+        buffer[root] = buffer[child];
+        root = child;
+    }
+    buffer[root] = value;
 }
-
 attr_internal
-isize quicksort_generic_partition(
-    isize low, isize high, usize stride, void* buffer,
-    SortCmpFN* cmp_fn, void* cmp_params, void* swap_buffer
+void internal_sort_heapsort_i32( isize len, i32* buffer, b32 reverse ) {
+    for( isize i = (len / 2) - 1; i >= 0; --i ) {
+        internal_sort_sift_down_i32( i, len, buffer, reverse );
+    }
+    for( isize i = len - 1; i > 0; --i ) {
+        i32 temp  = buffer[0];
+        buffer[0] = buffer[i];
+        buffer[i] = temp;
+        internal_sort_sift_down_i32( 0, i, buffer, reverse );
+    }
+}
+attr_always_inline inline attr_internal
+isize internal_sort_median3_i32(
+    isize a, isize b, isize c, const i32* buffer, b32 reverse
 ) {
-    u8* buf = buffer;
-    void* pivot = buf + (high * stride);
-
-    isize i = (isize)low - 1;
+    if( internal_sort_less_i32( buffer[a], buffer[b], reverse ) ) {
+        if( internal_sort_less_i32( buffer[b], buffer[c], reverse ) ) {
+            return b;
+        }
+        return internal_sort_less_i32( buffer[a], buffer[c], reverse ) ? c : a;
+    }
+    if( internal_sort_less_i32( buffer[a], buffer[c], reverse ) ) {
+        return a;
+    }
+    return internal_sort_less_i32( buffer[b], buffer[c], reverse ) ? c : b;
+}
+attr_internal
+isize internal_sort_partition_i32( isize len, i32* buffer, b32 reverse ) {
+    isize mid   = len / 2;
+    isize last  = len - 1;
+    isize pivot = 0;
+    if( len > SORT_NINTHER_THRESHOLD ) {
+        isize s = len / 8;
+        pivot   = internal_sort_median3_i32(
+            internal_sort_median3_i32( 0, s, s * 2, buffer, reverse ),
+            internal_sort_median3_i32( mid - s, mid, mid + s, buffer, reverse ),
+            internal_sort_median3_i32( last - (s * 2), last - s, last, buffer, reverse ),
+            buffer, reverse );
+    } else {
+        pivot = internal_sort_median3_i32( 0, mid, last, buffer, reverse );
+    }
 
-    for( isize j = (isize)low; j <= (isize)high - 1; ++j ) {
-        void* at_j = buf + (j * stride);
+    i32 temp = buffer[0];
+    buffer[0]     = buffer[pivot];
+    buffer[pivot] = temp;
 
-        if( cmp_fn( at_j, pivot, stride, cmp_params ) ) {
-            ++i;
-            void* at_i = buf + (i * stride);
-            internal_sort_swap( at_i, at_j, swap_buffer, stride );
+    i32 value = buffer[0];
+    isize i = 0, j = len;
+    for( ;; ) {
+        while( internal_sort_less_i32( buffer[++i], value, reverse ) ) {
+            if( i == last ) {
+                break;
+            }
         }
+        while( internal_sort_less_i32( value, buffer[--j], reverse ) ) {}
+        if( i >= j ) {
+            break;
+        }
+        temp      = buffer[i];
+        buffer[i] = buffer[j];
+        buffer[j] = temp;
     }
 
-    i++;
-    internal_sort_swap(
-        buf + (i * stride), buf + (high * stride), swap_buffer, stride );
-    return i;
+    buffer[0] = buffer[j];
+    buffer[j] = value;
+    return j;
 }
-attr_core_api
-void quicksort_generic(
-    isize from_inclusive, isize to_inclusive,
-    usize stride, void* buffer,
-    SortCmpFN* cmp, void* cmp_params, void* swap_buffer
+/// @brief Base case of introsort and introselect.
+attr_always_inline inline attr_internal
+void internal_sort_small_i32( isize len, i32* buffer, b32 reverse ) {
+    if( len < 2 ) {
+        return;
+    }
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+    internal_sort_network( (usize)len, (u32*)buffer, INTERNAL_RADIX_KEY_SIGNED, reverse );
+#else
+    internal_sort_insertion_i32( len, buffer, reverse );
+#endif
+}
+attr_internal
+void internal_sort_introsort_i32(
+    isize len, i32* buffer, usize depth, b32 reverse
 ) {
-    while( from_inclusive < to_inclusive ) {
-        isize partition_index = quicksort_generic_partition(
-            from_inclusive, to_inclusive, stride,
-            buffer, cmp, cmp_params, swap_buffer );
+    while( len > SORT_INSERTION_THRESHOLD ) {
+        if( !depth ) {
+            internal_sort_heapsort_i32( len, buffer, reverse );
+            return;
+        }
+        depth--;
 
-        if( partition_index - from_inclusive < to_inclusive - partition_index ) {
-            quicksort_generic(
-                from_inclusive, partition_index - 1,
-                stride, buffer, cmp, cmp_params, swap_buffer );
-            from_inclusive = partition_index + 1;
+        isize p     = internal_sort_partition_i32( len, buffer, reverse );
+        isize left  = p;
+        isize right = len - p - 1;
+        if( left < right ) {
+            internal_sort_introsort_i32( left, buffer, depth, reverse );
+            buffer += p + 1;
+            len     = right;
         } else {
-            quicksort_generic(
-                partition_index + 1, to_inclusive,
-                stride, buffer, cmp, cmp_params, swap_buffer );
-            to_inclusive = partition_index - 1;
+            internal_sort_introsort_i32( right, buffer + p + 1, depth, reverse );
+            len = left;
         }
     }
+    internal_sort_small_i32( len, buffer, reverse );
+}
+attr_core_api
+void quicksort_i32(
+    isize from_inclusive, isize to_inclusive, i32* buffer, b32 reverse
+) {
+    if( to_inclusive <= from_inclusive ) {
+        return;
+    }
+    isize len = (to_inclusive - from_inclusive) + 1;
+    internal_sort_introsort_i32(
+        len, buffer + from_inclusive, internal_sort_depth_limit( len ), reverse );
+}
+attr_core_api
+void sort_network_i32( usize len, i32* buffer, b32 reverse ) {
+    if( len > SORT_NETWORK_MAX ) {
+        internal_sort_introsort_i32(
+            (isize)len, buffer, internal_sort_depth_limit( (isize)len ), reverse );
+        return;
+    }
+    internal_sort_small_i32( (isize)len, buffer, reverse );
 }
 
+attr_always_inline inline attr_internal
+b32 internal_sort_less_u32( u32 a, u32 b, b32 reverse ) {
+    return reverse ? b < a : a < b;
+}
+#if !defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+attr_internal
+void internal_sort_insertion_u32( isize len, u32* buffer, b32 reverse ) {
+    for( isize i = 1; i < len; ++i ) {
+        u32 value = buffer[i];
+        isize j   = i;
+        while( j > 0 && internal_sort_less_u32( value, buffer[j - 1], reverse ) ) {
+            buffer[j] = buffer[j - 1];
+            j--;
+        }
+        buffer[j] = value;
+    }
+}
+#endif
 attr_internal
-isize quicksort_partition_u32(
-    isize low, isize high, u32* buffer, b32 reverse
+void internal_sort_sift_down_u32(
+    isize root, isize len, u32* buffer, b32 reverse
 ) {
-    u32* pivot = buffer + high;
-
-    isize i = low - 1;
+    u32 value = buffer[root];
+    for( ;; ) {
+        isize child = (root * 2) + 1;
+        if( child >= len ) {
+            break;
+        }
+        if(
+            (child + 1) < len &&
+            internal_sort_less_u32( buffer[child], buffer[child + 1], reverse )
+        ) {
+            child++;
+        }
+        if( !internal_sort_less_u32( value, buffer[child], reverse ) ) {
+            break;
+        }
+        buffer[root] = buffer[child];
+        root = child;
+    }
+    buffer[root] = value;
+}
+attr_internal
+void internal_sort_heapsort_u32( isize len, u32* buffer, b32 reverse ) {
+    for( isize i = (len / 2) - 1; i >= 0; --i ) {
+        internal_sort_sift_down_u32( i, len, buffer, reverse );
+    }
+    for( isize i = len - 1; i > 0; --i ) {
+        u32 temp  = buffer[0];
+        buffer[0] = buffer[i];
+        buffer[i] = temp;
+        internal_sort_sift_down_u32( 0, i, buffer, reverse );
+    }
+}
+attr_always_inline inline attr_internal
+isize internal_sort_median3_u32(
+    isize a, isize b, isize c, const u32* buffer, b32 reverse
+) {
+    if( internal_sort_less_u32( buffer[a], buffer[b], reverse ) ) {
+        if( internal_sort_less_u32( buffer[b], buffer[c], reverse ) ) {
+            return b;
+        }
+        return internal_sort_less_u32( buffer[a], buffer[c], reverse ) ? c : a;
+    }
+    if( internal_sort_less_u32( buffer[a], buffer[c], reverse ) ) {
+        return a;
+    }
+    return internal_sort_less_u32( buffer[b], buffer[c], reverse ) ? c : b;
+}
+attr_internal
+isize internal_sort_partition_u32( isize len, u32* buffer, b32 reverse ) {
+    isize mid   = len / 2;
+    isize last  = len - 1;
+    isize pivot = 0;
+    if( len > SORT_NINTHER_THRESHOLD ) {
+        isize s = len / 8;
+        pivot   = internal_sort_median3_u32(
+            internal_sort_median3_u32( 0, s, s * 2, buffer, reverse ),
+            internal_sort_median3_u32( mid - s, mid, mid + s, buffer, reverse ),
+            internal_sort_median3_u32( last - (s * 2), last - s, last, buffer, reverse ),
+            buffer, reverse );
+    } else {
+        pivot = internal_sort_median3_u32( 0, mid, last, buffer, reverse );
+    }
 
-    for( isize j = low; j <= high - 1; ++j ) {
-        u32* at_j = buffer + j;
+    u32 temp = buffer[0];
+    buffer[0]     = buffer[pivot];
+    buffer[pivot] = temp;
 
-        b32 cmp = reverse ? *pivot < *at_j : *at_j < *pivot;
-        if( cmp ) {
-            ++i;
-            u32* at_i = buffer + i;
-            u32 temp = *at_j;
-            *at_j = *at_i;
-            *at_i = temp;
+    u32 value = buffer[0];
+    isize i = 0, j = len;
+    for( ;; ) {
+        while( internal_sort_less_u32( buffer[++i], value, reverse ) ) {
+            if( i == last ) {
+                break;
+            }
         }
+        while( internal_sort_less_u32( value, buffer[--j], reverse ) ) {}
+        if( i >= j ) {
+            break;
+        }
+        temp      = buffer[i];
+        buffer[i] = buffer[j];
+        buffer[j] = temp;
     }
 
-    u32 temp = *(buffer + ( i + 1 ));
-    *(buffer + (i + 1)) = *(buffer + high);
-    *(buffer + high) = temp;
+    buffer[0] = buffer[j];
+    buffer[j] = value;
+    return j;
+}
+/// @brief Base case of introsort and introselect.
+attr_always_inline inline attr_internal
+void internal_sort_small_u32( isize len, u32* buffer, b32 reverse ) {
+    if( len < 2 ) {
+        return;
+    }
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+    internal_sort_network( (usize)len, (u32*)buffer, INTERNAL_RADIX_KEY_UNSIGNED, reverse );
+#else
+    internal_sort_insertion_u32( len, buffer, reverse );
+#endif
+}
+attr_internal
+void internal_sort_introsort_u32(
+    isize len, u32* buffer, usize depth, b32 reverse
+) {
+    while( len > SORT_INSERTION_THRESHOLD ) {
+        if( !depth ) {
+            internal_sort_heapsort_u32( len, buffer, reverse );
+            return;
+        }
+        depth--;
 
-    return i + 1;
+        isize p     = internal_sort_partition_u32( len, buffer, reverse );
+        isize left  = p;
+        isize right = len - p - 1;
+        if( left < right ) {
+            internal_sort_introsort_u32( left, buffer, depth, reverse );
+            buffer += p + 1;
+            len     = right;
+        } else {
+            internal_sort_introsort_u32( right, buffer + p + 1, depth, reverse );
+            len = left;
+        }
+    }
+    internal_sort_small_u32( len, buffer, reverse );
 }
 attr_core_api
 void quicksort_u32(
     isize from_inclusive, isize to_inclusive, u32* buffer, b32 reverse
 ) {
+    if( to_inclusive <= from_inclusive ) {
+        return;
+    }
+    isize len = (to_inclusive - from_inclusive) + 1;
+    internal_sort_introsort_u32(
+        len, buffer + from_inclusive, internal_sort_depth_limit( len ), reverse );
+}
+attr_core_api
+void sort_network_u32( usize len, u32* buffer, b32 reverse ) {
+    if( len > SORT_NETWORK_MAX ) {
+        internal_sort_introsort_u32(
+            (isize)len, buffer, internal_sort_depth_limit( (isize)len ), reverse );
+        return;
+    }
+    internal_sort_small_u32( (isize)len, buffer, reverse );
+}
 
-    while( from_inclusive < to_inclusive ) {
-        isize partition_index =
-            quicksort_partition_u32( from_inclusive, to_inclusive, buffer, reverse );
-
+attr_always_inline inline attr_internal
+b32 internal_sort_less_f32( f32 a, f32 b, b32 reverse ) {
+    return reverse ? b < a : a < b;
+}
+#if !defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+attr_internal
+void internal_sort_insertion_f32( isize len, f32* buffer, b32 reverse ) {
+    for( isize i = 1; i < len; ++i ) {
+        f32 value = buffer[i];
+        isize j   = i;
+        while( j > 0 && internal_sort_less_f32( value, buffer[j - 1], reverse ) ) {
+            buffer[j] = buffer[j - 1];
+            j--;
+        }
+        buffer[j] = value;
+    }
+}
+#endif
+attr_internal
+void internal_sort_sift_down_f32(
+    isize root, isize len, f32* buffer, b32 reverse
+) {
+    f32 value = buffer[root];
+    for( ;; ) {
+        isize child = (root * 2) + 1;
+        if( child >= len ) {
+            break;
+        }
         if(
-            (partition_index - from_inclusive) <
-            (to_inclusive - partition_index)
+            (child + 1) < len &&
+            internal_sort_less_f32( buffer[child], buffer[child + 1], reverse )
         ) {
-            quicksort_u32( from_inclusive, partition_index - 1, buffer, reverse );
-            from_inclusive = partition_index + 1;
-        } else {
-            quicksort_u32( partition_index + 1, to_inclusive, buffer, reverse );
-            to_inclusive = partition_index - 1;
+            child++;
+        }
+        if( !internal_sort_less_f32( value, buffer[child], reverse ) ) {
+            break;
         }
+        buffer[root] = buffer[child];
+        root = child;
     }
+    buffer[root] = value;
 }
-
 attr_internal
-isize quicksort_partition_f32(
-    isize low, isize high, f32* buffer, b32 reverse
+void internal_sort_heapsort_f32( isize len, f32* buffer, b32 reverse ) {
+    for( isize i = (len / 2) - 1; i >= 0; --i ) {
+        internal_sort_sift_down_f32( i, len, buffer, reverse );
+    }
+    for( isize i = len - 1; i > 0; --i ) {
+        f32 temp  = buffer[0];
+        buffer[0] = buffer[i];
+        buffer[i] = temp;
+        internal_sort_sift_down_f32( 0, i, buffer, reverse );
+    }
+}
+attr_always_inline inline attr_internal
+isize internal_sort_median3_f32(
+    isize a, isize b, isize c, const f32* buffer, b32 reverse
 ) {
-    f32* pivot = buffer + high;
-
-    isize i = low - 1;
+    if( internal_sort_less_f32( buffer[a], buffer[b], reverse ) ) {
+        if( internal_sort_less_f32( buffer[b], buffer[c], reverse ) ) {
+            return b;
+        }
+        return internal_sort_less_f32( buffer[a], buffer[c], reverse ) ? c : a;
+    }
+    if( internal_sort_less_f32( buffer[a], buffer[c], reverse ) ) {
+        return a;
+    }
+    return internal_sort_less_f32( buffer[b], buffer[c], reverse ) ? c : b;
+}
+attr_internal
+isize internal_sort_partition_f32( isize len, f32* buffer, b32 reverse ) {
+    isize mid   = len / 2;
+    isize last  = len - 1;
+    isize pivot = 0;
+    if( len > SORT_NINTHER_THRESHOLD ) {
+        isize s = len / 8;
+        pivot   = internal_sort_median3_f32(
+            internal_sort_median3_f32( 0, s, s * 2, buffer, reverse ),
+            internal_sort_median3_f32( mid - s, mid, mid + s, buffer, reverse ),
+            internal_sort_median3_f32( last - (s * 2), last - s, last, buffer, reverse ),
+            buffer, reverse );
+    } else {
+        pivot = internal_sort_median3_f32( 0, mid, last, buffer, reverse );
+    }
 
-    for( isize j = low; j <= high - 1; ++j ) {
-        f32* at_j = buffer + j;
+    f32 temp = buffer[0];
+    buffer[0]     = buffer[pivot];
+    buffer[pivot] = temp;
 
-        b32 cmp = reverse ? *pivot < *at_j : *at_j < *pivot;
-        if( cmp ) {
-            ++i;
-            f32* at_i = buffer + i;
-            f32 temp = *at_j;
-            *at_j = *at_i;
-            *at_i = temp;
+    f32 value = buffer[0];
+    isize i = 0, j = len;
+    for( ;; ) {
+        while( internal_sort_less_f32( buffer[++i], value, reverse ) ) {
+            if( i == last ) {
+                break;
+            }
         }
+        while( internal_sort_less_f32( value, buffer[--j], reverse ) ) {}
+        if( i >= j ) {
+            break;
+        }
+        temp      = buffer[i];
+        buffer[i] = buffer[j];
+        buffer[j] = temp;
     }
 
-    f32 temp = *(buffer + ( i + 1 ));
-    *(buffer + (i + 1)) = *(buffer + high);
-    *(buffer + high) = temp;
+    buffer[0] = buffer[j];
+    buffer[j] = value;
+    return j;
+}
+/// @brief Base case of introsort and introselect.
+attr_always_inline inline attr_internal
+void internal_sort_small_f32( isize len, f32* buffer, b32 reverse ) {
+    if( len < 2 ) {
+        return;
+    }
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+    internal_sort_network( (usize)len, (u32*)buffer, INTERNAL_RADIX_KEY_FLOAT, reverse );
+#else
+    internal_sort_insertion_f32( len, buffer, reverse );
+#endif
+}
+attr_internal
+void internal_sort_introsort_f32(
+    isize len, f32* buffer, usize depth, b32 reverse
+) {
+    while( len > SORT_INSERTION_THRESHOLD ) {
+        if( !depth ) {
+            internal_sort_heapsort_f32( len, buffer, reverse );
+            return;
+        }
+        depth--;
 
-    return i + 1;
+        isize p     = internal_sort_partition_f32( len, buffer, reverse );
+        isize left  = p;
+        isize right = len - p - 1;
+        if( left < right ) {
+            internal_sort_introsort_f32( left, buffer, depth, reverse );
+            buffer += p + 1;
+            len     = right;
+        } else {
+            internal_sort_introsort_f32( right, buffer + p + 1, depth, reverse );
+            len = left;
+        }
+    }
+    internal_sort_small_f32( len, buffer, reverse );
 }
 attr_core_api
 void quicksort_f32(
     isize from_inclusive, isize to_inclusive, f32* buffer, b32 reverse
 ) {
+    if( to_inclusive <= from_inclusive ) {
+        return;
+    }
+    isize len = (to_inclusive - from_inclusive) + 1;
+    internal_sort_introsort_f32(
+        len, buffer + from_inclusive, internal_sort_depth_limit( len ), reverse );
+}
+attr_core_api
+void sort_network_f32( usize len, f32* buffer, b32 reverse ) {
+    if( len > SORT_NETWORK_MAX ) {
+        internal_sort_introsort_f32(
+            (isize)len, buffer, internal_sort_depth_limit( (isize)len ), reverse );
+        return;
+    }
+    internal_sort_small_f32( (isize)len, buffer, reverse );
+}
 
-    while( from_inclusive < to_inclusive ) {
-        isize partition_index =
-            quicksort_partition_f32( from_inclusive, to_inclusive, buffer, reverse );
+#define SORT_AT( index ) (buffer + ((index) * stride))
 
+attr_internal
+void internal_sort_insertion_generic(
+    isize len, usize stride, u8* buffer,
+    SortCmpFN* cmp_fn, void* cmp_params, void* swap_buffer
+) {
+    for( isize i = 1; i < len; ++i ) {
+        isize j = i;
+        while( j > 0 && cmp_fn( SORT_AT( i ), SORT_AT( j - 1 ), stride, cmp_params ) ) {
+            j--;
+        }
+        if( j != i ) {
+            internal_sort_copy( swap_buffer, SORT_AT( i ), stride );
+            memory_move( SORT_AT( j + 1 ), SORT_AT( j ), (i - j) * stride );
+            internal_sort_copy( SORT_AT( j ), swap_buffer, stride );
+        }
+    }
+}
+attr_internal
+void internal_sort_sift_down_generic(
+    isize root, isize len, usize stride, u8* buffer,
+    SortCmpFN* cmp_fn, void* cmp_params, void* swap_buffer
+) {
+    for( ;; ) {
+        isize child = (root * 2) + 1;
+        if( child >= len ) {
+            break;
+        }
         if(
-            (partition_index - from_inclusive) <
-            (to_inclusive - partition_index)
+            (child + 1) < len &&
+            cmp_fn( SORT_AT( child ), SORT_AT( child + 1 ), stride, cmp_params )
         ) {
-            quicksort_f32( from_inclusive, partition_index - 1, buffer, reverse );
-            from_inclusive = partition_index + 1;
+            child++;
+        }
+        if( !cmp_fn( SORT_AT( root ), SORT_AT( child ), stride, cmp_params ) ) {
+            break;
+        }
+        internal_sort_swap( SORT_AT( root ), SORT_AT( child ), swap_buffer, stride );
+        root = child;
+    }
+}
+attr_internal
+void internal_sort_heapsort_generic(
+    isize len, usize stride, u8* buffer,
+    SortCmpFN* cmp_fn, void* cmp_params, void* swap_buffer
+) {
+    for( isize i = (len / 2) - 1; i >= 0; --i ) {
+        internal_sort_sift_down_generic(
+            i, len, stride, buffer, cmp_fn, cmp_params, swap_buffer );
+    }
+    for( isize i = len - 1; i > 0; --i ) {
+        internal_sort_swap( SORT_AT( 0 ), SORT_AT( i ), swap_buffer, stride );
+        internal_sort_sift_down_generic(
+            0, i, stride, buffer, cmp_fn, cmp_params, swap_buffer );
+    }
+}
+attr_internal
+isize internal_sort_median3_generic(
+    isize a, isize b, isize c, usize stride, u8* buffer,
+    SortCmpFN* cmp_fn, void* cmp_params
+) {
+    if( cmp_fn( SORT_AT( a ), SORT_AT( b ), stride, cmp_params ) ) {
+        if( cmp_fn( SORT_AT( b ), SORT_AT( c ), stride, cmp_params ) ) {
+            return b;
+        }
+        return cmp_fn( SORT_AT( a ), SORT_AT( c ), stride, cmp_params ) ? c : a;
+    }
+    if( cmp_fn( SORT_AT( a ), SORT_AT( c ), stride, cmp_params ) ) {
+        return a;
+    }
+    return cmp_fn( SORT_AT( b ), SORT_AT( c ), stride, cmp_params ) ? c : b;
+}
+attr_internal
+isize internal_sort_partition_generic(
+    isize len, usize stride, u8* buffer,
+    SortCmpFN* cmp_fn, void* cmp_params, void* swap_buffer
+) {
+    isize mid   = len / 2;
+    isize last  = len - 1;
+    isize pivot = 0;
+    if( len > SORT_NINTHER_THRESHOLD ) {
+        isize s = len / 8;
+        pivot   = internal_sort_median3_generic(
+            internal_sort_median3_generic(
+                0, s, s * 2, stride, buffer, cmp_fn, cmp_params ),
+            internal_sort_median3_generic(
+                mid - s, mid, mid + s, stride, buffer, cmp_fn, cmp_params ),
+            internal_sort_median3_generic(
+                last - (s * 2), last - s, last, stride, buffer, cmp_fn, cmp_params ),
+            stride, buffer, cmp_fn, cmp_params );
+    } else {
+        pivot = internal_sort_median3_generic(
+            0, mid, last, stride, buffer, cmp_fn, cmp_params );
+    }
+    if( pivot ) {
+        internal_sort_swap( SORT_AT( 0 ), SORT_AT( pivot ), swap_buffer, stride );
+    }
+
+    // NOTE(alicia): pivot stays at index 0 until partition is done.
+    isize i = 0, j = len;
+    for( ;; ) {
+        while( cmp_fn( SORT_AT( ++i ), SORT_AT( 0 ), stride, cmp_params ) ) {
+            if( i == last ) {
+                break;
+            }
+        }
+        // NOTE(alicia): non-strict comparators (<=) can match the pivot
+        // itself, so j must not walk past index 0.
+        while( cmp_fn( SORT_AT( 0 ), SORT_AT( --j ), stride, cmp_params ) ) {
+            if( !j ) {
+                break;
+            }
+        }
+        if( i >= j ) {
+            break;
+        }
+        internal_sort_swap( SORT_AT( i ), SORT_AT( j ), swap_buffer, stride );
+    }
+
+    if( j ) {
+        internal_sort_swap( SORT_AT( 0 ), SORT_AT( j ), swap_buffer, stride );
+    }
+    return j;
+}
+attr_internal
+void internal_sort_introsort_generic(
+    isize len, usize stride, u8* buffer, usize depth,
+    SortCmpFN* cmp_fn, void* cmp_params, void* swap_buffer
+) {
+    while( len > SORT_INSERTION_THRESHOLD ) {
+        if( !depth ) {
+            internal_sort_heapsort_generic(
+                len, stride, buffer, cmp_fn, cmp_params, swap_buffer );
+            return;
+        }
+        depth--;
+
+        isize p = internal_sort_partition_generic(
+            len, stride, buffer, cmp_fn, cmp_params, swap_buffer );
+        isize left  = p;
+        isize right = len - p - 1;
+        if( left < right ) {
+            internal_sort_introsort_generic(
+                left, stride, buffer, depth, cmp_fn, cmp_params, swap_buffer );
+            buffer += (p + 1) * stride;
+            len     = right;
         } else {
-            quicksort_f32( partition_index + 1, to_inclusive, buffer, reverse );
-            to_inclusive = partition_index - 1;
+            internal_sort_introsort_generic(
+                right, stride, SORT_AT( p + 1 ), depth, cmp_fn, cmp_params, swap_buffer );
+            len = left;
         }
     }
+    internal_sort_insertion_generic(
+        len, stride, buffer, cmp_fn, cmp_params, swap_buffer );
+}
+
+#undef SORT_AT
+
+attr_core_api
+void quicksort_generic(
+    isize from_inclusive, isize to_inclusive,
+    usize stride, void* buffer,
+    SortCmpFN* cmp, void* cmp_params, void* swap_buffer
+) {
+    if( to_inclusive <= from_inclusive ) {
+        return;
+    }
+    isize len = (to_inclusive - from_inclusive) + 1;
+    internal_sort_introsort_generic(
+        len, stride, (u8*)buffer + (from_inclusive * stride),
+        internal_sort_depth_limit( len ), cmp, cmp_params, swap_buffer );
 }
 
 attr_core_api
 void sort_reverse(
     usize len, usize stride, void* buffer, void* swap_buffer
 ) {
+    if( len < 2 ) {
+        return;
+    }
     u8* bytes = buffer;
     usize start = 0;
     usize end   = len - 1;
@@ -231,3 +998,1421 @@ void sort_reverse(
     }
 }
 
+// NOTE(alicia): select_nth_* is introselect, partition like introsort
+// but only continue into the side that contains nth.
+// partial_sort_* selects then sorts only the front of the buffer.
+// top_k_* keeps the best k items in a bounded heap, the worst of them
+// at the root is the threshold that every other item has to beat.
+
+attr_internal
+void internal_sort_select_i32(
+    isize len, i32* buffer, isize nth, usize depth, b32 reverse
+) {
+    while( len > SORT_INSERTION_THRESHOLD ) {
+        if( !depth ) {
+            internal_sort_heapsort_i32( len, buffer, reverse );
+            return;
+        }
+        depth--;
+
+        isize p = internal_sort_partition_i32( len, buffer, reverse );
+        if( p == nth ) {
+            return;
+        }
+        if( nth < p ) {
+            len = p;
+        } else {
+            buffer += p + 1;
+            nth    -= p + 1;
+            len    -= p + 1;
+        }
+    }
+    internal_sort_small_i32( len, buffer, reverse );
+}
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+attr_always_inline inline attr_internal
+u32 internal_top_k_mask_i32( const i32* buffer, i32 threshold, b32 reverse ) {
+    __m128i t = _mm_set1_epi32( threshold );
+    __m128i a = _mm_loadu_si128( (const __m128i*)buffer );
+    __m128i b = _mm_loadu_si128( (const __m128i*)(buffer + 4) );
+    if( reverse ) {
+        a = _mm_cmpgt_epi32( a, t );
+        b = _mm_cmpgt_epi32( b, t );
+    } else {
+        a = _mm_cmplt_epi32( a, t );
+        b = _mm_cmplt_epi32( b, t );
+    }
+    return
+        (u32)_mm_movemask_ps( _mm_castsi128_ps( a ) ) |
+        ((u32)_mm_movemask_ps( _mm_castsi128_ps( b ) ) << 4);
+}
+#endif
+attr_core_api
+void select_nth_i32( usize len, i32* buffer, usize nth, b32 reverse ) {
+    if( nth >= len || len < 2 ) {
+        return;
+    }
+    internal_sort_select_i32(
+        (isize)len, buffer, (isize)nth, internal_sort_depth_limit( (isize)len ), reverse );
+}
+attr_core_api
+void partial_sort_i32( usize len, i32* buffer, usize count, b32 reverse ) {
+    if( count > len ) {
+        count = len;
+    }
+    if( count < len ) {
+        select_nth_i32( len, buffer, count, reverse );
+    }
+    internal_sort_introsort_i32(
+        (isize)count, buffer, internal_sort_depth_limit( (isize)count ), reverse );
+}
+attr_core_api
+usize top_k_i32(
+    usize len, const i32* buffer, usize k, i32* out_top, b32 reverse
+) {
+    if( k > len ) {
+        k = len;
+    }
+    if( !k ) {
+        return 0;
+    }
+    memory_copy( out_top, buffer, sizeof(i32) * k );
+    for( isize i = ((isize)k / 2) - 1; i >= 0; --i ) {
+        internal_sort_sift_down_i32( i, (isize)k, out_top, reverse );
+    }
+
+    usize i = k;
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+    for( ; (i + 8) <= len; i += 8 ) {
+        u32 mask = internal_top_k_mask_i32( buffer + i, out_top[0], reverse );
+        while( mask ) {
+            i32 value = buffer[i + internal_bits_ctz32( mask )];
+            mask &= mask - 1;
+            // NOTE(alicia): threshold may have tightened since mask was taken.
+            if( internal_sort_less_i32( value, out_top[0], reverse ) ) {
+                out_top[0] = value;
+                internal_sort_sift_down_i32( 0, (isize)k, out_top, reverse );
+            }
+        }
+    }
+#endif
+    for( ; i < len; ++i ) {
+        if( internal_sort_less_i32( buffer[i], out_top[0], reverse ) ) {
+            out_top[0] = buffer[i];
+            internal_sort_sift_down_i32( 0, (isize)k, out_top, reverse );
+        }
+    }
+
+    internal_sort_introsort_i32(
+        (isize)k, out_top, internal_sort_depth_limit( (isize)k ), reverse );
+    return k;
+}
+attr_internal
+void internal_sort_select_u32(
+    isize len, u32* buffer, isize nth, usize depth, b32 reverse
+) {
+    while( len > SORT_INSERTION_THRESHOLD ) {
+        if( !depth ) {
+            internal_sort_heapsort_u32( len, buffer, reverse );
+            return;
+        }
+        depth--;
+
+        isize p = internal_sort_partition_u32( len, buffer, reverse );
+        if( p == nth ) {
+            return;
+        }
+        if( nth < p ) {
+            len = p;
+        } else {
+            buffer += p + 1;
+            nth    -= p + 1;
+            len    -= p + 1;
+        }
+    }
+    internal_sort_small_u32( len, buffer, reverse );
+}
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+attr_always_inline inline attr_internal
+u32 internal_top_k_mask_u32( const u32* buffer, u32 threshold, b32 reverse ) {
+    // NOTE(alicia): SSE2 only has signed compares,
+    // flipping sign bit maps unsigned order onto signed order.
+    __m128i sign = _mm_set1_epi32( (int)0x80000000u );
+    __m128i t    = _mm_xor_si128( _mm_set1_epi32( (int)threshold ), sign );
+    __m128i a    = _mm_xor_si128( _mm_loadu_si128( (const __m128i*)buffer ), sign );
+    __m128i b    = _mm_xor_si128( _mm_loadu_si128( (const __m128i*)(buffer + 4) ), sign );
+    if( reverse ) {
+        a = _mm_cmpgt_epi32( a, t );
+        b = _mm_cmpgt_epi32( b, t );
+    } else {
+        a = _mm_cmplt_epi32( a, t );
+        b = _mm_cmplt_epi32( b, t );
+    }
+    return
+        (u32)_mm_movemask_ps( _mm_castsi128_ps( a ) ) |
+        ((u32)_mm_movemask_ps( _mm_castsi128_ps( b ) ) << 4);
+}
+#endif
+attr_core_api
+void select_nth_u32( usize len, u32* buffer, usize nth, b32 reverse ) {
+    if( nth >= len || len < 2 ) {
+        return;
+    }
+    internal_sort_select_u32(
+        (isize)len, buffer, (isize)nth, internal_sort_depth_limit( (isize)len ), reverse );
+}
+attr_core_api
+void partial_sort_u32( usize len, u32* buffer, usize count, b32 reverse ) {
+    if( count > len ) {
+        count = len;
+    }
+    if( count < len ) {
+        select_nth_u32( len, buffer, count, reverse );
+    }
+    internal_sort_introsort_u32(
+        (isize)count, buffer, internal_sort_depth_limit( (isize)count ), reverse );
+}
+attr_core_api
+usize top_k_u32(
+    usize len, const u32* buffer, usize k, u32* out_top, b32 reverse
+) {
+    if( k > len ) {
+        k = len;
+    }
+    if( !k ) {
+        return 0;
+    }
+    memory_copy( out_top, buffer, sizeof(u32) * k );
+    for( isize i = ((isize)k / 2) - 1; i >= 0; --i ) {
+        internal_sort_sift_down_u32( i, (isize)k, out_top, reverse );
+    }
+
+    usize i = k;
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+    for( ; (i + 8) <= len; i += 8 ) {
+        u32 mask = internal_top_k_mask_u32( buffer + i, out_top[0], reverse );
+        while( mask ) {
+            u32 value = buffer[i + internal_bits_ctz32( mask )];
+            mask &= mask - 1;
+            // NOTE(alicia): threshold may have tightened since mask was taken.
+            if( internal_sort_less_u32( value, out_top[0], reverse ) ) {
+                out_top[0] = value;
+                internal_sort_sift_down_u32( 0, (isize)k, out_top, reverse );
+            }
+        }
+    }
+#endif
+    for( ; i < len; ++i ) {
+        if( internal_sort_less_u32( buffer[i], out_top[0], reverse ) ) {
+            out_top[0] = buffer[i];
+            internal_sort_sift_down_u32( 0, (isize)k, out_top, reverse );
+        }
+    }
+
+    internal_sort_introsort_u32(
+        (isize)k, out_top, internal_sort_depth_limit( (isize)k ), reverse );
+    return k;
+}
+attr_internal
+void internal_sort_select_f32(
+    isize len, f32* buffer, isize nth, usize depth, b32 reverse
+) {
+    while( len > SORT_INSERTION_THRESHOLD ) {
+        if( !depth ) {
+            internal_sort_heapsort_f32( len, buffer, reverse );
+            return;
+        }
+        depth--;
+
+        isize p = internal_sort_partition_f32( len, buffer, reverse );
+        if( p == nth ) {
+            return;
+        }
+        if( nth < p ) {
+            len = p;
+        } else {
+            buffer += p + 1;
+            nth    -= p + 1;
+            len    -= p + 1;
+        }
+    }
+    internal_sort_small_f32( len, buffer, reverse );
+}
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+attr_always_inline inline attr_internal
+u32 internal_top_k_mask_f32( const f32* buffer, f32 threshold, b32 reverse ) {
+    __m128 t = _mm_set1_ps( threshold );
+    __m128 a = _mm_loadu_ps( buffer );
+    __m128 b = _mm_loadu_ps( buffer + 4 );
+    if( reverse ) {
+        a = _mm_cmpgt_ps( a, t );
+        b = _mm_cmpgt_ps( b, t );
+    } else {
+        a = _mm_cmplt_ps( a, t );
+        b = _mm_cmplt_ps( b, t );
+    }
+    return (u32)_mm_movemask_ps( a ) | ((u32)_mm_movemask_ps( b ) << 4);
+}
+#endif
+attr_core_api
+void select_nth_f32( usize len, f32* buffer, usize nth, b32 reverse ) {
+    if( nth >= len || len < 2 ) {
+        return;
+    }
+    internal_sort_select_f32(
+        (isize)len, buffer, (isize)nth, internal_sort_depth_limit( (isize)len ), reverse );
+}
+attr_core_api
+void partial_sort_f32( usize len, f32* buffer, usize count, b32 reverse ) {
+    if( count > len ) {
+        count = len;
+    }
+    if( count < len ) {
+        select_nth_f32( len, buffer, count, reverse );
+    }
+    internal_sort_introsort_f32(
+        (isize)count, buffer, internal_sort_depth_limit( (isize)count ), reverse );
+}
+attr_core_api
+usize top_k_f32(
+    usize len, const f32* buffer, usize k, f32* out_top, b32 reverse
+) {
+    if( k > len ) {
+        k = len;
+    }
+    if( !k ) {
+        return 0;
+    }
+    memory_copy( out_top, buffer, sizeof(f32) * k );
+    for( isize i = ((isize)k / 2) - 1; i >= 0; --i ) {
+        internal_sort_sift_down_f32( i, (isize)k, out_top, reverse );
+    }
+
+    usize i = k;
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+    for( ; (i + 8) <= len; i += 8 ) {
+        u32 mask = internal_top_k_mask_f32( buffer + i, out_top[0], reverse );
+        while( mask ) {
+            f32 value = buffer[i + internal_bits_ctz32( mask )];
+            mask &= mask - 1;
+            // NOTE(alicia): threshold may have tightened since mask was taken.
+            if( internal_sort_less_f32( value, out_top[0], reverse ) ) {
+                out_top[0] = value;
+                internal_sort_sift_down_f32( 0, (isize)k, out_top, reverse );
+            }
+        }
+    }
+#endif
+    for( ; i < len; ++i ) {
+        if( internal_sort_less_f32( buffer[i], out_top[0], reverse ) ) {
+            out_top[0] = buffer[i];
+            internal_sort_sift_down_f32( 0, (isize)k, out_top, reverse );
+        }
+    }
+
+    internal_sort_introsort_f32(
+        (isize)k, out_top, internal_sort_depth_limit( (isize)k ), reverse );
+    return k;
+}
+
+#define SELECT_AT( index ) (bytes + ((index) * stride))
+
+attr_core_api
+void select_nth_generic(
+    usize len, usize stride, void* buffer, usize nth,
+    SortCmpFN* cmp_fn, void* opt_cmp_params, void* swap_buffer
+) {
+    if( nth >= len || len < 2 ) {
+        return;
+    }
+    u8*   bytes  = buffer;
+    isize n      = (isize)len;
+    isize target = (isize)nth;
+    usize depth  = internal_sort_depth_limit( n );
+    while( n > SORT_INSERTION_THRESHOLD ) {
+        if( !depth ) {
+            internal_sort_heapsort_generic(
+                n, stride, bytes, cmp_fn, opt_cmp_params, swap_buffer );
+            return;
+        }
+        depth--;
+
+        isize p = internal_sort_partition_generic(
+            n, stride, bytes, cmp_fn, opt_cmp_params, swap_buffer );
+        if( p == target ) {
+            return;
+        }
+        if( target < p ) {
+            n = p;
+        } else {
+            bytes  += (p + 1) * stride;
+            target -= p + 1;
+            n      -= p + 1;
+        }
+    }
+    internal_sort_insertion_generic(
+        n, stride, bytes, cmp_fn, opt_cmp_params, swap_buffer );
+}
+attr_core_api
+void partial_sort_generic(
+    usize len, usize stride, void* buffer, usize count,
+    SortCmpFN* cmp_fn, void* opt_cmp_params, void* swap_buffer
+) {
+    if( count > len ) {
+        count = len;
+    }
+    if( count < len ) {
+        select_nth_generic(
+            len, stride, buffer, count, cmp_fn, opt_cmp_params, swap_buffer );
+    }
+    internal_sort_introsort_generic(
+        (isize)count, stride, buffer, internal_sort_depth_limit( (isize)count ),
+        cmp_fn, opt_cmp_params, swap_buffer );
+}
+attr_core_api
+usize top_k_generic(
+    usize len, usize stride, const void* buffer, usize k, void* out_top,
+    SortCmpFN* cmp_fn, void* opt_cmp_params, void* swap_buffer
+) {
+    if( k > len ) {
+        k = len;
+    }
+    if( !k ) {
+        return 0;
+    }
+    const u8* bytes = buffer;
+    u8*       top   = out_top;
+    memory_copy( top, bytes, stride * k );
+    for( isize i = ((isize)k / 2) - 1; i >= 0; --i ) {
+        internal_sort_sift_down_generic(
+            i, (isize)k, stride, top, cmp_fn, opt_cmp_params, swap_buffer );
+    }
+    for( usize i = k; i < len; ++i ) {
+        if( cmp_fn( (void*)SELECT_AT( i ), top, stride, opt_cmp_params ) ) {
+            internal_sort_copy( top, SELECT_AT( i ), stride );
+            internal_sort_sift_down_generic(
+                0, (isize)k, stride, top, cmp_fn, opt_cmp_params, swap_buffer );
+        }
+    }
+    internal_sort_introsort_generic(
+        (isize)k, stride, top, internal_sort_depth_limit( (isize)k ),
+        cmp_fn, opt_cmp_params, swap_buffer );
+    return k;
+}
+
+#undef SELECT_AT
+
+struct InternalMergeSort {
+    usize      stride;
+    u8*        buffer;
+    /// @brief Holds the smaller run while merging.
+    u8*        temp;
+    /// @brief Holds one item.
+    u8*        swap_buffer;
+    SortCmpFN* cmp_fn;
+    void*      cmp_params;
+    usize      run_count;
+    usize      run_base[MERGE_SORT_MAX_RUNS];
+    usize      run_len[MERGE_SORT_MAX_RUNS];
+};
+
+#define MSORT_AT( index )  (ms->buffer + ((index) * ms->stride))
+#define MSORT_TEMP( index ) (ms->temp + ((index) * ms->stride))
+#define MSORT_LESS( a, b ) ms->cmp_fn( (a), (b), ms->stride, ms->cmp_params )
+
+/// @brief Sort [from, to) where [from, start) is already sorted.
+attr_internal
+void internal_merge_sort_insertion(
+    struct InternalMergeSort* ms, usize from, usize start, usize to
+) {
+    for( usize i = start; i < to; ++i ) {
+        internal_sort_copy( ms->swap_buffer, MSORT_AT( i ), ms->stride );
+
+        // NOTE(alicia): upper bound so that equal items keep their order.
+        usize left = from, right = i;
+        while( left < right ) {
+            usize mid = left + ((right - left) / 2);
+            if( MSORT_LESS( ms->swap_buffer, MSORT_AT( mid ) ) ) {
+                right = mid;
+            } else {
+                left = mid + 1;
+            }
+        }
+        if( left != i ) {
+            memory_move( MSORT_AT( left + 1 ), MSORT_AT( left ), (i - left) * ms->stride );
+            internal_sort_copy( MSORT_AT( left ), ms->swap_buffer, ms->stride );
+        }
+    }
+}
+/// @brief Find length of run starting at @c from and make it ascending.
+attr_internal
+usize internal_merge_sort_count_run(
+    struct InternalMergeSort* ms, usize from, usize to
+) {
+    usize next = from + 1;
+    if( next == to ) {
+        return 1;
+    }
+    if( MSORT_LESS( MSORT_AT( next ), MSORT_AT( from ) ) ) {
+        // NOTE(alicia): descending runs must be strictly
+        // descending, otherwise reversing would not be stable.
+        next++;
+        while( next < to && MSORT_LESS( MSORT_AT( next ), MSORT_AT( next - 1 ) ) ) {
+            next++;
+        }
+        sort_reverse( next - from, ms->stride, MSORT_AT( from ), ms->swap_buffer );
+    } else {
+        next++;
+        while( next < to && !MSORT_LESS( MSORT_AT( next ), MSORT_AT( next - 1 ) ) ) {
+            next++;
+        }
+    }
+    return next - from;
+}
+attr_internal
+usize internal_merge_sort_min_run( usize len ) {
+    usize r = 0;
+    while( len >= MERGE_SORT_MIN_MERGE ) {
+        r   |= len & 1;
+        len >>= 1;
+    }
+    return len + r;
+}
+attr_internal
+void internal_merge_sort_merge_at( struct InternalMergeSort* ms, usize at ) {
+    usize base1 = ms->run_base[at];
+    usize len1  = ms->run_len[at];
+    usize base2 = ms->run_base[at + 1];
+    usize len2  = ms->run_len[at + 1];
+
+    ms->run_len[at] = len1 + len2;
+    if( at + 3 == ms->run_count ) {
+        ms->run_base[at + 1] = ms->run_base[at + 2];
+        ms->run_len[at + 1]  = ms->run_len[at + 2];
+    }
+    ms->run_count--;
+
+    // NOTE(alicia): items at start of left run that are not greater than
+    // first item of right run and items at end of right run that are not
+    // less than last item of left run are already in place.
+    usize left = base1, right = base1 + len1;
+    while( left < right ) {
+        usize mid = left + ((right - left) / 2);
+        if( MSORT_LESS( MSORT_AT( base2 ), MSORT_AT( mid ) ) ) {
+            right = mid;
+        } else {
+            left = mid + 1;
+        }
+    }
+    len1 -= left - base1;
+    base1 = left;
+    if( !len1 ) {
+        return;
+    }
+
+    left = base2, right = base2 + len2;
+    while( left < right ) {
+        usize mid = left + ((right - left) / 2);
+        if( MSORT_LESS( MSORT_AT( mid ), MSORT_AT( base1 + len1 - 1 ) ) ) {
+            left = mid + 1;
+        } else {
+            right = mid;
+        }
+    }
+    len2 = left - base2;
+    if( !len2 ) {
+        return;
+    }
+
+    if( len1 <= len2 ) {
+        memory_copy( ms->temp, MSORT_AT( base1 ), len1 * ms->stride );
+        usize i = 0, j = base2, dst = base1;
+        while( i < len1 && j < base2 + len2 ) {
+            if( MSORT_LESS( MSORT_AT( j ), MSORT_TEMP( i ) ) ) {
+                internal_sort_copy( MSORT_AT( dst ), MSORT_AT( j ), ms->stride );
+                j++;
+            } else {
+                internal_sort_copy( MSORT_AT( dst ), MSORT_TEMP( i ), ms->stride );
+                i++;
+            }
+            dst++;
+        }
+        if( i < len1 ) {
+            memory_copy( MSORT_AT( dst ), MSORT_TEMP( i ), (len1 - i) * ms->stride );
+        }
+    } else {
+        memory_copy( ms->temp, MSORT_AT( base2 ), len2 * ms->stride );
+        isize i   = (isize)len2 - 1;
+        isize j   = (isize)(base1 + len1) - 1;
+        isize dst = (isize)(base2 + len2) - 1;
+        while( i >= 0 && j >= (isize)base1 ) {
+            if( MSORT_LESS( MSORT_TEMP( i ), MSORT_AT( j ) ) ) {
+                internal_sort_copy( MSORT_AT( dst ), MSORT_AT( j ), ms->stride );
+                j--;
+            } else {
+                internal_sort_copy( MSORT_AT( dst ), MSORT_TEMP( i ), ms->stride );
+                i--;
+            }
+            dst--;
+        }
+        if( i >= 0 ) {
+            memory_copy( MSORT_AT( base1 ), ms->temp, (usize)(i + 1) * ms->stride );
+        }
+    }
+}
+/// @brief Merge runs until run lengths satisfy TimSort invariants.
+attr_internal
+void internal_merge_sort_collapse( struct InternalMergeSort* ms ) {
+    usize* len = ms->run_len;
+    while( ms->run_count > 1 ) {
+        usize n = ms->run_count - 2;
+        if(
+            (n > 0 && len[n - 1] <= len[n] + len[n + 1]) ||
+            (n > 1 && len[n - 2] <= len[n] + len[n - 1])
+        ) {
+            if( len[n - 1] < len[n + 1] ) {
+                n--;
+            }
+        } else if( len[n] > len[n + 1] ) {
+            break;
+        }
+        internal_merge_sort_merge_at( ms, n );
+    }
+}
+
+#undef MSORT_AT
+#undef MSORT_TEMP
+#undef MSORT_LESS
+
+attr_core_api
+b32 merge_sort_generic(
+    struct AllocatorInterface* allocator, usize len,
+    usize stride, void* buffer,
+    SortCmpFN* cmp, void* opt_cmp_params
+) {
+    if( len < 2 ) {
+        return true;
+    }
+
+    usize temp_size = ((len / 2) + 1) * stride;
+    u8*   temp      = allocator_alloc( allocator, temp_size );
+    if( !temp ) {
+        return false;
+    }
+
+    struct InternalMergeSort ms;
+    ms.stride      = stride;
+    ms.buffer      = buffer;
+    ms.temp        = temp + stride;
+    ms.swap_buffer = temp;
+    ms.cmp_fn      = cmp;
+    ms.cmp_params  = opt_cmp_params;
+    ms.run_count   = 0;
+
+    if( len < MERGE_SORT_MIN_MERGE ) {
+        usize run = internal_merge_sort_count_run( &ms, 0, len );
+        internal_merge_sort_insertion( &ms, 0, run, len );
+        allocator_free( allocator, temp, temp_size );
+        return true;
+    }
+
+    usize min_run = internal_merge_sort_min_run( len );
+    usize from    = 0;
+    while( from < len ) {
+        usize run = internal_merge_sort_count_run( &ms, from, len );
+        if( run < min_run ) {
+            usize forced = (len - from) < min_run ? (len - from) : min_run;
+            internal_merge_sort_insertion( &ms, from, from + run, from + forced );
+            run = forced;
+        }
+
+        ms.run_base[ms.run_count] = from;
+        ms.run_len[ms.run_count]  = run;
+        ms.run_count++;
+        internal_merge_sort_collapse( &ms );
+
+        from += run;
+    }
+    while( ms.run_count > 1 ) {
+        usize n = ms.run_count - 2;
+        if( n > 0 && ms.run_len[n - 1] < ms.run_len[n + 1] ) {
+            n--;
+        }
+        internal_merge_sort_merge_at( &ms, n );
+    }
+
+    allocator_free( allocator, temp, temp_size );
+    return true;
+}
+
+struct InternalSortIndices {
+    const u8*  buffer;
+    usize      stride;
+    SortCmpFN* cmp_fn;
+    void*      cmp_params;
+};
+attr_internal
+b32 internal_sort_indices_cmp( void* lhs, void* rhs, usize size, void* params ) {
+    unused( size );
+    struct InternalSortIndices* indices = params;
+    return indices->cmp_fn(
+        (void*)(indices->buffer + (*(usize*)lhs * indices->stride)),
+        (void*)(indices->buffer + (*(usize*)rhs * indices->stride)),
+        indices->stride, indices->cmp_params );
+}
+
+attr_core_api
+b32 sort_indices_generic(
+    struct AllocatorInterface* allocator, usize len,
+    usize stride, const void* buffer,
+    SortCmpFN* cmp, void* opt_cmp_params, usize* out_indices
+) {
+    for( usize i = 0; i < len; ++i ) {
+        out_indices[i] = i;
+    }
+    struct InternalSortIndices params;
+    params.buffer     = buffer;
+    params.stride     = stride;
+    params.cmp_fn     = cmp;
+    params.cmp_params = opt_cmp_params;
+    return merge_sort_generic(
+        allocator, len, sizeof(usize), out_indices,
+        internal_sort_indices_cmp, &params );
+}
+attr_core_api
+void sort_apply_indices(
+    usize len, usize stride, void* buffer, usize* indices, void* swap_buffer
+) {
+    u8* bytes = buffer;
+    // NOTE(alicia): follow each cycle of the permutation,
+    // indices that are done are set to their own position.
+    for( usize i = 0; i < len; ++i ) {
+        if( indices[i] == i ) {
+            continue;
+        }
+        memory_copy( swap_buffer, bytes + (i * stride), stride );
+        usize j = i;
+        for( ;; ) {
+            usize k    = indices[j];
+            indices[j] = j;
+            if( k == i ) {
+                memory_copy( bytes + (j * stride), swap_buffer, stride );
+                break;
+            }
+            memory_copy( bytes + (j * stride), bytes + (k * stride), stride );
+            j = k;
+        }
+    }
+}
+
+/// @brief Map 32-bit value to key that sorts correctly as unsigned integer.
+attr_always_inline inline attr_internal
+u32 internal_radix_key_32( u32 x, enum InternalRadixKey kind, u32 flip ) {
+    switch( kind ) {
+        case INTERNAL_RADIX_KEY_UNSIGNED: break;
+        case INTERNAL_RADIX_KEY_SIGNED: {
+            x ^= 0x80000000u;
+        } break;
+        case INTERNAL_RADIX_KEY_FLOAT: {
+            // NOTE(alicia): negative floats have all bits flipped
+            // so that larger magnitude sorts first.
+            x ^= (x & 0x80000000u) ? 0xFFFFFFFFu : 0x80000000u;
+        } break;
+    }
+    return x ^ flip;
+}
+/// @brief Inverse of #internal_radix_key_32().
+attr_always_inline inline attr_internal
+u32 internal_radix_value_32( u32 x, enum InternalRadixKey kind, u32 flip ) {
+    x ^= flip;
+    switch( kind ) {
+        case INTERNAL_RADIX_KEY_UNSIGNED: break;
+        case INTERNAL_RADIX_KEY_SIGNED: {
+            x ^= 0x80000000u;
+        } break;
+        case INTERNAL_RADIX_KEY_FLOAT: {
+            x ^= (x & 0x80000000u) ? 0x80000000u : 0xFFFFFFFFu;
+        } break;
+    }
+    return x;
+}
+attr_internal
+b32 internal_radix_sort_32(
+    struct AllocatorInterface* allocator, usize len,
+    u32* keys, u32* opt_values, enum InternalRadixKey kind, b32 reverse
+) {
+    if( len < 2 ) {
+        return true;
+    }
+
+    usize histogram_size = sizeof(usize) * RADIX_DIGIT_COUNT * RADIX_PASSES_32;
+    usize scratch_size   = histogram_size + (sizeof(u32) * len);
+    if( opt_values ) {
+        scratch_size += sizeof(u32) * len;
+    }
+    usize* histograms = allocator_alloc( allocator, scratch_size );
+    if( !histograms ) {
+        return false;
+    }
+    u32* scratch_keys   = (u32*)((u8*)histograms + histogram_size);
+    u32* scratch_values = opt_values ? scratch_keys + len : NULL;
+
+    u32 flip = reverse ? 0xFFFFFFFFu : 0;
+
+    // NOTE(alicia): map keys and count every digit in a single pass.
+    for( usize i = 0; i < len; ++i ) {
+        u32 key = internal_radix_key_32( keys[i], kind, flip );
+        keys[i] = key;
+        for( usize pass = 0; pass < RADIX_PASSES_32; ++pass ) {
+            histograms[
+                (pass * RADIX_DIGIT_COUNT) +
+                ((key >> (pass * RADIX_DIGIT_BITS)) & RADIX_DIGIT_MASK)]++;
+        }
+    }
+
+    u32* src_keys   = keys;
+    u32* src_values = opt_values;
+    u32* dst_keys   = scratch_keys;
+    u32* dst_values = scratch_values;
+    for( usize pass = 0; pass < RADIX_PASSES_32; ++pass ) {
+        usize* histogram = histograms + (pass * RADIX_DIGIT_COUNT);
+        u32 shift        = (u32)(pass * RADIX_DIGIT_BITS);
+
+        // NOTE(alicia): every key has the same digit, pass would not move anything.
+        if( histogram[(src_keys[0] >> shift) & RADIX_DIGIT_MASK] == len ) {
+            continue;
+        }
+
+        usize sum = 0;
+        for( usize digit = 0; digit < RADIX_DIGIT_COUNT; ++digit ) {
+            usize count      = histogram[digit];
+            histogram[digit] = sum;
+            sum             += count;
+        }
+
+        if( src_values ) {
+            for( usize i = 0; i < len; ++i ) {
+                u32 key   = src_keys[i];
+                usize dst = histogram[(key >> shift) & RADIX_DIGIT_MASK]++;
+                dst_keys[dst]   = key;
+                dst_values[dst] = src_values[i];
+            }
+        } else {
+            for( usize i = 0; i < len; ++i ) {
+                u32 key = src_keys[i];
+                dst_keys[histogram[(key >> shift) & RADIX_DIGIT_MASK]++] = key;
+            }
+        }
+
+        u32* temp  = src_keys;
+        src_keys   = dst_keys;
+        dst_keys   = temp;
+        temp       = src_values;
+        src_values = dst_values;
+        dst_values = temp;
+    }
+
+    if( src_keys != keys ) {
+        memory_copy( keys, src_keys, sizeof(u32) * len );
+        if( opt_values ) {
+            memory_copy( opt_values, src_values, sizeof(u32) * len );
+        }
+    }
+    for( usize i = 0; i < len; ++i ) {
+        keys[i] = internal_radix_value_32( keys[i], kind, flip );
+    }
+
+    allocator_free( allocator, histograms, scratch_size );
+    return true;
+}
+attr_internal
+b32 internal_radix_sort_64(
+    struct AllocatorInterface* allocator, usize len,
+    u64* keys, u32* opt_values, b32 reverse
+) {
+    if( len < 2 ) {
+        return true;
+    }
+
+    usize histogram_size = sizeof(usize) * RADIX_DIGIT_COUNT * RADIX_PASSES_64;
+    usize scratch_size   = histogram_size + (sizeof(u64) * len);
+    if( opt_values ) {
+        scratch_size += sizeof(u32) * len;
+    }
+    usize* histograms = allocator_alloc( allocator, scratch_size );
+    if( !histograms ) {
+        return false;
+    }
+    u64* scratch_keys   = (u64*)((u8*)histograms + histogram_size);
+    u32* scratch_values = opt_values ? (u32*)(scratch_keys + len) : NULL;
+
+    u64 flip = reverse ? 0xFFFFFFFFFFFFFFFFull : 0;
+
+    for( usize i = 0; i < len; ++i ) {
+        u64 key = keys[i] ^ flip;
+        keys[i] = key;
+        for( usize pass = 0; pass < RADIX_PASSES_64; ++pass ) {
+            histograms[
+                (pass * RADIX_DIGIT_COUNT) +
+                ((key >> (pass * RADIX_DIGIT_BITS)) & RADIX_DIGIT_MASK)]++;
+        }
+    }
+
+    u64* src_keys   = keys;
+    u32* src_values = opt_values;
+    u64* dst_keys   = scratch_keys;
+    u32* dst_values = scratch_values;
+    for( usize pass = 0; pass < RADIX_PASSES_64; ++pass ) {
+        usize* histogram = histograms + (pass * RADIX_DIGIT_COUNT);
+        u64 shift        = pass * RADIX_DIGIT_BITS;
+
+        if( histogram[(src_keys[0] >> shift) & RADIX_DIGIT_MASK] == len ) {
+            continue;
+        }
+
+        usize sum = 0;
+        for( usize digit = 0; digit < RADIX_DIGIT_COUNT; ++digit ) {
+            usize count      = histogram[digit];
+            histogram[digit] = sum;
+            sum             += count;
+        }
+
+        if( src_values ) {
+            for( usize i = 0; i < len; ++i ) {
+                u64 key   = src_keys[i];
+                usize dst = histogram[(key >> shift) & RADIX_DIGIT_MASK]++;
+                dst_keys[dst]   = key;
+                dst_values[dst] = src_values[i];
+            }
+        } else {
+            for( usize i = 0; i < len; ++i ) {
+                u64 key = src_keys[i];
+                dst_keys[histogram[(key >> shift) & RADIX_DIGIT_MASK]++] = key;
+            }
+        }
+
+        u64* temp_keys = src_keys;
+        src_keys       = dst_keys;
+        dst_keys       = temp_keys;
+        u32* temp      = src_values;
+        src_values     = dst_values;
+        dst_values     = temp;
+    }
+
+    if( src_keys != keys ) {
+        memory_copy( keys, src_keys, sizeof(u64) * len );
+        if( opt_values ) {
+            memory_copy( opt_values, src_values, sizeof(u32) * len );
+        }
+    }
+    if( flip ) {
+        for( usize i = 0; i < len; ++i ) {
+            keys[i] ^= flip;
+        }
+    }
+
+    allocator_free( allocator, histograms, scratch_size );
+    return true;
+}
+
+attr_core_api
+b32 radix_sort_u32(
+    struct AllocatorInterface* allocator, usize len, u32* buffer, b32 reverse
+) {
+    return internal_radix_sort_32(
+        allocator, len, buffer, NULL, INTERNAL_RADIX_KEY_UNSIGNED, reverse );
+}
+attr_core_api
+b32 radix_sort_i32(
+    struct AllocatorInterface* allocator, usize len, i32* buffer, b32 reverse
+) {
+    return internal_radix_sort_32(
+        allocator, len, (u32*)buffer, NULL, INTERNAL_RADIX_KEY_SIGNED, reverse );
+}
+attr_core_api
+b32 radix_sort_f32(
+    struct AllocatorInterface* allocator, usize len, f32* buffer, b32 reverse
+) {
+    return internal_radix_sort_32(
+        allocator, len, (u32*)buffer, NULL, INTERNAL_RADIX_KEY_FLOAT, reverse );
+}
+attr_core_api
+b32 radix_sort_u64(
+    struct AllocatorInterface* allocator, usize len, u64* buffer, b32 reverse
+) {
+    return internal_radix_sort_64( allocator, len, buffer, NULL, reverse );
+}
+attr_core_api
+b32 radix_sort_kv_u32(
+    struct AllocatorInterface* allocator, usize len,
+    u32* keys, u32* values, b32 reverse
+) {
+    return internal_radix_sort_32(
+        allocator, len, keys, values, INTERNAL_RADIX_KEY_UNSIGNED, reverse );
+}
+attr_core_api
+b32 radix_sort_kv_i32(
+    struct AllocatorInterface* allocator, usize len,
+    i32* keys, u32* values, b32 reverse
+) {
+    return internal_radix_sort_32(
+        allocator, len, (u32*)keys, values, INTERNAL_RADIX_KEY_SIGNED, reverse );
+}
+attr_core_api
+b32 radix_sort_kv_f32(
+    struct AllocatorInterface* allocator, usize len,
+    f32* keys, u32* values, b32 reverse
+) {
+    return internal_radix_sort_32(
+        allocator, len, (u32*)keys, values, INTERNAL_RADIX_KEY_FLOAT, reverse );
+}
+attr_core_api
+b32 radix_sort_kv_u64(
+    struct AllocatorInterface* allocator, usize len,
+    u64* keys, u32* values, b32 reverse
+) {
+    return internal_radix_sort_64( allocator, len, keys, values, reverse );
+}
+
+enum InternalParallelSortKind {
+    INTERNAL_PARALLEL_SORT_I32,
+    INTERNAL_PARALLEL_SORT_U32,
+    INTERNAL_PARALLEL_SORT_F32,
+    INTERNAL_PARALLEL_SORT_GENERIC,
+};
+enum InternalParallelSortPhase {
+    INTERNAL_PARALLEL_SORT_PHASE_SORT,
+    INTERNAL_PARALLEL_SORT_PHASE_MERGE,
+    INTERNAL_PARALLEL_SORT_PHASE_COPY,
+};
+struct InternalParallelSort {
+    enum InternalParallelSortKind  kind;
+    enum InternalParallelSortPhase phase;
+    b32        reverse;
+    usize      len;
+    usize      stride;
+    u8*        buffer;
+    u8*        scratch;
+    SortCmpFN* cmp_fn;
+    void*      cmp_params;
+    /// @brief cmp_fn returns true for equal items (<=).
+    b32        cmp_non_strict;
+    u32        thread_count;
+    /// @brief Start of each chunk, thread_count + 1 items.
+    usize*     chunks;
+};
+struct InternalParallelSortTask {
+    struct InternalParallelSort* sort;
+    u32    index;
+    /// @brief thread_count items each.
+    usize* from;
+    usize* to;
+    u32*   heap;
+    /// @brief stride bytes.
+    u8*    swap_buffer;
+};
+
+#define PSORT_AT( index ) (sort->buffer + ((index) * sort->stride))
+
+attr_always_inline inline attr_internal
+b32 internal_parallel_sort_less(
+    struct InternalParallelSort* sort, const u8* a, const u8* b
+) {
+    switch( sort->kind ) {
+        case INTERNAL_PARALLEL_SORT_I32:
+            return internal_sort_less_i32( *(const i32*)a, *(const i32*)b, sort->reverse );
+        case INTERNAL_PARALLEL_SORT_U32:
+            return internal_sort_less_u32( *(const u32*)a, *(const u32*)b, sort->reverse );
+        case INTERNAL_PARALLEL_SORT_F32:
+            return internal_sort_less_f32( *(const f32*)a, *(const f32*)b, sort->reverse );
+        case INTERNAL_PARALLEL_SORT_GENERIC:
+            // NOTE(alicia): split and merge need a strict ordering,
+            // a <= b becomes a < b as !(b <= a).
+            if( sort->cmp_non_strict ) {
+                return !sort->cmp_fn( (void*)b, (void*)a, sort->stride, sort->cmp_params );
+            }
+            return sort->cmp_fn( (void*)a, (void*)b, sort->stride, sort->cmp_params );
+    }
+    return false;
+}
+attr_always_inline inline attr_internal
+void internal_parallel_sort_copy(
+    struct InternalParallelSort* sort, u8* dst, const u8* src, usize count
+) {
+    if( sort->kind != INTERNAL_PARALLEL_SORT_GENERIC && count == 1 ) {
+        *(u32*)dst = *(const u32*)src;
+    } else {
+        memory_copy( dst, src, count * sort->stride );
+    }
+}
+/// @brief First index in [from, to) where item is not less than value.
+attr_internal
+usize internal_parallel_sort_lower_bound(
+    struct InternalParallelSort* sort, usize from, usize to, const u8* value
+) {
+    while( from < to ) {
+        usize mid = from + ((to - from) / 2);
+        if( internal_parallel_sort_less( sort, PSORT_AT( mid ), value ) ) {
+            from = mid + 1;
+        } else {
+            to = mid;
+        }
+    }
+    return from;
+}
+/// @brief First index in [from, to) where value is less than item.
+attr_internal
+usize internal_parallel_sort_upper_bound(
+    struct InternalParallelSort* sort, usize from, usize to, const u8* value
+) {
+    while( from < to ) {
+        usize mid = from + ((to - from) / 2);
+        if( internal_parallel_sort_less( sort, value, PSORT_AT( mid ) ) ) {
+            to = mid;
+        } else {
+            from = mid + 1;
+        }
+    }
+    return from;
+}
+/// @brief Find where each sorted chunk splits so that
+/// the first @c rank items of merged output come before the split.
+attr_internal
+void internal_parallel_sort_split(
+    struct InternalParallelSort* sort, usize rank, usize* out_positions
+) {
+    u32 count = sort->thread_count;
+    if( rank == 0 || rank == sort->len ) {
+        for( u32 i = 0; i < count; ++i ) {
+            out_positions[i] = rank ? sort->chunks[i + 1] : sort->chunks[i];
+        }
+        return;
+    }
+
+    // NOTE(alicia): search chunks for an item that has rank
+    // between number of items less than it and number of
+    // items less than or equal to it. Equal items are then
+    // taken from chunks in order so that splits are exact
+    // even when there are many duplicates.
+    for( u32 c = 0; c < count; ++c ) {
+        usize from = sort->chunks[c];
+        usize to   = sort->chunks[c + 1];
+        while( from < to ) {
+            usize mid      = from + ((to - from) / 2);
+            const u8* item = PSORT_AT( mid );
+
+            usize less = 0, less_equal = 0;
+            for( u32 i = 0; i < count; ++i ) {
+                less += internal_parallel_sort_lower_bound(
+                    sort, sort->chunks[i], sort->chunks[i + 1], item ) - sort->chunks[i];
+                less_equal += internal_parallel_sort_upper_bound(
+                    sort, sort->chunks[i], sort->chunks[i + 1], item ) - sort->chunks[i];
+            }
+
+            if( rank < less ) {
+                to = mid;
+            } else if( rank > less_equal ) {
+                from = mid + 1;
+            } else {
+                usize remaining = rank - less;
+                for( u32 i = 0; i < count; ++i ) {
+                    usize lower = internal_parallel_sort_lower_bound(
+                        sort, sort->chunks[i], sort->chunks[i + 1], item );
+                    usize upper = internal_parallel_sort_upper_bound(
+                        sort, lower, sort->chunks[i + 1], item );
+                    usize take  = upper - lower;
+                    if( take > remaining ) {
+                        take = remaining;
+                    }
+                    out_positions[i] = lower + take;
+                    remaining       -= take;
+                }
+                return;
+            }
+        }
+    }
+}
+attr_internal
+void internal_parallel_sort_heap_sift_down(
+    struct InternalParallelSortTask* task, u32 root, u32 len
+) {
+    struct InternalParallelSort* sort = task->sort;
+    for( ;; ) {
+        u32 child = (root * 2) + 1;
+        if( child >= len ) {
+            break;
+        }
+        if(
+            (child + 1) < len &&
+            internal_parallel_sort_less(
+                sort,
+                PSORT_AT( task->from[task->heap[child + 1]] ),
+                PSORT_AT( task->from[task->heap[child]] ) )
+        ) {
+            child++;
+        }
+        if( !internal_parallel_sort_less(
+            sort,
+            PSORT_AT( task->from[task->heap[child]] ),
+            PSORT_AT( task->from[task->heap[root]] ) )
+        ) {
+            break;
+        }
+        u32 temp          = task->heap[root];
+        task->heap[root]  = task->heap[child];
+        task->heap[child] = temp;
+        root = child;
+    }
+}
+attr_internal
+void internal_parallel_sort_merge( struct InternalParallelSortTask* task ) {
+    struct InternalParallelSort* sort = task->sort;
+    usize rank_from = (sort->len * task->index) / sort->thread_count;
+    usize rank_to   = (sort->len * (task->index + 1)) / sort->thread_count;
+
+    internal_parallel_sort_split( sort, rank_from, task->from );
+    internal_parallel_sort_split( sort, rank_to, task->to );
+
+    u32 heap_len = 0;
+    for( u32 i = 0; i < sort->thread_count; ++i ) {
+        if( task->from[i] < task->to[i] ) {
+            task->heap[heap_len++] = i;
+        }
+    }
+    for( u32 i = heap_len / 2; i-- > 0; ) {
+        internal_parallel_sort_heap_sift_down( task, i, heap_len );
+    }
+
+    u8* out = sort->scratch + (rank_from * sort->stride);
+    while( heap_len > 1 ) {
+        u32 run = task->heap[0];
+        internal_parallel_sort_copy( sort, out, PSORT_AT( task->from[run] ), 1 );
+        out += sort->stride;
+
+        if( ++task->from[run] == task->to[run] ) {
+            task->heap[0] = task->heap[--heap_len];
+        }
+        internal_parallel_sort_heap_sift_down( task, 0, heap_len );
+    }
+    if( heap_len ) {
+        u32 run = task->heap[0];
+        memory_copy(
+            out, PSORT_AT( task->from[run] ),
+            (task->to[run] - task->from[run]) * sort->stride );
+    }
+}
+attr_internal
+int internal_parallel_sort_main( u32 thread_id, void* params ) {
+    unused( thread_id );
+    struct InternalParallelSortTask* task = params;
+    struct InternalParallelSort*     sort = task->sort;
+
+    switch( sort->phase ) {
+        case INTERNAL_PARALLEL_SORT_PHASE_SORT: {
+            isize from = (isize)sort->chunks[task->index];
+            isize to   = (isize)sort->chunks[task->index + 1] - 1;
+            switch( sort->kind ) {
+                case INTERNAL_PARALLEL_SORT_I32: {
+                    quicksort_i32( from, to, (i32*)sort->buffer, sort->reverse );
+                } break;
+                case INTERNAL_PARALLEL_SORT_U32: {
+                    quicksort_u32( from, to, (u32*)sort->buffer, sort->reverse );
+                } break;
+                case INTERNAL_PARALLEL_SORT_F32: {
+                    quicksort_f32( from, to, (f32*)sort->buffer, sort->reverse );
+                } break;
+                case INTERNAL_PARALLEL_SORT_GENERIC: {
+                    quicksort_generic(
+                        from, to, sort->stride, sort->buffer,
+                        sort->cmp_fn, sort->cmp_params, task->swap_buffer );
+                } break;
+            }
+        } break;
+        case INTERNAL_PARALLEL_SORT_PHASE_MERGE: {
+            internal_parallel_sort_merge( task );
+        } break;
+        case INTERNAL_PARALLEL_SORT_PHASE_COPY: {
+            usize from = (sort->len * task->index) / sort->thread_count;
+            usize to   = (sort->len * (task->index + 1)) / sort->thread_count;
+            memory_copy(
+                PSORT_AT( from ), sort->scratch + (from * sort->stride),
+                (to - from) * sort->stride );
+        } break;
+    }
+    return 0;
+}
+
+#undef PSORT_AT
+
+attr_internal
+b32 internal_parallel_sort(
+    struct AllocatorInterface* allocator, struct InternalParallelSort* sort,
+    u32 opt_thread_count
+) {
+    u32 thread_count = opt_thread_count;
+    if( !thread_count ) {
+        SystemInfo info;
+        system_query_info( &info );
+        thread_count = info.cpu_count;
+    }
+    if( thread_count > CORE_PARALLEL_SORT_MAX_THREADS ) {
+        thread_count = CORE_PARALLEL_SORT_MAX_THREADS;
+    }
+    if( thread_count > (sort->len / PARALLEL_SORT_MIN_CHUNK) ) {
+        thread_count = (u32)(sort->len / PARALLEL_SORT_MIN_CHUNK);
+    }
+    if( !thread_count ) {
+        thread_count = 1;
+    }
+    sort->thread_count = thread_count;
+
+    usize stride_aligned = (sort->stride + 15) & ~(usize)15;
+    usize task_size      =
+        sizeof(struct InternalParallelSortTask) +
+        (sizeof(usize) * thread_count * 2) + (sizeof(u32) * thread_count);
+    task_size = (task_size + 15) & ~(usize)15;
+
+    usize header_size =
+        (sizeof(usize) * (thread_count + 1) + 15) & ~(usize)15;
+    usize tasks_size  = (task_size + stride_aligned) * thread_count;
+    usize alloc_size  = header_size + tasks_size;
+    if( thread_count > 1 ) {
+        alloc_size += sort->len * sort->stride;
+    }
+
+    u8* memory = allocator_alloc( allocator, alloc_size );
+    if( !memory ) {
+        return false;
+    }
+
+    sort->chunks = (usize*)memory;
+    for( u32 i = 0; i <= thread_count; ++i ) {
+        sort->chunks[i] = (sort->len * i) / thread_count;
+    }
+    struct InternalParallelSortTask* tasks[CORE_PARALLEL_SORT_MAX_THREADS];
+    u8* at = memory + header_size;
+    for( u32 i = 0; i < thread_count; ++i ) {
+        struct InternalParallelSortTask* task = (struct InternalParallelSortTask*)at;
+        task->sort  = sort;
+        task->index = i;
+        task->from  = (usize*)(task + 1);
+        task->to    = task->from + thread_count;
+        task->heap  = (u32*)(task->to + thread_count);
+        task->swap_buffer = at + task_size;
+
+        tasks[i] = task;
+        at      += task_size + stride_aligned;
+    }
+    sort->scratch = thread_count > 1 ? at : NULL;
+
+    sort->phase = INTERNAL_PARALLEL_SORT_PHASE_SORT;
+    if( thread_count == 1 ) {
+        internal_parallel_sort_main( 0, tasks[0] );
+        allocator_free( allocator, memory, alloc_size );
+        return true;
+    }
+
+    ThreadHandle threads[CORE_PARALLEL_SORT_MAX_THREADS];
+    b32          spawned[CORE_PARALLEL_SORT_MAX_THREADS];
+    enum InternalParallelSortPhase phases[] = {
+        INTERNAL_PARALLEL_SORT_PHASE_SORT,
+        INTERNAL_PARALLEL_SORT_PHASE_MERGE,
+        INTERNAL_PARALLEL_SORT_PHASE_COPY,
+    };
+    for( usize p = 0; p < static_array_len( phases ); ++p ) {
+        sort->phase = phases[p];
+        read_write_barrier();
+
+        // NOTE(alicia): calling thread takes the first task and
+        // also takes any task that could not get its own thread.
+        for( u32 i = 1; i < thread_count; ++i ) {
+            spawned[i] = thread_create(
+                internal_parallel_sort_main, tasks[i], 0, threads + i );
+        }
+        internal_parallel_sort_main( 0, tasks[0] );
+        for( u32 i = 1; i < thread_count; ++i ) {
+            if( spawned[i] ) {
+                thread_join( threads + i, NULL );
+                thread_free( threads + i );
+            } else {
+                internal_parallel_sort_main( 0, tasks[i] );
+            }
+        }
+    }
+
+    allocator_free( allocator, memory, alloc_size );
+    return true;
+}
+
+attr_core_api
+b32 parallel_sort_i32(
+    struct AllocatorInterface* allocator, usize len,
+    i32* buffer, b32 reverse, u32 opt_thread_count
+) {
+    struct InternalParallelSort sort;
+    memory_zero( &sort, sizeof(sort) );
+    sort.kind    = INTERNAL_PARALLEL_SORT_I32;
+    sort.reverse = reverse;
+    sort.len     = len;
+    sort.stride  = sizeof(i32);
+    sort.buffer  = (u8*)buffer;
+    return internal_parallel_sort( allocator, &sort, opt_thread_count );
+}
+attr_core_api
+b32 parallel_sort_u32(
+    struct AllocatorInterface* allocator, usize len,
+    u32* buffer, b32 reverse, u32 opt_thread_count
+) {
+    struct InternalParallelSort sort;
+    memory_zero( &sort, sizeof(sort) );
+    sort.kind    = INTERNAL_PARALLEL_SORT_U32;
+    sort.reverse = reverse;
+    sort.len     = len;
+    sort.stride  = sizeof(u32);
+    sort.buffer  = (u8*)buffer;
+    return internal_parallel_sort( allocator, &sort, opt_thread_count );
+}
+attr_core_api
+b32 parallel_sort_f32(
+    struct AllocatorInterface* allocator, usize len,
+    f32* buffer, b32 reverse, u32 opt_thread_count
+) {
+    struct InternalParallelSort sort;
+    memory_zero( &sort, sizeof(sort) );
+    sort.kind    = INTERNAL_PARALLEL_SORT_F32;
+    sort.reverse = reverse;
+    sort.len     = len;
+    sort.stride  = sizeof(f32);
+    sort.buffer  = (u8*)buffer;
+    return internal_parallel_sort( allocator, &sort, opt_thread_count );
+}
+attr_core_api
+b32 parallel_sort_generic(
+    struct AllocatorInterface* allocator, usize len,
+    usize stride, void* buffer,
+    SortCmpFN* cmp, void* opt_cmp_params, u32 opt_thread_count
+) {
+    struct InternalParallelSort sort;
+    memory_zero( &sort, sizeof(sort) );
+    sort.kind       = INTERNAL_PARALLEL_SORT_GENERIC;
+    sort.len        = len;
+    sort.stride     = stride;
+    sort.buffer     = buffer;
+    sort.cmp_fn     = cmp;
+    sort.cmp_params = opt_cmp_params;
+    if( len ) {
+        sort.cmp_non_strict = sort.cmp_fn( buffer, buffer, stride, opt_cmp_params );
+    }
+    return internal_parallel_sort( allocator, &sort, opt_thread_count );
+}
+
+#undef SORT_INSERTION_THRESHOLD
+#undef SORT_NINTHER_THRESHOLD
+#undef RADIX_DIGIT_BITS
+#undef RADIX_DIGIT_COUNT
+#undef RADIX_DIGIT_MASK
+#undef RADIX_PASSES_32
+#undef RADIX_PASSES_64
+#undef PARALLEL_SORT_MIN_CHUNK
+#undef MERGE_SORT_MIN_MERGE
+#undef MERGE_SORT_MAX_RUNS
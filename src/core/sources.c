@@ -27,22 +27,27 @@
 #endif
 
 #include "src/core/alloc.c"
+#include "src/core/filter.c"
 #include "src/core/fmt.c"
 #include "src/core/fs.c"
 #include "src/core/hash.c"
+#include "src/core/intern.c"
 #include "src/core/lib.c"
 #include "src/core/library.c"
+#include "src/core/matcher.c"
 #include "src/core/math.c"
 #include "src/core/memory.c"
 #include "src/core/path.c"
 #include "src/core/rand.c"
+#include "src/core/search.c"
 #include "src/core/sort.c"
+// NOTE(alicia): string.c uses internal UTF-8 and case mapping helpers from unicode.c.
+#include "src/core/unicode.c"
 #include "src/core/string.c"
 #include "src/core/sync.c"
 #include "src/core/system.c"
 #include "src/core/thread.c"
 #include "src/core/time.c"
-#include "src/core/unicode.c"
 #include "src/core/process.c"
 
 #endif /* header guard */
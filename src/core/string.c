@@ -12,6 +12,7 @@
 #include "core/fmt.h"
 #include "core/alloc.h"
 #include "core/unicode.h"
+#include "core/internal/bits.h"
 
 #if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
     #include "core/internal/sse.h" // IWYU pragma: keep
@@ -19,7 +20,117 @@
 
 #include "core/math.h"
 
-#define VECTOR_MIN_LEN (256)
+#include "src/core/float_tables.c"
+
+/// @brief Strings shorter than this are scanned one byte at a time.
+#define VECTOR_MIN_LEN (16)
+/// @brief Size of stack buffer that streamed conversions are flushed from.
+#define STRING_STREAM_BLOCK_SIZE (1024)
+
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+
+// NOTE(alicia): byte search compares 16 bytes at a time against
+// each needle and reduces comparison to a bit mask with movemask.
+// first and last block are unaligned loads that may overlap
+// the aligned body, bytes in the overlap were already checked
+// so overlap never changes result.
+
+attr_always_inline inline attr_internal
+u32 internal_string_match_mask(
+    __m128i block, usize needle_count, const __m128i* needles
+) {
+    __m128i match = _mm_cmpeq_epi8( block, needles[0] );
+    for( usize i = 1; i < needle_count; ++i ) {
+        match = _mm_or_si128( match, _mm_cmpeq_epi8( block, needles[i] ) );
+    }
+    return (u32)_mm_movemask_epi8( match );
+}
+attr_always_inline inline attr_internal
+usize internal_string_find_sse(
+    usize len, const u8* bytes, usize needle_count, const __m128i* needles
+) {
+    u32 mask = internal_string_match_mask(
+        _mm_loadu_si128( (const __m128i*)bytes ), needle_count, needles );
+    if( mask ) {
+        return internal_bits_ctz32( mask );
+    }
+
+    usize i = 16 - ((usize)bytes & 15);
+    for( ; (i + 16) <= len; i += 16 ) {
+        mask = internal_string_match_mask(
+            _mm_load_si128( (const __m128i*)(bytes + i) ), needle_count, needles );
+        if( mask ) {
+            return i + internal_bits_ctz32( mask );
+        }
+    }
+    if( i < len ) {
+        mask = internal_string_match_mask(
+            _mm_loadu_si128( (const __m128i*)(bytes + len - 16) ), needle_count, needles );
+        if( mask ) {
+            return (len - 16) + internal_bits_ctz32( mask );
+        }
+    }
+    return len;
+}
+attr_always_inline inline attr_internal
+usize internal_string_find_rev_sse(
+    usize len, const u8* bytes, usize needle_count, const __m128i* needles
+) {
+    u32 mask = internal_string_match_mask(
+        _mm_loadu_si128( (const __m128i*)(bytes + len - 16) ), needle_count, needles );
+    if( mask ) {
+        return (len - 16) + (31 - internal_bits_clz32( mask ));
+    }
+
+    usize end = len - ((usize)(bytes + len) & 15);
+    for( ; end >= 16; end -= 16 ) {
+        mask = internal_string_match_mask(
+            _mm_load_si128( (const __m128i*)(bytes + end - 16) ), needle_count, needles );
+        if( mask ) {
+            return (end - 16) + (31 - internal_bits_clz32( mask ));
+        }
+    }
+    if( end ) {
+        mask = internal_string_match_mask(
+            _mm_loadu_si128( (const __m128i*)bytes ), needle_count, needles );
+        mask &= (1u << end) - 1;
+        if( mask ) {
+            return 31 - internal_bits_clz32( mask );
+        }
+    }
+    return len;
+}
+attr_always_inline inline attr_internal
+usize internal_string_count_sse(
+    usize len, const u8* bytes, usize needle_count, const __m128i* needles
+) {
+    // NOTE(alicia): first block is cut off where aligned body starts
+    // and last block is cut off where it overlaps body
+    // so that no byte is counted twice.
+    usize i      = 16 - ((usize)bytes & 15);
+    usize result = internal_bits_popcount32( internal_string_match_mask(
+        _mm_loadu_si128( (const __m128i*)bytes ),
+        needle_count, needles ) & ((1u << i) - 1) );
+    for( ; (i + 16) <= len; i += 16 ) {
+        result += internal_bits_popcount32( internal_string_match_mask(
+            _mm_load_si128( (const __m128i*)(bytes + i) ), needle_count, needles ) );
+    }
+    if( i < len ) {
+        u32 mask = internal_string_match_mask(
+            _mm_loadu_si128( (const __m128i*)(bytes + len - 16) ), needle_count, needles );
+        result += internal_bits_popcount32( mask >> (16 - (len - i)) );
+    }
+    return result;
+}
+attr_always_inline inline attr_internal
+usize internal_byte_set_needles( const ByteSet* set, __m128i* out_needles ) {
+    for( u32 i = 0; i < set->count; ++i ) {
+        out_needles[i] = _mm_set1_epi8( (char)set->members[i] );
+    }
+    return set->count;
+}
+
+#endif /* SSE */
 
 attr_core_api
 usize cstr_len( const char* c_string ) {
@@ -52,33 +163,144 @@ b32 cstr_cmp( const char* a, const char* b ) {
     }
 }
 
+/// @brief Find byte offset of lead byte number @c count, counting from @c at.
+/// @return Byte offset or @c len if string has fewer lead bytes.
+attr_internal
+usize internal_string_utf8_advance( usize len, const u8* bytes, usize at, usize count ) {
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+    __m128i continuation = _mm_set1_epi8( (char)0xC0 );
+    while( (at + 16) <= len ) {
+        __m128i v    = _mm_loadu_si128( (const __m128i*)(bytes + at) );
+        u32     lead = ~(u32)_mm_movemask_epi8( _mm_cmplt_epi8( v, continuation ) ) & 0xFFFF;
+        u32     pc   = internal_bits_popcount32( lead );
+        if( pc > count ) {
+            while( count-- ) {
+                lead &= lead - 1;
+            }
+            return at + internal_bits_ctz32( lead );
+        }
+        count -= pc;
+        at    += 16;
+    }
+#endif
+    for( ; at < len; ++at ) {
+        if( (bytes[at] & 0xC0) != 0x80 ) {
+            if( !count ) {
+                return at;
+            }
+            count--;
+        }
+    }
+    return len;
+}
+
 attr_core_api
 usize string_len_utf8( struct _StringPOD str ) {
-    usize res = 0;
-    for( usize i = 0; i < str.len; ++i ) {
-        if( (str.bytes[i] & 0xC0) != 0x80 ) {
-            res++;
+    // NOTE(alicia): count continuation bytes, every other byte starts a code point.
+    usize continuation = 0;
+    usize at           = 0;
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+    __m128i zero      = _mm_setzero_si128();
+    __m128i threshold = _mm_set1_epi8( (char)0xC0 );
+    while( (at + 16) <= str.len ) {
+        // NOTE(alicia): byte counters overflow after 255 blocks.
+        usize blocks = (str.len - at) / 16;
+        if( blocks > 255 ) {
+            blocks = 255;
+        }
+        __m128i acc = zero;
+        for( usize i = 0; i < blocks; ++i ) {
+            __m128i v = _mm_loadu_si128( (const __m128i*)(str.bytes + at) );
+            acc = _mm_sub_epi8( acc, _mm_cmplt_epi8( v, threshold ) );
+            at += 16;
         }
+        __m128i sums  = _mm_sad_epu8( acc, zero );
+        continuation += (usize)_mm_cvtsi128_si32( sums ) +
+            (usize)_mm_cvtsi128_si32( _mm_srli_si128( sums, 8 ) );
     }
-    return res;
+#else
+    while( (at + 8) <= str.len ) {
+        u64 word;
+        memory_copy( &word, str.bytes + at, sizeof(word) );
+        continuation += internal_bits_popcount64(
+            word & ~(word << 1) & 0x8080808080808080ull );
+        at += 8;
+    }
+#endif
+    for( ; at < str.len; ++at ) {
+        continuation += (str.bytes[at] & 0xC0) == 0x80;
+    }
+    return str.len - continuation;
 }
 attr_core_api
 c32 string_index_utf8( struct _StringPOD str, usize index ) {
-    usize counter     = 0;
-    usize byte_offset = 0;
-    for( ; byte_offset < str.len; ++byte_offset ) {
-        if( counter == index ) {
-            break;
-        }
-        if( (str.bytes[byte_offset] & 0xC0) != 0x80 ) {
-            counter++;
-        }
+    usize byte_offset = internal_string_utf8_advance( str.len, str.bytes, 0, index );
+    debug_assert( byte_offset < str.len, "string_index_utf8: index is out of bounds!" );
+
+    rune32 rune;
+    internal_utf8_decode( str.len - byte_offset, str.bytes + byte_offset, &rune );
+    return rune;
+}
+attr_core_api
+b32 string_utf8_index_create(
+    struct AllocatorInterface* allocator, struct _StringPOD str,
+    StringUTF8Index* out_index
+) {
+    memory_zero( out_index, sizeof(*out_index) );
+    out_index->len = string_len_utf8( str );
+    if( !out_index->len ) {
+        return true;
     }
-    debug_assert( counter == index, "string_index_utf8: index is out of bounds!" );
 
-    UTFCodePoint8 cp8 = {};
-    unicode_cp8_from_string( str.len - byte_offset, str.utf8 + byte_offset, &cp8 );
-    return unicode_rune_from_cp8( cp8 );
+    usize count = (out_index->len + (STRING_UTF8_INDEX_STRIDE - 1)) / STRING_UTF8_INDEX_STRIDE;
+    usize* offsets = allocator_alloc( allocator, sizeof(usize) * count );
+    if( !offsets ) {
+        return false;
+    }
+
+    usize offset = internal_string_utf8_advance( str.len, str.bytes, 0, 0 );
+    offsets[0]   = offset;
+    for( usize i = 1; i < count; ++i ) {
+        offset = internal_string_utf8_advance(
+            str.len, str.bytes, offset, STRING_UTF8_INDEX_STRIDE );
+        offsets[i] = offset;
+    }
+
+    out_index->count   = count;
+    out_index->offsets = offsets;
+    return true;
+}
+attr_core_api
+void string_utf8_index_free(
+    struct AllocatorInterface* allocator, StringUTF8Index* index
+) {
+    if( index->offsets ) {
+        allocator_free( allocator, index->offsets, sizeof(usize) * index->count );
+    }
+    memory_zero( index, sizeof(*index) );
+}
+attr_core_api
+usize string_utf8_index_offset(
+    const StringUTF8Index* index, struct _StringPOD str, usize at
+) {
+    if( at >= index->len ) {
+        return str.len;
+    }
+    return internal_string_utf8_advance(
+        str.len, str.bytes,
+        index->offsets[at / STRING_UTF8_INDEX_STRIDE],
+        at % STRING_UTF8_INDEX_STRIDE );
+}
+attr_core_api
+c32 string_utf8_index_query(
+    const StringUTF8Index* index, struct _StringPOD str, usize at
+) {
+    usize byte_offset = string_utf8_index_offset( index, str, at );
+    debug_assert( byte_offset < str.len, "string_utf8_index_query: index is out of bounds!" );
+
+    rune32 rune;
+    internal_utf8_decode( str.len - byte_offset, str.bytes + byte_offset, &rune );
+    return rune;
 }
 attr_core_api
 struct _StringPOD string_utf8_next( struct _StringPOD src, c32* out_codepoint ) {
@@ -88,6 +310,41 @@ struct _StringPOD string_utf8_next( struct _StringPOD src, c32* out_codepoint )
     return string_advance_by( src, advance );
 }
 attr_core_api
+struct _StringPOD string_grapheme_next(
+    struct _StringPOD src, struct _StringPOD* out_cluster
+) {
+    usize len = internal_unicode_grapheme_len( src.len, src.bytes );
+    *out_cluster = string_new( len, src.cbuf );
+    return string_advance_by( src, len );
+}
+attr_core_api
+usize string_len_grapheme( struct _StringPOD str ) {
+    usize count = 0;
+    usize at    = 0;
+    while( at < str.len ) {
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+        // NOTE(alicia): when 17 bytes are ASCII, all 16 positions
+        // start a cluster except LF that follows CR.
+        // 17th byte is needed to know that last byte can't be extended.
+        if( (at + 17) <= str.len ) {
+            __m128i a = _mm_loadu_si128( (const __m128i*)(str.bytes + at) );
+            __m128i b = _mm_loadu_si128( (const __m128i*)(str.bytes + at + 1) );
+            if( !_mm_movemask_epi8( _mm_or_si128( a, b ) ) ) {
+                u32 crlf = (u32)_mm_movemask_epi8( _mm_and_si128(
+                    _mm_cmpeq_epi8( a, _mm_set1_epi8( '\r' ) ),
+                    _mm_cmpeq_epi8( b, _mm_set1_epi8( '\n' ) ) ) );
+                count += 16 - internal_bits_popcount32( crlf & 0x7FFF );
+                at    += 16 + (crlf >> 15);
+                continue;
+            }
+        }
+#endif
+        at += internal_unicode_grapheme_len( str.len - at, str.bytes + at );
+        count++;
+    }
+    return count;
+}
+attr_core_api
 b32 string_cmp( struct _StringPOD a, struct _StringPOD b ) {
     if( a.len != b.len ) {
         return false;
@@ -97,9 +354,133 @@ b32 string_cmp( struct _StringPOD a, struct _StringPOD b ) {
     }
     return memory_cmp( a.ptr, b.ptr, a.len );
 }
+/// @brief Fold ASCII upper-case letter to lower-case.
+attr_always_inline inline attr_internal
+u8 internal_string_ascii_fold( u8 c ) {
+    return c | ((u8)(c - 'A') < 26 ? 0x20 : 0);
+}
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+/// @brief Flip case of ASCII letters in range [first, first + 26) in block.
+attr_always_inline inline attr_internal
+__m128i internal_string_ascii_case_block( __m128i v, __m128i bias, __m128i limit ) {
+    // NOTE(alicia): bias moves range to start at -128 so that
+    // a single signed compare checks both ends.
+    __m128i in_range = _mm_cmplt_epi8( _mm_add_epi8( v, bias ), limit );
+    return _mm_xor_si128( v, _mm_and_si128( in_range, _mm_set1_epi8( 0x20 ) ) );
+}
+#endif
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+/// @brief Fold ASCII upper-case letters in block to lower-case.
+attr_always_inline inline attr_internal
+__m128i internal_string_fold_block( __m128i v ) {
+    return internal_string_ascii_case_block(
+        v, _mm_set1_epi8( (char)(0x80 - 'A') ), _mm_set1_epi8( (char)(0x80 + 26) ) );
+}
+#endif
+/// @brief Compare bytes for equality, ignoring case of ASCII letters.
+attr_internal
+b32 internal_string_cmp_ascii_nocase( usize len, const u8* a, const u8* b ) {
+    usize at = 0;
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+    if( len >= 16 ) {
+        for( ; (at + 16) <= len; at += 16 ) {
+            __m128i va = internal_string_fold_block( _mm_loadu_si128( (const __m128i*)(a + at) ) );
+            __m128i vb = internal_string_fold_block( _mm_loadu_si128( (const __m128i*)(b + at) ) );
+            if( _mm_movemask_epi8( _mm_cmpeq_epi8( va, vb ) ) != 0xFFFF ) {
+                return false;
+            }
+        }
+        if( at == len ) {
+            return true;
+        }
+        // NOTE(alicia): last block overlaps bytes that already matched.
+        at = len - 16;
+        __m128i va = internal_string_fold_block( _mm_loadu_si128( (const __m128i*)(a + at) ) );
+        __m128i vb = internal_string_fold_block( _mm_loadu_si128( (const __m128i*)(b + at) ) );
+        return _mm_movemask_epi8( _mm_cmpeq_epi8( va, vb ) ) == 0xFFFF;
+    }
+#endif
+    for( ; at < len; ++at ) {
+        if( internal_string_ascii_fold( a[at] ) != internal_string_ascii_fold( b[at] ) ) {
+            return false;
+        }
+    }
+    return true;
+}
+attr_core_api
+b32 string_cmp_ascii_nocase( struct _StringPOD a, struct _StringPOD b ) {
+    if( a.len != b.len ) {
+        return false;
+    }
+    return internal_string_cmp_ascii_nocase( a.len, a.bytes, b.bytes );
+}
+attr_core_api
+b32 string_cmp_utf8_nocase( struct _StringPOD a, struct _StringPOD b ) {
+    // NOTE(alicia): folding can change encoded length of rune
+    // so strings of different lengths can still be equal.
+    usize ia = 0, ib = 0;
+    while( ia < a.len && ib < b.len ) {
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+        if( (ia + 16) <= a.len && (ib + 16) <= b.len ) {
+            __m128i va = _mm_loadu_si128( (const __m128i*)(a.bytes + ia) );
+            __m128i vb = _mm_loadu_si128( (const __m128i*)(b.bytes + ib) );
+            u32 wide   = (u32)_mm_movemask_epi8( _mm_or_si128( va, vb ) );
+            u32 differ = ~(u32)_mm_movemask_epi8( _mm_cmpeq_epi8(
+                internal_string_fold_block( va ), internal_string_fold_block( vb ) ) ) & 0xFFFF;
+            u32 stop   = wide | differ;
+            if( !stop ) {
+                ia += 16;
+                ib += 16;
+                continue;
+            }
+            u32 skip = internal_bits_ctz32( stop );
+            ia += skip;
+            ib += skip;
+        }
+#endif
+        u8 ca = a.bytes[ia], cb = b.bytes[ib];
+        if( (ca | cb) < 0x80 ) {
+            if( internal_string_ascii_fold( ca ) != internal_string_ascii_fold( cb ) ) {
+                return false;
+            }
+            ia++;
+            ib++;
+            continue;
+        }
+
+        rune32 ra = 0, rb = 0;
+        u32 read_a = internal_utf8_decode( a.len - ia, a.bytes + ia, &ra );
+        u32 read_b = internal_utf8_decode( b.len - ib, b.bytes + ib, &rb );
+        if( ra == 0xFFFD || rb == 0xFFFD ) {
+            // NOTE(alicia): invalid sequences decode to U+FFFD,
+            // they only match the exact same bytes.
+            if( read_a != read_b || !memory_cmp( a.bytes + ia, b.bytes + ib, read_a ) ) {
+                return false;
+            }
+        } else if( internal_unicode_fold( ra ) != internal_unicode_fold( rb ) ) {
+            return false;
+        }
+        ia += read_a;
+        ib += read_b;
+    }
+    return ia == a.len && ib == b.len;
+}
 
 attr_core_api
 b32 string_find( struct _StringPOD str, char c, usize* opt_out_index ) {
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+    if( str.len >= VECTOR_MIN_LEN ) {
+        __m128i needle = _mm_set1_epi8( c );
+        usize   index  = internal_string_find_sse( str.len, str.bytes, 1, &needle );
+        if( index < str.len ) {
+            if( opt_out_index ) {
+                *opt_out_index = index;
+            }
+            return true;
+        }
+        return false;
+    }
+#endif
     for( usize i = 0; i < str.len; ++i ) {
         if( str.cbuf[i] == c ) {
             if( opt_out_index ) {
@@ -112,21 +493,33 @@ b32 string_find( struct _StringPOD str, char c, usize* opt_out_index ) {
 }
 attr_core_api
 usize string_find_count( struct _StringPOD str, char c ) {
-    struct _StringPOD substr = str;
-    usize  res    = 0;
-    while( !string_is_empty( substr ) ) {
-        usize idx = 0;
-        if( string_find( substr, c, &idx ) ) {
-            res++;
-            substr = string_advance_by( substr, idx + 1 );
-        } else {
-            break;
-        }
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+    if( str.len >= VECTOR_MIN_LEN ) {
+        __m128i needle = _mm_set1_epi8( c );
+        return internal_string_count_sse( str.len, str.bytes, 1, &needle );
+    }
+#endif
+    usize res = 0;
+    for( usize i = 0; i < str.len; ++i ) {
+        res += str.cbuf[i] == c;
     }
     return res;
 }
 attr_core_api
 b32 string_find_rev( struct _StringPOD str, char c, usize* opt_out_index ) {
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+    if( str.len >= VECTOR_MIN_LEN ) {
+        __m128i needle = _mm_set1_epi8( c );
+        usize   index  = internal_string_find_rev_sse( str.len, str.bytes, 1, &needle );
+        if( index < str.len ) {
+            if( opt_out_index ) {
+                *opt_out_index = index;
+            }
+            return true;
+        }
+        return false;
+    }
+#endif
     for( usize i = str.len; i-- > 0; ) {
         if( str.cbuf[i] == c ) {
             if( opt_out_index ) {
@@ -138,138 +531,508 @@ b32 string_find_rev( struct _StringPOD str, char c, usize* opt_out_index ) {
     return false;
 }
 attr_core_api
-b32 string_find_set( struct _StringPOD str, struct _StringPOD set, usize* opt_out_index ) {
-    for( usize i = 0; i < str.len; ++i ) {
-        for( usize j = 0; j < set.len; ++j ) {
-            if( str.cbuf[i] == set.cbuf[j] ) {
-                if( opt_out_index ) {
-                    *opt_out_index = i;
-                }
-                return true;
+void byte_set_from_string( struct _StringPOD set, ByteSet* out_set ) {
+    memory_zero( out_set, sizeof(*out_set) );
+    for( usize i = 0; i < set.len; ++i ) {
+        byte_set_insert( out_set, set.bytes[i] );
+    }
+}
+attr_core_api
+void byte_set_insert( ByteSet* set, u8 byte ) {
+    if( byte_set_contains( set, byte ) ) {
+        return;
+    }
+    set->bits[byte >> 5] |= 1u << (byte & 31);
+    if( set->count < BYTE_SET_SIMD_MAX ) {
+        set->members[set->count] = byte;
+    }
+    set->count++;
+}
+attr_core_api
+b32 string_find_byte_set(
+    struct _StringPOD str, const ByteSet* set, usize* opt_out_index
+) {
+    usize index = str.len;
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+    if( str.len >= VECTOR_MIN_LEN && set->count && set->count <= BYTE_SET_SIMD_MAX ) {
+        __m128i needles[BYTE_SET_SIMD_MAX];
+        usize   needle_count = internal_byte_set_needles( set, needles );
+        index = internal_string_find_sse( str.len, str.bytes, needle_count, needles );
+    } else
+#endif
+    {
+        for( usize i = 0; i < str.len; ++i ) {
+            if( byte_set_contains( set, str.bytes[i] ) ) {
+                index = i;
+                break;
             }
         }
     }
+    if( index < str.len ) {
+        if( opt_out_index ) {
+            *opt_out_index = index;
+        }
+        return true;
+    }
     return false;
 }
 attr_core_api
-b32 string_find_set_rev(
-    struct _StringPOD str, struct _StringPOD set, usize* opt_out_index
+b32 string_find_byte_set_rev(
+    struct _StringPOD str, const ByteSet* set, usize* opt_out_index
 ) {
-    for( usize i = str.len; i-- > 0; ) {
-        for( usize j = 0; j < set.len; ++j ) {
-            if( str.cbuf[i] == set.cbuf[j] ) {
-                if( opt_out_index ) {
-                    *opt_out_index = i;
-                }
-                return true;
+    usize index = str.len;
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+    if( str.len >= VECTOR_MIN_LEN && set->count && set->count <= BYTE_SET_SIMD_MAX ) {
+        __m128i needles[BYTE_SET_SIMD_MAX];
+        usize   needle_count = internal_byte_set_needles( set, needles );
+        index = internal_string_find_rev_sse( str.len, str.bytes, needle_count, needles );
+    } else
+#endif
+    {
+        for( usize i = str.len; i-- > 0; ) {
+            if( byte_set_contains( set, str.bytes[i] ) ) {
+                index = i;
+                break;
             }
         }
     }
+    if( index < str.len ) {
+        if( opt_out_index ) {
+            *opt_out_index = index;
+        }
+        return true;
+    }
     return false;
 }
 attr_core_api
-usize string_find_set_count( struct _StringPOD str, struct _StringPOD set ) {
-    struct _StringPOD substr = str;
-    usize  res    = 0;
-    while( !string_is_empty( substr ) ) {
-        usize idx = 0;
-        if( string_find_set( substr, set, &idx ) ) {
-            res++;
-            substr = string_advance_by( substr, idx + 1 );
-        } else {
-            break;
-        }
+usize string_find_byte_set_count( struct _StringPOD str, const ByteSet* set ) {
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+    if( str.len >= VECTOR_MIN_LEN && set->count && set->count <= BYTE_SET_SIMD_MAX ) {
+        __m128i needles[BYTE_SET_SIMD_MAX];
+        usize   needle_count = internal_byte_set_needles( set, needles );
+        return internal_string_count_sse( str.len, str.bytes, needle_count, needles );
+    }
+#endif
+    usize res = 0;
+    for( usize i = 0; i < str.len; ++i ) {
+        res += byte_set_contains( set, str.bytes[i] );
     }
     return res;
 }
 attr_core_api
-b32 string_find_phrase(
-    struct _StringPOD str, struct _StringPOD phrase, usize* opt_out_index
+b32 string_find_set( struct _StringPOD str, struct _StringPOD set, usize* opt_out_index ) {
+    ByteSet byte_set;
+    byte_set_from_string( set, &byte_set );
+    return string_find_byte_set( str, &byte_set, opt_out_index );
+}
+attr_core_api
+b32 string_find_set_rev(
+    struct _StringPOD str, struct _StringPOD set, usize* opt_out_index
 ) {
-    if( str.len < phrase.len ) {
-        return false;
-    }
-    struct _StringPOD substr = str;
-    while( !string_is_empty( substr ) ) {
-        usize start = 0;
-        if( string_find( substr, phrase.cbuf[0], &start ) ) {
-            struct _StringPOD cmp = substr;
-            cmp.len    = phrase.len;
-            if( string_cmp( cmp, phrase ) ) {
-                if( opt_out_index ) {
-                    *opt_out_index = cmp.cbuf - str.cbuf;
+    ByteSet byte_set;
+    byte_set_from_string( set, &byte_set );
+    return string_find_byte_set_rev( str, &byte_set, opt_out_index );
+}
+attr_core_api
+usize string_find_set_count( struct _StringPOD str, struct _StringPOD set ) {
+    ByteSet byte_set;
+    byte_set_from_string( set, &byte_set );
+    return string_find_byte_set_count( str, &byte_set );
+}
+// NOTE(alicia): phrase search is Two-Way (Crochemore-Perrin),
+// linear time and constant space. needle is split at its critical
+// position, right half is matched left to right and then left half
+// right to left. reverse search runs same algorithm on mirrored
+// needle and haystack. short needles are searched with SIMD instead,
+// candidates are positions where both first and last byte match.
+// case-insensitive search runs same algorithms with ASCII letters
+// folded to lower-case as needle and haystack are read.
+
+#define PHRASE_RAW_AT( reverse, buf, len, index ) \
+    ((reverse) ? (buf)[(len) - 1 - (index)] : (buf)[(index)])
+#define PHRASE_AT( nocase, reverse, buf, len, index ) \
+    ((nocase) ? \
+        internal_string_ascii_fold( PHRASE_RAW_AT( reverse, buf, len, index ) ) : \
+        PHRASE_RAW_AT( reverse, buf, len, index ))
+
+attr_always_inline inline attr_internal
+void internal_string_searcher_factor(
+    usize len, const u8* needle, b32 reverse, b32 nocase,
+    StringSearcherFactor* out_factor
+) {
+    // NOTE(alicia): maximal suffix under both byte orderings,
+    // critical position is whichever suffix starts later.
+    usize critical = 0, period = 1;
+    for( u32 order = 0; order < 2; ++order ) {
+        isize ip = -1;
+        usize jp = 0, k = 1, p = 1;
+        while( (jp + k) < len ) {
+            u8 a = PHRASE_AT( nocase, reverse, needle, len, (usize)(ip + (isize)k) );
+            u8 b = PHRASE_AT( nocase, reverse, needle, len, jp + k );
+            if( a == b ) {
+                if( k == p ) {
+                    jp += p;
+                    k   = 1;
+                } else {
+                    k++;
                 }
-                return true;
+            } else if( order ? (a < b) : (a > b) ) {
+                jp += k;
+                k   = 1;
+                p   = jp - (usize)ip;
+            } else {
+                ip = (isize)jp++;
+                k  = p = 1;
             }
-
-            substr = string_advance( substr );
-        } else {
-            break;
         }
+        if( !order || (usize)(ip + 1) > critical ) {
+            critical = (usize)(ip + 1);
+            period   = p;
+        }
+    }
 
-        if( substr.len < phrase.len ) {
+    b32 periodic = true;
+    for( usize i = 0; i < critical; ++i ) {
+        if(
+            PHRASE_AT( nocase, reverse, needle, len, i ) !=
+            PHRASE_AT( nocase, reverse, needle, len, i + period )
+        ) {
+            periodic = false;
             break;
         }
     }
-    return false;
+
+    out_factor->critical = critical;
+    if( periodic ) {
+        out_factor->period = period;
+        out_factor->memory = len - period;
+    } else {
+        usize left  = critical ? critical - 1 : 0;
+        usize right = len - critical;
+        out_factor->period = (left > right ? left : right) + 1;
+        out_factor->memory = 0;
+    }
 }
-attr_core_api
-b32 string_find_phrase_rev(
-    struct _StringPOD str, struct _StringPOD phrase, usize* opt_out_index
+attr_always_inline inline attr_internal
+usize internal_string_two_way(
+    const StringSearcher* searcher, usize hay_len, const u8* hay, b32 reverse, b32 nocase
 ) {
-    struct _StringPOD substr = str;
-    while( !string_is_empty( substr ) ) {
-        if( substr.len < phrase.len ) {
-            break;
+    const StringSearcherFactor* factor =
+        reverse ? &searcher->factor_rev : &searcher->factor;
+    const u8* needle = searcher->needle.bytes;
+    usize     len    = searcher->needle.len;
+
+    usize pos = 0, mem = 0;
+    while( (pos + len) <= hay_len ) {
+        if( !byte_set_contains(
+            &searcher->set, PHRASE_RAW_AT( reverse, hay, hay_len, pos + len - 1 )
+        ) ) {
+            pos += len;
+            mem  = 0;
+            continue;
         }
-        usize start = 0;
-        if( string_find_rev( substr, phrase.cbuf[0], &start ) ) {
-            struct _StringPOD potential = string_advance_by( substr, start );
-            if( potential.len < phrase.len ) {
-                substr = string_truncate( substr, start );
-                continue;
-            }
-            potential.len = phrase.len;
-            if( string_cmp( potential, phrase ) ) {
-                if( opt_out_index ) {
-                    *opt_out_index = potential.cbuf - str.cbuf;
-                }
-                return true;
-            }
-            substr = string_truncate( substr, start );
-        } else {
-            break;
+
+        usize k = factor->critical > mem ? factor->critical : mem;
+        while(
+            k < len &&
+            PHRASE_AT( nocase, reverse, needle, len, k ) ==
+            PHRASE_AT( nocase, reverse, hay, hay_len, pos + k )
+        ) {
+            k++;
         }
-    }
-    return false;
-}
-attr_core_api
-usize string_find_phrase_count( struct _StringPOD str, struct _StringPOD phrase ) {
-    struct _StringPOD substr = str;
-    usize  res    = 0;
-    while( !string_is_empty( substr ) ) {
-        usize idx = 0;
-        if( string_find_phrase( substr, phrase, &idx ) ) {
-            res++;
-            substr = string_advance_by( substr, idx + phrase.len );
-        } else {
-            break;
+        if( k < len ) {
+            pos += (k - factor->critical) + 1;
+            mem  = 0;
+            continue;
         }
+
+        k = factor->critical;
+        while(
+            k > mem &&
+            PHRASE_AT( nocase, reverse, needle, len, k - 1 ) ==
+            PHRASE_AT( nocase, reverse, hay, hay_len, pos + k - 1 )
+        ) {
+            k--;
+        }
+        if( k <= mem ) {
+            return reverse ? hay_len - pos - len : pos;
+        }
+        pos += factor->period;
+        mem  = factor->memory;
     }
-    return res;
+    return hay_len;
 }
-attr_core_api
-struct _StringPOD string_trim_leading_whitespace( struct _StringPOD str ) {
-    struct _StringPOD res = str;
-    while( !string_is_empty( res ) ) {
-        if( ascii_is_whitespace( res.cbuf[0] ) ) {
-            res = string_advance( res );
-            continue;
-        }
 
-        return res;
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+attr_always_inline inline attr_internal
+u32 internal_string_phrase_mask(
+    const u8* hay, usize len, __m128i first, __m128i last, b32 nocase
+) {
+    __m128i a = _mm_loadu_si128( (const __m128i*)hay );
+    __m128i b = _mm_loadu_si128( (const __m128i*)(hay + len - 1) );
+    if( nocase ) {
+        a = internal_string_fold_block( a );
+        b = internal_string_fold_block( b );
     }
-    return res;
+    return (u32)_mm_movemask_epi8(
+        _mm_and_si128( _mm_cmpeq_epi8( a, first ), _mm_cmpeq_epi8( b, last ) ) );
+}
+#endif
+
+/// @brief Compare bytes of candidate between its first and last byte with needle.
+attr_always_inline inline attr_internal
+b32 internal_string_phrase_verify( const u8* hay, const u8* needle, usize len, b32 nocase ) {
+    if( nocase ) {
+        return internal_string_cmp_ascii_nocase( len, hay, needle );
+    }
+    return memory_cmp( hay, needle, len );
+}
+attr_always_inline inline attr_internal
+usize internal_string_phrase_short(
+    usize hay_len, const u8* hay, usize len, const u8* needle, b32 nocase
+) {
+    usize count = (hay_len - len) + 1;
+    usize i     = 0;
+    u8    n0    = nocase ? internal_string_ascii_fold( needle[0] ) : needle[0];
+    u8    n1    = nocase ? internal_string_ascii_fold( needle[len - 1] ) : needle[len - 1];
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+    __m128i first = _mm_set1_epi8( (char)n0 );
+    __m128i last  = _mm_set1_epi8( (char)n1 );
+    for( ; (i + 16) <= count; i += 16 ) {
+        u32 mask = internal_string_phrase_mask( hay + i, len, first, last, nocase );
+        while( mask ) {
+            usize at = i + internal_bits_ctz32( mask );
+            if( internal_string_phrase_verify( hay + at + 1, needle + 1, len - 2, nocase ) ) {
+                return at;
+            }
+            mask &= mask - 1;
+        }
+    }
+#endif
+    for( ; i < count; ++i ) {
+        if(
+            PHRASE_AT( nocase, false, hay, hay_len, i ) == n0 &&
+            PHRASE_AT( nocase, false, hay, hay_len, i + len - 1 ) == n1 &&
+            internal_string_phrase_verify( hay + i + 1, needle + 1, len - 2, nocase )
+        ) {
+            return i;
+        }
+    }
+    return hay_len;
+}
+attr_always_inline inline attr_internal
+usize internal_string_phrase_short_rev(
+    usize hay_len, const u8* hay, usize len, const u8* needle, b32 nocase
+) {
+    usize i  = (hay_len - len) + 1;
+    u8    n0 = nocase ? internal_string_ascii_fold( needle[0] ) : needle[0];
+    u8    n1 = nocase ? internal_string_ascii_fold( needle[len - 1] ) : needle[len - 1];
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+    __m128i first = _mm_set1_epi8( (char)n0 );
+    __m128i last  = _mm_set1_epi8( (char)n1 );
+    while( i >= 16 ) {
+        i -= 16;
+        u32 mask = internal_string_phrase_mask( hay + i, len, first, last, nocase );
+        while( mask ) {
+            u32   bit = 31 - internal_bits_clz32( mask );
+            usize at  = i + bit;
+            if( internal_string_phrase_verify( hay + at + 1, needle + 1, len - 2, nocase ) ) {
+                return at;
+            }
+            mask &= ~(1u << bit);
+        }
+    }
+#endif
+    while( i-- > 0 ) {
+        if(
+            PHRASE_AT( nocase, false, hay, hay_len, i ) == n0 &&
+            PHRASE_AT( nocase, false, hay, hay_len, i + len - 1 ) == n1 &&
+            internal_string_phrase_verify( hay + i + 1, needle + 1, len - 2, nocase )
+        ) {
+            return i;
+        }
+    }
+    return hay_len;
+}
+
+#undef PHRASE_RAW_AT
+#undef PHRASE_AT
+
+attr_internal
+void internal_string_searcher_init(
+    struct _StringPOD needle, b32 nocase, StringSearcher* out_searcher
+) {
+    memory_zero( out_searcher, sizeof(*out_searcher) );
+    out_searcher->needle = needle;
+    out_searcher->nocase = nocase;
+    // NOTE(alicia): case-insensitive single byte needles
+    // are searched as a set of both cases.
+    if( needle.len <= STRING_SEARCHER_SHORT_LEN && !(nocase && needle.len == 1) ) {
+        return;
+    }
+    byte_set_from_string( needle, &out_searcher->set );
+    if( nocase ) {
+        for( usize i = 0; i < needle.len; ++i ) {
+            u8 folded = internal_string_ascii_fold( needle.bytes[i] );
+            if( (u8)(folded - 'a') < 26 ) {
+                byte_set_insert( &out_searcher->set, folded );
+                byte_set_insert( &out_searcher->set, folded ^ 0x20 );
+            }
+        }
+    }
+    if( needle.len <= STRING_SEARCHER_SHORT_LEN ) {
+        return;
+    }
+    internal_string_searcher_factor(
+        needle.len, needle.bytes, false, nocase, &out_searcher->factor );
+    internal_string_searcher_factor(
+        needle.len, needle.bytes, true, nocase, &out_searcher->factor_rev );
+}
+attr_core_api
+void string_searcher_init( struct _StringPOD needle, StringSearcher* out_searcher ) {
+    internal_string_searcher_init( needle, false, out_searcher );
+}
+attr_core_api
+void string_searcher_init_nocase( struct _StringPOD needle, StringSearcher* out_searcher ) {
+    internal_string_searcher_init( needle, true, out_searcher );
+}
+attr_core_api
+b32 string_searcher_find(
+    const StringSearcher* searcher, struct _StringPOD str, usize* opt_out_index
+) {
+    struct _StringPOD needle = searcher->needle;
+    if( !needle.len || needle.len > str.len ) {
+        return false;
+    }
+
+    usize index = str.len;
+    if( needle.len == 1 ) {
+        if( searcher->nocase ) {
+            return string_find_byte_set( str, &searcher->set, opt_out_index );
+        }
+        return string_find( str, needle.cbuf[0], opt_out_index );
+    } else if( needle.len <= STRING_SEARCHER_SHORT_LEN ) {
+        if( searcher->nocase ) {
+            index = internal_string_phrase_short(
+                str.len, str.bytes, needle.len, needle.bytes, true );
+        } else {
+            index = internal_string_phrase_short(
+                str.len, str.bytes, needle.len, needle.bytes, false );
+        }
+    } else {
+        if( searcher->nocase ) {
+            index = internal_string_two_way( searcher, str.len, str.bytes, false, true );
+        } else {
+            index = internal_string_two_way( searcher, str.len, str.bytes, false, false );
+        }
+    }
+
+    if( index < str.len ) {
+        if( opt_out_index ) {
+            *opt_out_index = index;
+        }
+        return true;
+    }
+    return false;
+}
+attr_core_api
+b32 string_searcher_find_rev(
+    const StringSearcher* searcher, struct _StringPOD str, usize* opt_out_index
+) {
+    struct _StringPOD needle = searcher->needle;
+    if( !needle.len || needle.len > str.len ) {
+        return false;
+    }
+
+    usize index = str.len;
+    if( needle.len == 1 ) {
+        if( searcher->nocase ) {
+            return string_find_byte_set_rev( str, &searcher->set, opt_out_index );
+        }
+        return string_find_rev( str, needle.cbuf[0], opt_out_index );
+    } else if( needle.len <= STRING_SEARCHER_SHORT_LEN ) {
+        if( searcher->nocase ) {
+            index = internal_string_phrase_short_rev(
+                str.len, str.bytes, needle.len, needle.bytes, true );
+        } else {
+            index = internal_string_phrase_short_rev(
+                str.len, str.bytes, needle.len, needle.bytes, false );
+        }
+    } else {
+        if( searcher->nocase ) {
+            index = internal_string_two_way( searcher, str.len, str.bytes, true, true );
+        } else {
+            index = internal_string_two_way( searcher, str.len, str.bytes, true, false );
+        }
+    }
+
+    if( index < str.len ) {
+        if( opt_out_index ) {
+            *opt_out_index = index;
+        }
+        return true;
+    }
+    return false;
+}
+attr_core_api
+usize string_searcher_count( const StringSearcher* searcher, struct _StringPOD str ) {
+    if( searcher->needle.len == 1 ) {
+        if( searcher->nocase ) {
+            return string_find_byte_set_count( str, &searcher->set );
+        }
+        return string_find_count( str, searcher->needle.cbuf[0] );
+    }
+    struct _StringPOD substr = str;
+    usize res = 0;
+    usize idx = 0;
+    while( string_searcher_find( searcher, substr, &idx ) ) {
+        res++;
+        substr = string_advance_by( substr, idx + searcher->needle.len );
+    }
+    return res;
+}
+attr_core_api
+b32 string_find_phrase(
+    struct _StringPOD str, struct _StringPOD phrase, usize* opt_out_index
+) {
+    StringSearcher searcher;
+    string_searcher_init( phrase, &searcher );
+    return string_searcher_find( &searcher, str, opt_out_index );
+}
+attr_core_api
+b32 string_find_phrase_rev(
+    struct _StringPOD str, struct _StringPOD phrase, usize* opt_out_index
+) {
+    StringSearcher searcher;
+    string_searcher_init( phrase, &searcher );
+    return string_searcher_find_rev( &searcher, str, opt_out_index );
+}
+attr_core_api
+usize string_find_phrase_count( struct _StringPOD str, struct _StringPOD phrase ) {
+    StringSearcher searcher;
+    string_searcher_init( phrase, &searcher );
+    return string_searcher_count( &searcher, str );
+}
+attr_core_api
+b32 string_find_phrase_nocase(
+    struct _StringPOD str, struct _StringPOD phrase, usize* opt_out_index
+) {
+    StringSearcher searcher;
+    string_searcher_init_nocase( phrase, &searcher );
+    return string_searcher_find( &searcher, str, opt_out_index );
+}
+attr_core_api
+struct _StringPOD string_trim_leading_whitespace( struct _StringPOD str ) {
+    struct _StringPOD res = str;
+    while( !string_is_empty( res ) ) {
+        if( ascii_is_whitespace( res.cbuf[0] ) ) {
+            res = string_advance( res );
+            continue;
+        }
+
+        return res;
+    }
+    return res;
 }
 attr_core_api
 struct _StringPOD string_trim_trailing_whitespace( struct _StringPOD str ) {
@@ -305,208 +1068,1123 @@ attr_core_api
 void string_mut_set( struct _StringPOD str, char c ) {
     memory_set( str.ptr, rcast( u8, &c ), str.len );
 }
+attr_internal
+void internal_string_mut_ascii_case( struct _StringPOD str, char first ) {
+    usize at = 0;
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+    __m128i bias  = _mm_set1_epi8( (char)(0x80 - first) );
+    __m128i limit = _mm_set1_epi8( (char)(0x80 + 26) );
+    for( ; (at + 16) <= str.len; at += 16 ) {
+        __m128i v = _mm_loadu_si128( (const __m128i*)(str.bytes + at) );
+        _mm_storeu_si128(
+            (__m128i*)(str.bytes + at), internal_string_ascii_case_block( v, bias, limit ) );
+    }
+#endif
+    for( ; at < str.len; ++at ) {
+        u8 c = str.bytes[at];
+        str.bytes[at] = c ^ ((u8)(c - first) < 26 ? 0x20 : 0);
+    }
+}
+/// @brief Stream UTF-8 string with every rune case mapped.
+/// @details
+/// Runs of ASCII are converted 16 bytes at a time, other runes
+/// go through case mapping tables. Runes without a mapping and
+/// invalid sequences are copied unchanged.
+attr_internal
+usize internal_string_stream_case(
+    StreamBytesFN* stream, void* target, struct _StringPOD str, b32 upper
+) {
+    u8    block[STRING_STREAM_BLOCK_SIZE];
+    usize count  = 0;
+    usize result = 0;
+    usize at     = 0;
+    u8    first  = upper ? 'a' : 'A';
+
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+    __m128i bias  = _mm_set1_epi8( (char)(0x80 - first) );
+    __m128i limit = _mm_set1_epi8( (char)(0x80 + 26) );
+#endif
+
+    while( at < str.len ) {
+        // NOTE(alicia): room for vector store, its ASCII prefix
+        // and one encoded rune.
+        if( (count + 32) > STRING_STREAM_BLOCK_SIZE ) {
+            result += stream( target, count, block );
+            count   = 0;
+        }
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+        if( (at + 16) <= str.len ) {
+            __m128i v     = _mm_loadu_si128( (const __m128i*)(str.bytes + at) );
+            u32     ascii = 16;
+            u32     mask  = (u32)_mm_movemask_epi8( v );
+            if( mask ) {
+                ascii = internal_bits_ctz32( mask );
+            }
+            // NOTE(alicia): whole block is stored but only
+            // ASCII prefix is kept, rest is overwritten below.
+            _mm_storeu_si128(
+                (__m128i*)(block + count), internal_string_ascii_case_block( v, bias, limit ) );
+            count += ascii;
+            at    += ascii;
+            if( !mask ) {
+                continue;
+            }
+        }
+#endif
+        u8 c = str.bytes[at];
+        if( c < 0x80 ) {
+            block[count++] = c ^ ((u8)(c - first) < 26 ? 0x20 : 0);
+            at++;
+            continue;
+        }
+
+        rune32 rune   = 0;
+        u32    read   = internal_utf8_decode( str.len - at, str.bytes + at, &rune );
+        rune32 mapped = upper ?
+            internal_unicode_to_upper( rune ) : internal_unicode_to_lower( rune );
+        if( mapped == rune ) {
+            for( u32 i = 0; i < read; ++i ) {
+                block[count + i] = str.bytes[at + i];
+            }
+            count += read;
+        } else {
+            u32 write = internal_utf8_rune_len( mapped );
+            internal_utf8_encode( mapped, write, block + count );
+            count += write;
+        }
+        at += read;
+    }
+    if( count ) {
+        result += stream( target, count, block );
+    }
+    return result;
+}
 attr_core_api
 void string_mut_to_upper( struct _StringPOD str ) {
-    for( usize i = 0; i < str.len; ++i ) {
-        str.buf[i] = ascii_to_upper( str.buf[i] );
-    }
+    internal_string_mut_ascii_case( str, 'a' );
 }
 attr_core_api
 void string_mut_to_lower( struct _StringPOD str ) {
-    for( usize i = 0; i < str.len; ++i ) {
-        str.buf[i] = ascii_to_lower( str.buf[i] );
-    }
+    internal_string_mut_ascii_case( str, 'A' );
 }
 attr_core_api
 usize string_stream_to_upper(
     StreamBytesFN* stream, void* target, struct _StringPOD str
 ) {
-    usize res = 0;
-    for( usize i = 0; i < str.len; ++i ) {
-        char c = ascii_to_upper( str.cbuf[i] );
-        res += stream( target, 1, &c );
-    }
-    return res;
+    return internal_string_stream_case( stream, target, str, true );
 }
 attr_core_api
 usize string_stream_to_lower(
     StreamBytesFN* stream, void* target, struct _StringPOD str
 ) {
-    usize res = 0;
-    for( usize i = 0; i < str.len; ++i ) {
-        char c = ascii_to_lower( str.cbuf[i] );
-        res += stream( target, 1, &c );
-    }
-    return res;
+    return internal_string_stream_case( stream, target, str, false );
 }
 
-attr_always_inline inline
-attr_internal b32 internal_string_read_increment( usize* value, usize max ) {
-    usize increment_result = *value + 1;
-    if( increment_result >= max ) {
-        return false;
+// NOTE(alicia): float parsing follows Daniel Lemire's fast_float.
+// text is split into up to 19 significant digits w and power of ten q.
+// when w and 10^q are both exact in target type, result is a single
+// multiply or divide (Clinger's fast path). otherwise w * 5^q is
+// computed with 128-bit truncated powers of five (Eisel-Lemire),
+// which is always correctly rounded when w holds every digit.
+// when digits were truncated and w and w + 1 round differently,
+// text is converted again with arbitrary precision decimal.
+
+/// @brief Parameters of binary floating point format.
+typedef struct InternalFloatFormat {
+    i32 mantissa_bits;
+    i32 min_exponent;
+    i32 infinite_power;
+    i32 sign_shift;
+    i32 min_fast_exponent;
+    i32 max_fast_exponent;
+    i32 min_round_even;
+    i32 max_round_even;
+    i32 smallest_pow10;
+    i32 largest_pow10;
+    u64 max_fast_mantissa;
+} InternalFloatFormat;
+
+attr_global const InternalFloatFormat global_float_format_f64 = {
+    .mantissa_bits     = 52,
+    .min_exponent      = -1023,
+    .infinite_power    = 0x7FF,
+    .sign_shift        = 63,
+    .min_fast_exponent = -22,
+    .max_fast_exponent = 22,
+    .min_round_even    = -4,
+    .max_round_even    = 23,
+    .smallest_pow10    = -342,
+    .largest_pow10     = 308,
+    .max_fast_mantissa = 1ULL << 53,
+};
+attr_global const InternalFloatFormat global_float_format_f32 = {
+    .mantissa_bits     = 23,
+    .min_exponent      = -127,
+    .infinite_power    = 0xFF,
+    .sign_shift        = 31,
+    .min_fast_exponent = -10,
+    .max_fast_exponent = 10,
+    .min_round_even    = -17,
+    .max_round_even    = 10,
+    .smallest_pow10    = -64,
+    .largest_pow10     = 38,
+    .max_fast_mantissa = 1ULL << 24,
+};
+
+/// @brief Number split into significant digits and power of ten.
+typedef struct InternalFloatDecimal {
+    u64 mantissa;
+    i64 exponent;
+    b32 negative;
+    b32 truncated;
+} InternalFloatDecimal;
+
+/// @brief Binary significand without implicit bit and biased exponent.
+typedef struct InternalFloatAdjusted {
+    u64 mantissa;
+    i32 power2;
+} InternalFloatAdjusted;
+
+#define FLOAT_MIN_NINETEEN_DIGITS (1000000000000000000ULL)
+#define FLOAT_DECIMAL_MAX_DIGITS  (768)
+#define FLOAT_DECIMAL_POINT_RANGE (2047)
+#define FLOAT_DECIMAL_MAX_SHIFT   (60)
+
+/// @brief Check if 8 bytes loaded with #internal_bits_load_le64() are all ASCII digits.
+attr_always_inline inline attr_internal
+b32 internal_string_is_eight_digits( u64 chunk ) {
+    return ((chunk & 0xF0F0F0F0F0F0F0F0ULL) |
+        (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+        0x3333333333333333ULL;
+}
+/// @brief Convert 8 ASCII digits loaded with #internal_bits_load_le64().
+attr_always_inline inline attr_internal
+u32 internal_string_parse_eight_digits( u64 chunk ) {
+    // NOTE(alicia): combine adjacent digits into pairs,
+    // then pairs into 4 digit halves with two multiplies
+    // that land result in upper 32 bits.
+    const u64 mask = 0x000000FF000000FFULL;
+    const u64 mul1 = 100 + (1000000ULL << 32);
+    const u64 mul2 = 1 + (10000ULL << 32);
+    chunk -= 0x3030303030303030ULL;
+    chunk  = (chunk * 10) + (chunk >> 8);
+    return (u32)((((chunk & mask) * mul1) + (((chunk >> 16) & mask) * mul2)) >> 32);
+}
+/// @brief Accumulate run of ASCII digits into value, 8 digits at a time.
+/// @details
+/// Value wraps on overflow, callers count digits.
+/// @return Index of first byte that is not a digit.
+attr_always_inline inline attr_internal
+usize internal_string_parse_digits( usize len, const u8* bytes, usize at, u64* io_value ) {
+    u64 value = *io_value;
+    while( (at + 8) <= len ) {
+        u64 chunk = internal_bits_load_le64( bytes + at );
+        if( !internal_string_is_eight_digits( chunk ) ) {
+            break;
+        }
+        value = (value * 100000000) + internal_string_parse_eight_digits( chunk );
+        at   += 8;
     }
-    *value = increment_result;
-    return true;
+    while( at < len && (u8)(bytes[at] - '0') < 10 ) {
+        value = (value * 10) + (bytes[at] - '0');
+        at++;
+    }
+    *io_value = value;
+    return at;
 }
-attr_core_api
-b32 string_parse_int( struct _StringPOD str, i64* out_int ) {
-    if( !str.len ) {
-        return false;
+/// @brief Parse decimal number into significant digits and power of ten.
+/// @return Number of bytes parsed, zero if text does not start with a number.
+attr_always_inline inline attr_internal
+usize internal_string_parse_decimal(
+    usize len, const u8* bytes, InternalFloatDecimal* out_decimal
+) {
+    usize at = 0;
+    out_decimal->negative  = false;
+    out_decimal->truncated = false;
+    if( at < len && (bytes[at] == '-' || bytes[at] == '+') ) {
+        out_decimal->negative = bytes[at] == '-';
+        at++;
     }
 
-    b32 is_negative = false;
-    i64 result = 0;
+    u64   mantissa  = 0;
+    usize int_start = at;
+    at = internal_string_parse_digits( len, bytes, at, &mantissa );
+    usize int_end = at;
 
-    usize index = 0;
-    if( str.cbuf[index] == '-' ) {
-        if( !internal_string_read_increment( &index, str.len ) ) {
-            return false;
+    usize digit_count = int_end - int_start;
+    usize frac_start  = at;
+    usize frac_end    = at;
+    i64   exponent    = 0;
+    if( at < len && bytes[at] == '.' ) {
+        frac_start   = at + 1;
+        at           = internal_string_parse_digits( len, bytes, frac_start, &mantissa );
+        frac_end     = at;
+        exponent     = -(i64)(frac_end - frac_start);
+        digit_count += frac_end - frac_start;
+    }
+    if( !digit_count ) {
+        return 0;
+    }
+
+    // NOTE(alicia): exponent is only consumed if it has digits,
+    // digits past what fits in 28 bits can only make result zero or infinity.
+    i64 exp_number = 0;
+    if( at < len && (bytes[at] | 0x20) == 'e' ) {
+        usize exp_at   = at + 1;
+        b32   exp_sign = false;
+        if( exp_at < len && (bytes[exp_at] == '-' || bytes[exp_at] == '+') ) {
+            exp_sign = bytes[exp_at] == '-';
+            exp_at++;
+        }
+        if( exp_at < len && (u8)(bytes[exp_at] - '0') < 10 ) {
+            while( exp_at < len && (u8)(bytes[exp_at] - '0') < 10 ) {
+                if( exp_number < 0x10000000 ) {
+                    exp_number = (exp_number * 10) + (bytes[exp_at] - '0');
+                }
+                exp_at++;
+            }
+            if( exp_sign ) {
+                exp_number = -exp_number;
+            }
+            exponent += exp_number;
+            at        = exp_at;
         }
-        is_negative = true;
     }
 
-    do {
-        if( !ascii_is_numeric( str.cbuf[index] ) ) {
-            if( !index ) {
-                return false;
+    if( digit_count > 19 ) {
+        // NOTE(alicia): leading zeros are not significant.
+        for( usize i = int_start; i < frac_end; ++i ) {
+            if( bytes[i] == '0' ) {
+                digit_count--;
+            } else if( bytes[i] != '.' ) {
+                break;
             }
-            break;
+        }
+        if( digit_count > 19 ) {
+            out_decimal->truncated = true;
 
+            mantissa = 0;
+            usize i  = int_start;
+            while( mantissa < FLOAT_MIN_NINETEEN_DIGITS && i < int_end ) {
+                mantissa = (mantissa * 10) + (bytes[i++] - '0');
+            }
+            if( mantissa >= FLOAT_MIN_NINETEEN_DIGITS ) {
+                exponent = (i64)(int_end - i) + exp_number;
+            } else {
+                i = frac_start;
+                while( mantissa < FLOAT_MIN_NINETEEN_DIGITS && i < frac_end ) {
+                    mantissa = (mantissa * 10) + (bytes[i++] - '0');
+                }
+                exponent = -(i64)(i - frac_start) + exp_number;
+            }
         }
-        result *= 10;
-        result += str.cbuf[index] - '0';
-    } while( internal_string_read_increment( &index, str.len ) );
+    }
 
-    *out_int = result * ( is_negative ? -1 : 1 );
-    return true;
+    out_decimal->mantissa = mantissa;
+    out_decimal->exponent = exponent;
+    return at;
+}
+/// @brief Parse inf, infinity or nan, ignoring case.
+/// @return Number of bytes parsed, zero if text is not a special value.
+attr_internal
+usize internal_string_parse_float_special(
+    usize len, const u8* bytes, const InternalFloatFormat* format, u64* out_bits
+) {
+    usize at   = 0;
+    u64   sign = 0;
+    if( at < len && (bytes[at] == '-' || bytes[at] == '+') ) {
+        sign = (u64)(bytes[at] == '-') << format->sign_shift;
+        at++;
+    }
+    if( (at + 3) > len ) {
+        return 0;
+    }
 
+    u64 infinity = (u64)format->infinite_power << format->mantissa_bits;
+    if( internal_string_cmp_ascii_nocase( 3, bytes + at, (const u8*)"inf" ) ) {
+        at += 3;
+        if( (at + 5) <= len && internal_string_cmp_ascii_nocase( 5, bytes + at, (const u8*)"inity" ) ) {
+            at += 5;
+        }
+        *out_bits = infinity | sign;
+        return at;
+    }
+    if( internal_string_cmp_ascii_nocase( 3, bytes + at, (const u8*)"nan" ) ) {
+        at += 3;
+        // NOTE(alicia): optional payload, nan(chars), is parsed but ignored.
+        if( at < len && bytes[at] == '(' ) {
+            usize close = at + 1;
+            while(
+                close < len &&
+                (ascii_is_alphanumeric( (char)bytes[close] ) || bytes[close] == '_')
+            ) {
+                close++;
+            }
+            if( close < len && bytes[close] == ')' ) {
+                at = close + 1;
+            }
+        }
+        *out_bits = infinity | (1ULL << (format->mantissa_bits - 1)) | sign;
+        return at;
+    }
+    return 0;
 }
-attr_core_api
-b32 string_parse_uint( struct _StringPOD str, u64* out_uint ) {
-    if( !str.len ) {
-        return false;
+/// @brief Compute correctly rounded w * 10^q with Eisel-Lemire algorithm.
+attr_always_inline inline attr_internal
+InternalFloatAdjusted internal_float_eisel_lemire(
+    i64 q, u64 w, const InternalFloatFormat* format
+) {
+    InternalFloatAdjusted result = {0};
+    if( !w || q < format->smallest_pow10 ) {
+        return result;
+    }
+    if( q > format->largest_pow10 ) {
+        result.power2 = format->infinite_power;
+        return result;
     }
 
-    u64 result = 0;
-    usize index = 0;
+    u32 lz = internal_bits_clz64( w );
+    w <<= lz;
 
-    do {
-        if( !ascii_is_numeric( str.cbuf[index] ) ) {
-            if( !index ) {
-                return false;
+    // NOTE(alicia): only upper mantissa_bits + 3 bits of product are
+    // needed, low half of power only matters when they could carry.
+    usize index          = (usize)(q - FLOAT_POW5_MIN) * 2;
+    u64   precision_mask = ~0ULL >> (format->mantissa_bits + 3);
+    u64   high           = 0;
+    u64   low            = internal_bits_mul64( w, global_float_pow5_128[index], &high );
+    if( (high & precision_mask) == precision_mask ) {
+        u64 second = 0;
+        internal_bits_mul64( w, global_float_pow5_128[index + 1], &second );
+        low += second;
+        if( second > low ) {
+            high++;
+        }
+    }
+
+    i32 upper_bit = (i32)(high >> 63);
+    i32 shift     = upper_bit + 64 - format->mantissa_bits - 3;
+    // NOTE(alicia): (217706 * q) >> 16 is floor(log2(10^q)).
+    i32 power     = (i32)(((152170 + 65536) * q) >> 16) + 63;
+
+    result.mantissa = high >> shift;
+    result.power2   = power + upper_bit - (i32)lz - format->min_exponent;
+    if( result.power2 <= 0 ) {
+        // NOTE(alicia): subnormal, rounding can bring it back up to normal.
+        if( (-result.power2 + 1) >= 64 ) {
+            result.mantissa = 0;
+            result.power2   = 0;
+            return result;
+        }
+        result.mantissa >>= -result.power2 + 1;
+        result.mantissa  += result.mantissa & 1;
+        result.mantissa >>= 1;
+        result.power2     = result.mantissa < (1ULL << format->mantissa_bits) ? 0 : 1;
+        return result;
+    }
+
+    // NOTE(alicia): product is only exact for small powers,
+    // exact halfway cases round to even instead of up.
+    if(
+        low <= 1 &&
+        q >= format->min_round_even && q <= format->max_round_even &&
+        (result.mantissa & 3) == 1
+    ) {
+        if( (result.mantissa << shift) == high ) {
+            result.mantissa &= ~1ULL;
+        }
+    }
+
+    result.mantissa += result.mantissa & 1;
+    result.mantissa >>= 1;
+    if( result.mantissa >= (2ULL << format->mantissa_bits) ) {
+        result.mantissa = 1ULL << format->mantissa_bits;
+        result.power2++;
+    }
+    result.mantissa &= ~(1ULL << format->mantissa_bits);
+    if( result.power2 >= format->infinite_power ) {
+        result.mantissa = 0;
+        result.power2   = format->infinite_power;
+    }
+    return result;
+}
+
+/// @brief Arbitrary precision decimal for slow path, value is 0.digits * 10^point.
+typedef struct InternalFloatBigDecimal {
+    usize count;
+    i64   point;
+    b32   truncated;
+    u8    digits[FLOAT_DECIMAL_MAX_DIGITS];
+} InternalFloatBigDecimal;
+
+/// @brief Largest binary shift for each decimal shift that does not overshoot.
+attr_global const u8 global_float_decimal_shift[19] = {
+    0, 3, 6, 9, 13, 16, 19, 23, 26, 29, 33, 36, 39, 43, 46, 49, 53, 56, 59
+};
+
+attr_always_inline inline attr_internal
+void internal_float_big_trim( InternalFloatBigDecimal* d ) {
+    while( d->count && !d->digits[d->count - 1] ) {
+        d->count--;
+    }
+}
+attr_internal
+void internal_float_big_parse( usize len, const u8* bytes, InternalFloatBigDecimal* d ) {
+    d->count     = 0;
+    d->point     = 0;
+    d->truncated = false;
+
+    usize at       = 0;
+    usize trailing = 0;
+    if( at < len && (bytes[at] == '-' || bytes[at] == '+') ) {
+        at++;
+    }
+    while( at < len && bytes[at] == '0' ) {
+        at++;
+    }
+
+    #define push_digit() do {\
+        u8 digit = bytes[at++] - '0';\
+        if( d->count < FLOAT_DECIMAL_MAX_DIGITS ) {\
+            d->digits[d->count] = digit;\
+        }\
+        d->count++;\
+        trailing = digit ? 0 : trailing + 1;\
+    } while(0)
+
+    while( at < len && (u8)(bytes[at] - '0') < 10 ) {
+        push_digit();
+    }
+    if( at < len && bytes[at] == '.' ) {
+        usize frac_start = ++at;
+        if( !d->count ) {
+            while( at < len && bytes[at] == '0' ) {
+                at++;
+            }
+        }
+        while( at < len && (u8)(bytes[at] - '0') < 10 ) {
+            push_digit();
+        }
+        d->point = -(i64)(at - frac_start);
+    }
+    #undef push_digit
+
+    d->point += (i64)d->count;
+    d->count -= trailing;
+    if( d->count > FLOAT_DECIMAL_MAX_DIGITS ) {
+        d->truncated = true;
+        d->count     = FLOAT_DECIMAL_MAX_DIGITS;
+    }
+
+    if( at < len && (bytes[at] | 0x20) == 'e' ) {
+        at++;
+        b32 negative = false;
+        if( at < len && (bytes[at] == '-' || bytes[at] == '+') ) {
+            negative = bytes[at] == '-';
+            at++;
+        }
+        i64 exponent = 0;
+        while( at < len && (u8)(bytes[at] - '0') < 10 ) {
+            if( exponent < 0x10000 ) {
+                exponent = (exponent * 10) + (bytes[at] - '0');
+            }
+            at++;
+        }
+        d->point += negative ? -exponent : exponent;
+    }
+}
+/// @brief Divide decimal by 2^shift, shift must be <= #FLOAT_DECIMAL_MAX_SHIFT.
+attr_internal
+void internal_float_big_shift_right( InternalFloatBigDecimal* d, u32 shift ) {
+    usize read  = 0;
+    usize write = 0;
+    u64   n     = 0;
+    while( !(n >> shift) ) {
+        if( read < d->count ) {
+            n = (n * 10) + d->digits[read++];
+        } else if( !n ) {
+            return;
+        } else {
+            while( !(n >> shift) ) {
+                n *= 10;
+                read++;
             }
             break;
+        }
+    }
+    d->point -= (i64)read - 1;
+    if( d->point < -FLOAT_DECIMAL_POINT_RANGE ) {
+        d->count     = 0;
+        d->point     = 0;
+        d->truncated = false;
+        return;
+    }
 
+    u64 mask = (1ULL << shift) - 1;
+    while( read < d->count ) {
+        u8 digit = (u8)(n >> shift);
+        n = ((n & mask) * 10) + d->digits[read++];
+        d->digits[write++] = digit;
+    }
+    while( n ) {
+        u8 digit = (u8)(n >> shift);
+        n = (n & mask) * 10;
+        if( write < FLOAT_DECIMAL_MAX_DIGITS ) {
+            d->digits[write++] = digit;
+        } else if( digit ) {
+            d->truncated = true;
         }
-        result *= 10;
-        result += str.cbuf[index] - '0';
-    } while( internal_string_read_increment( &index, str.len ) );
+    }
+    d->count = write;
+    internal_float_big_trim( d );
+}
+/// @brief Multiply decimal by 2^shift, shift must be <= #FLOAT_DECIMAL_MAX_SHIFT.
+attr_internal
+void internal_float_big_shift_left( InternalFloatBigDecimal* d, u32 shift ) {
+    if( !d->count ) {
+        return;
+    }
+    // NOTE(alicia): first pass finds how many digits final carry
+    // adds in front so that second pass can write digits in place.
+    u64 carry = 0;
+    for( usize i = d->count; i-- > 0; ) {
+        carry = (((u64)d->digits[i] << shift) + carry) / 10;
+    }
+    usize extra = 0;
+    for( u64 rest = carry; rest; rest /= 10 ) {
+        extra++;
+    }
 
-    *out_uint = result;
-    return true;
+    carry = 0;
+    for( usize i = d->count; i-- > 0; ) {
+        u64 n = ((u64)d->digits[i] << shift) + carry;
+        carry = n / 10;
+        u8 digit = (u8)(n - (carry * 10));
+        if( (i + extra) < FLOAT_DECIMAL_MAX_DIGITS ) {
+            d->digits[i + extra] = digit;
+        } else if( digit ) {
+            d->truncated = true;
+        }
+    }
+    for( usize i = extra; i-- > 0; ) {
+        u64 next = carry / 10;
+        d->digits[i] = (u8)(carry - (next * 10));
+        carry = next;
+    }
 
+    d->count += extra;
+    if( d->count > FLOAT_DECIMAL_MAX_DIGITS ) {
+        d->count = FLOAT_DECIMAL_MAX_DIGITS;
+    }
+    d->point += (i64)extra;
+    internal_float_big_trim( d );
 }
-attr_hot attr_internal attr_always_inline inline
-u64 internal_string_places( u64 i ) {
-    if( i < 10 ) {
-        return 1;
-    } else if( i < 100 ) {
-        return 2;
-    } else if( i < 1000 ) {
-        return 3;
-    } else if( i < 10000 ) {
-        return 4;
-    } else if( i < 100000 ) {
-        return 5;
-    } else if( i < 1000000 ) {
-        return 6;
-    } else if( i < 10000000 ) {
-        return 7;
-    } else if( i < 100000000 ) {
-        return 8;
-    } else if( i < 1000000000 ) {
-        return 9;
-    } else if( i < 10000000000 ) {
-        return 10;
-    } else if( i < 100000000000 ) {
-        return 11;
-    } else if( i < 1000000000000 ) {
-        return 12;
-    } else if( i < 10000000000000 ) {
-        return 13;
-    } else if( i < 100000000000000 ) {
-        return 14;
-    } else if( i < 1000000000000000 ) {
-        return 15;
-    } else if( i < 10000000000000000 ) {
-        return 16;
-    } else if( i < 100000000000000000 ) {
-        return 17;
-    } else if( i < 1000000000000000000 ) {
-        return 18;
+/// @brief Round integer part of decimal, ties to even.
+attr_internal
+u64 internal_float_big_round( const InternalFloatBigDecimal* d ) {
+    if( !d->count || d->point < 0 ) {
+        return 0;
+    } else if( d->point > 18 ) {
+        return U64_MAX;
+    }
+    usize point  = (usize)d->point;
+    u64   result = 0;
+    for( usize i = 0; i < point; ++i ) {
+        result = (result * 10) + (i < d->count ? d->digits[i] : 0);
     }
+    b32 round_up = false;
+    if( point < d->count ) {
+        round_up = d->digits[point] >= 5;
+        if( d->digits[point] == 5 && (point + 1) == d->count ) {
+            round_up = d->truncated || (point && (d->digits[point - 1] & 1));
+        }
+    }
+    return result + round_up;
+}
+/// @brief Convert text with arbitrary precision, used when Eisel-Lemire is inconclusive.
+attr_internal
+InternalFloatAdjusted internal_float_slow_path(
+    usize len, const u8* bytes, const InternalFloatFormat* format
+) {
+    InternalFloatBigDecimal d;
+    internal_float_big_parse( len, bytes, &d );
 
-    return 0;
+    InternalFloatAdjusted zero     = { .mantissa = 0, .power2 = 0 };
+    InternalFloatAdjusted infinity = { .mantissa = 0, .power2 = format->infinite_power };
+    if( !d.count || d.point < -324 ) {
+        return zero;
+    } else if( d.point >= 310 ) {
+        return infinity;
+    }
+
+    // NOTE(alicia): scale by powers of two until value
+    // is in [1/2, 1), exponent tracks total shift.
+    i32 exp2 = 0;
+    while( d.point > 0 ) {
+        u32 shift = d.point < 19 ?
+            global_float_decimal_shift[d.point] : FLOAT_DECIMAL_MAX_SHIFT;
+        internal_float_big_shift_right( &d, shift );
+        if( d.point < -FLOAT_DECIMAL_POINT_RANGE ) {
+            return zero;
+        }
+        exp2 += (i32)shift;
+    }
+    while( d.point <= 0 ) {
+        u32 shift;
+        if( !d.point ) {
+            if( d.digits[0] >= 5 ) {
+                break;
+            }
+            shift = d.digits[0] < 2 ? 2 : 1;
+        } else {
+            shift = -d.point < 19 ?
+                global_float_decimal_shift[-d.point] : FLOAT_DECIMAL_MAX_SHIFT;
+        }
+        internal_float_big_shift_left( &d, shift );
+        if( d.point > FLOAT_DECIMAL_POINT_RANGE ) {
+            return infinity;
+        }
+        exp2 -= (i32)shift;
+    }
+    exp2--;
+
+    while( (format->min_exponent + 1) > exp2 ) {
+        u32 shift = (u32)((format->min_exponent + 1) - exp2);
+        if( shift > FLOAT_DECIMAL_MAX_SHIFT ) {
+            shift = FLOAT_DECIMAL_MAX_SHIFT;
+        }
+        internal_float_big_shift_right( &d, shift );
+        exp2 += (i32)shift;
+    }
+    if( (exp2 - format->min_exponent) >= format->infinite_power ) {
+        return infinity;
+    }
+
+    u32 mantissa_size = (u32)format->mantissa_bits + 1;
+    internal_float_big_shift_left( &d, mantissa_size );
+    u64 mantissa = internal_float_big_round( &d );
+    if( mantissa >= (1ULL << mantissa_size) ) {
+        internal_float_big_shift_right( &d, 1 );
+        exp2    += 1;
+        mantissa = internal_float_big_round( &d );
+        if( (exp2 - format->min_exponent) >= format->infinite_power ) {
+            return infinity;
+        }
+    }
+
+    InternalFloatAdjusted result;
+    result.power2 = exp2 - format->min_exponent;
+    if( mantissa < (1ULL << format->mantissa_bits) ) {
+        result.power2--;
+    }
+    result.mantissa = mantissa & ((1ULL << format->mantissa_bits) - 1);
+    return result;
 }
-attr_core_api
-b32 string_parse_float( struct _StringPOD str, f64* out_float ) {
-    // f64 result = 0.0;
-    i64 whole_part      = 0;
-    u64 fractional_part = 0;
+/// @brief Parse float from start of text into bits of format.
+/// @return Number of bytes parsed, zero if text does not start with a float.
+attr_always_inline inline attr_internal
+usize internal_string_parse_float(
+    usize len, const u8* bytes, const InternalFloatFormat* format, u64* out_bits
+) {
+    InternalFloatDecimal decimal;
+    usize read = internal_string_parse_decimal( len, bytes, &decimal );
+    if( !read ) {
+        return internal_string_parse_float_special( len, bytes, format, out_bits );
+    }
+    u64 sign = (u64)decimal.negative << format->sign_shift;
 
-    usize dot_position = 0;
     if(
-        string_find( str, '.', &dot_position ) &&
-        dot_position + 1 < str.len
+        !decimal.truncated &&
+        decimal.exponent >= format->min_fast_exponent &&
+        decimal.exponent <= format->max_fast_exponent &&
+        decimal.mantissa <= format->max_fast_mantissa
     ) {
-        struct _StringPOD first = string_empty(), last = string_empty();
-        string_split( str, dot_position, &first, &last );
-        if( !string_parse_int( first, &whole_part ) ) {
-            return false;
+        // NOTE(alicia): both operands are exact so
+        // IEEE rounding of one operation is correct.
+        if( format->sign_shift == 31 ) {
+            union { f32 value; u32 bits; } result;
+            result.value = (f32)decimal.mantissa;
+            if( decimal.exponent < 0 ) {
+                result.value /= global_float_pow10_f32[-decimal.exponent];
+            } else {
+                result.value *= global_float_pow10_f32[decimal.exponent];
+            }
+            *out_bits = result.bits | sign;
+        } else {
+            union { f64 value; u64 bits; } result;
+            result.value = (f64)decimal.mantissa;
+            if( decimal.exponent < 0 ) {
+                result.value /= global_float_pow10_f64[-decimal.exponent];
+            } else {
+                result.value *= global_float_pow10_f64[decimal.exponent];
+            }
+            *out_bits = result.bits | sign;
         }
+        return read;
+    }
 
-        usize zero_count = 0;
-        for( usize i = 0; i < last.len; ++i ) {
-            if( last.buf[i] == '0' ) {
-                zero_count++;
-            }
+    InternalFloatAdjusted adjusted =
+        internal_float_eisel_lemire( decimal.exponent, decimal.mantissa, format );
+    if( decimal.truncated ) {
+        // NOTE(alicia): true value is between w and w + 1,
+        // if both round the same way result is known.
+        InternalFloatAdjusted upper =
+            internal_float_eisel_lemire( decimal.exponent, decimal.mantissa + 1, format );
+        if( upper.mantissa != adjusted.mantissa || upper.power2 != adjusted.power2 ) {
+            adjusted = internal_float_slow_path( read, bytes, format );
         }
+    }
 
-        last.buf   += zero_count;
-        last.len -= zero_count;
+    *out_bits = adjusted.mantissa | ((u64)adjusted.power2 << format->mantissa_bits) | sign;
+    return read;
+}
+/// @brief Skip whitespace and commas between numbers.
+attr_always_inline inline attr_internal
+usize internal_string_skip_number_separators( usize len, const u8* bytes, usize at ) {
+    while( at < len && (bytes[at] == ',' || ascii_is_whitespace( (char)bytes[at] )) ) {
+        at++;
+    }
+    return at;
+}
 
-        if( last.len ) {
-            if( !string_parse_uint( last, &fractional_part ) ) {
-                return false;
-            }
+#undef FLOAT_MIN_NINETEEN_DIGITS
+#undef FLOAT_DECIMAL_MAX_DIGITS
+#undef FLOAT_DECIMAL_POINT_RANGE
+#undef FLOAT_DECIMAL_MAX_SHIFT
+
+attr_core_api
+b32 string_parse_float( struct _StringPOD str, f64* out_float ) {
+    union { u64 bits; f64 value; } result;
+    if( !internal_string_parse_float(
+        str.len, str.bytes, &global_float_format_f64, &result.bits
+    ) ) {
+        return false;
+    }
+    *out_float = result.value;
+    return true;
+}
+attr_core_api
+b32 string_parse_float32( struct _StringPOD str, f32* out_float ) {
+    u64 bits = 0;
+    if( !internal_string_parse_float(
+        str.len, str.bytes, &global_float_format_f32, &bits
+    ) ) {
+        return false;
+    }
+    union { u32 bits; f32 value; } result;
+    result.bits = (u32)bits;
+    *out_float  = result.value;
+    return true;
+}
+attr_core_api
+usize string_parse_float_array(
+    struct _StringPOD str, usize cap, f64* out_floats, usize* opt_out_len
+) {
+    usize count = 0;
+    usize end   = 0;
+    while( count < cap ) {
+        usize at = internal_string_skip_number_separators( str.len, str.bytes, end );
+
+        union { u64 bits; f64 value; } result;
+        usize read = internal_string_parse_float(
+            str.len - at, str.bytes + at, &global_float_format_f64, &result.bits );
+        if( !read ) {
+            break;
+        }
+        out_floats[count++] = result.value;
+        end = at + read;
+    }
+    if( opt_out_len ) {
+        *opt_out_len = end;
+    }
+    return count;
+}
+attr_core_api
+usize string_parse_float32_array(
+    struct _StringPOD str, usize cap, f32* out_floats, usize* opt_out_len
+) {
+    usize count = 0;
+    usize end   = 0;
+    while( count < cap ) {
+        usize at = internal_string_skip_number_separators( str.len, str.bytes, end );
+
+        u64   bits = 0;
+        usize read = internal_string_parse_float(
+            str.len - at, str.bytes + at, &global_float_format_f32, &bits );
+        if( !read ) {
+            break;
         }
+        union { u32 bits; f32 value; } result;
+        result.bits = (u32)bits;
+        out_floats[count++] = result.value;
+        end = at + read;
+    }
+    if( opt_out_len ) {
+        *opt_out_len = end;
+    }
+    return count;
+}
 
-        *out_float = (f64)whole_part;
-        f64 fractional_part_f64 = (f64)fractional_part;
-        u64 places = internal_string_places( fractional_part );
+// NOTE(alicia): integer parsing reads optional sign, optional radix
+// prefix (0x, 0b or 0o) and digits. decimal digits after leading
+// zeros are converted 16 at a time with SSE2 when available and
+// 8 at a time with SWAR otherwise, first 19 digits cannot overflow
+// so only digits past them are checked.
 
-        u64 pow = places + zero_count;
-        if( pow ) {
-            fractional_part_f64 /= (f64)f32_powi( 10.0f, pow );
+/// @brief Value of ASCII digit in radix up to 16, 16 or more if byte is not a digit.
+attr_always_inline inline attr_internal
+u32 internal_string_radix_digit( u8 c ) {
+    u32 digit = (u8)(c - '0');
+    if( digit < 10 ) {
+        return digit;
+    }
+    digit = (u8)((c | 0x20) - 'a');
+    return digit < 6 ? digit + 10 : 16;
+}
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+/// @brief Count leading ASCII digits in 16 bytes.
+attr_always_inline inline attr_internal
+u32 internal_string_sse_digit_count( __m128i v ) {
+    // NOTE(alicia): unsigned v - '0' < 10 as signed compare.
+    __m128i biased = _mm_xor_si128(
+        _mm_sub_epi8( v, _mm_set1_epi8( '0' ) ), _mm_set1_epi8( (char)0x80 ) );
+    __m128i not_digit = _mm_cmpgt_epi8( biased, _mm_set1_epi8( (char)(0x80 + 9) ) );
+    return internal_bits_ctz32( (u32)_mm_movemask_epi8( not_digit ) | 0x10000 );
+}
+/// @brief Convert 16 ASCII digits.
+attr_always_inline inline attr_internal
+u64 internal_string_parse_sixteen_digits( __m128i v ) {
+    // NOTE(alicia): digits are widened to 16-bit and combined
+    // into pairs, 4 digit groups then 8 digit halves,
+    // each step is a multiply-add of adjacent lanes.
+    __m128i zero   = _mm_setzero_si128();
+    __m128i digits = _mm_sub_epi8( v, _mm_set1_epi8( '0' ) );
+    __m128i low    = _mm_madd_epi16(
+        _mm_unpacklo_epi8( digits, zero ), _mm_set_epi16( 1, 10, 1, 10, 1, 10, 1, 10 ) );
+    __m128i high   = _mm_madd_epi16(
+        _mm_unpackhi_epi8( digits, zero ), _mm_set_epi16( 1, 10, 1, 10, 1, 10, 1, 10 ) );
+
+    __m128i quads  = _mm_madd_epi16(
+        _mm_packs_epi32( low, high ), _mm_set_epi16( 1, 100, 1, 100, 1, 100, 1, 100 ) );
+    __m128i halves = _mm_madd_epi16(
+        _mm_packs_epi32( quads, quads ),
+        _mm_set_epi16( 1, 10000, 1, 10000, 1, 10000, 1, 10000 ) );
+
+    u64 first  = (u32)_mm_cvtsi128_si32( halves );
+    u64 second = (u32)_mm_cvtsi128_si32( _mm_srli_si128( halves, 4 ) );
+    return (first * 100000000) + second;
+}
+#endif
+/// @brief Parse run of decimal digits, checking for overflow.
+/// @return Index of first byte that is not a digit, zero if there are no digits or value overflowed.
+attr_always_inline inline attr_internal
+usize internal_string_parse_uint_decimal(
+    usize len, const u8* bytes, usize at, u64* out_value
+) {
+    usize start = at;
+    while( at < len && bytes[at] == '0' ) {
+        at++;
+    }
+
+    usize first = at;
+    u64   value = 0;
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+    if( (at + 16) <= len ) {
+        __m128i v = _mm_loadu_si128( (const __m128i*)(bytes + at) );
+        if( internal_string_sse_digit_count( v ) == 16 ) {
+            value = internal_string_parse_sixteen_digits( v );
+            at   += 16;
+        }
+    }
+#endif
+    while( (at + 8) <= len && (at - first) <= 11 ) {
+        u64 chunk = internal_bits_load_le64( bytes + at );
+        if( !internal_string_is_eight_digits( chunk ) ) {
+            break;
         }
+        value = (value * 100000000) + internal_string_parse_eight_digits( chunk );
+        at   += 8;
+    }
+    while( at < len && (at - first) < 19 && (u8)(bytes[at] - '0') < 10 ) {
+        value = (value * 10) + (bytes[at] - '0');
+        at++;
+    }
+    while( at < len && (u8)(bytes[at] - '0') < 10 ) {
+        u64 digit = bytes[at] - '0';
+        if( value > (U64_MAX / 10) || (value == (U64_MAX / 10) && digit > (U64_MAX % 10)) ) {
+            return 0;
+        }
+        value = (value * 10) + digit;
+        at++;
+    }
 
-        if( whole_part < 0 ) {
-            *out_float -= fractional_part_f64;
-        } else {
-            *out_float += fractional_part_f64;
+    if( at == start ) {
+        return 0;
+    }
+    *out_value = value;
+    return at;
+}
+/// @brief Parse run of digits in radix 2, 8 or 16, checking for overflow.
+/// @param shift Log2 of radix.
+/// @return Index of first byte that is not a digit, zero if there are no digits or value overflowed.
+attr_always_inline inline attr_internal
+usize internal_string_parse_uint_radix(
+    usize len, const u8* bytes, usize at, u32 shift, u64* out_value
+) {
+    usize start = at;
+    u32   radix = 1u << shift;
+    u64   value = 0;
+    if( shift == 1 ) {
+        // NOTE(alicia): multiply gathers low bit of each byte
+        // into top byte, first digit ending up most significant.
+        while( (at + 8) <= len ) {
+            u64 chunk = internal_bits_load_le64( bytes + at );
+            if( (chunk & 0xFEFEFEFEFEFEFEFEULL) != 0x3030303030303030ULL ) {
+                break;
+            }
+            if( value >> 56 ) {
+                return 0;
+            }
+            chunk -= 0x3030303030303030ULL;
+            value  = (value << 8) | ((chunk * 0x8040201008040201ULL) >> 56);
+            at    += 8;
+        }
+    }
+    while( at < len ) {
+        u32 digit = internal_string_radix_digit( bytes[at] );
+        if( digit >= radix ) {
+            break;
         }
+        if( value >> (64 - shift) ) {
+            return 0;
+        }
+        value = (value << shift) | digit;
+        at++;
+    }
 
-        return true;
+    if( at == start ) {
+        return 0;
+    }
+    *out_value = value;
+    return at;
+}
+/// @brief Parse optional radix prefix and digits of unsigned integer.
+/// @return Index of first byte after integer, zero if there is no integer or value overflowed.
+attr_always_inline inline attr_internal
+usize internal_string_parse_uint_digits(
+    usize len, const u8* bytes, usize at, u64* out_value
+) {
+    if( (at + 2) < len && bytes[at] == '0' ) {
+        u32 shift = 0;
+        switch( bytes[at + 1] | 0x20 ) {
+            case 'x': shift = 4; break;
+            case 'o': shift = 3; break;
+            case 'b': shift = 1; break;
+            default: break;
+        }
+        // NOTE(alicia): prefix without digits is parsed as just 0.
+        if( shift && internal_string_radix_digit( bytes[at + 2] ) < (1u << shift) ) {
+            return internal_string_parse_uint_radix( len, bytes, at + 2, shift, out_value );
+        }
+    }
+    return internal_string_parse_uint_decimal( len, bytes, at, out_value );
+}
+/// @brief Parse unsigned integer with optional plus sign.
+/// @return Number of bytes parsed, zero if text does not start with integer or value overflowed.
+attr_internal
+usize internal_string_parse_uint( usize len, const u8* bytes, u64* out_uint ) {
+    usize at = 0;
+    if( at < len && bytes[at] == '+' ) {
+        at++;
+    }
+    return internal_string_parse_uint_digits( len, bytes, at, out_uint );
+}
+/// @brief Parse signed integer with optional sign.
+/// @return Number of bytes parsed, zero if text does not start with integer or value overflowed.
+attr_internal
+usize internal_string_parse_int( usize len, const u8* bytes, i64* out_int ) {
+    usize at       = 0;
+    b32   negative = false;
+    if( at < len && (bytes[at] == '-' || bytes[at] == '+') ) {
+        negative = bytes[at] == '-';
+        at++;
+    }
+
+    u64   magnitude = 0;
+    usize read      = internal_string_parse_uint_digits( len, bytes, at, &magnitude );
+    if( !read ) {
+        return 0;
+    }
+    if( negative ) {
+        if( magnitude > ((u64)I64_MAX + 1) ) {
+            return 0;
+        }
+        *out_int = (i64)(0 - magnitude);
     } else {
-        b32 success = string_parse_int( str, &whole_part );
-        if( success ) {
-            *out_float = (f64)whole_part;
-            return success;
-        } else {
-            return success;
+        if( magnitude > (u64)I64_MAX ) {
+            return 0;
         }
+        *out_int = (i64)magnitude;
+    }
+    return read;
+}
+
+attr_core_api
+b32 string_parse_int( struct _StringPOD str, i64* out_int ) {
+    return internal_string_parse_int( str.len, str.bytes, out_int ) != 0;
+}
+attr_core_api
+b32 string_parse_uint( struct _StringPOD str, u64* out_uint ) {
+    return internal_string_parse_uint( str.len, str.bytes, out_uint ) != 0;
+}
+attr_core_api
+usize string_parse_int_prefix( struct _StringPOD str, i64* out_int ) {
+    return internal_string_parse_int( str.len, str.bytes, out_int );
+}
+attr_core_api
+usize string_parse_uint_prefix( struct _StringPOD str, u64* out_uint ) {
+    return internal_string_parse_uint( str.len, str.bytes, out_uint );
+}
+attr_core_api
+usize string_parse_int_array(
+    struct _StringPOD str, usize cap, i64* out_ints, usize* opt_out_len
+) {
+    usize count = 0;
+    usize end   = 0;
+    while( count < cap ) {
+        usize at   = internal_string_skip_number_separators( str.len, str.bytes, end );
+        usize read = internal_string_parse_int(
+            str.len - at, str.bytes + at, out_ints + count );
+        if( !read ) {
+            break;
+        }
+        count++;
+        end = at + read;
+    }
+    if( opt_out_len ) {
+        *opt_out_len = end;
+    }
+    return count;
+}
+attr_core_api
+usize string_parse_uint_array(
+    struct _StringPOD str, usize cap, u64* out_uints, usize* opt_out_len
+) {
+    usize count = 0;
+    usize end   = 0;
+    while( count < cap ) {
+        usize at   = internal_string_skip_number_separators( str.len, str.bytes, end );
+        usize read = internal_string_parse_uint(
+            str.len - at, str.bytes + at, out_uints + count );
+        if( !read ) {
+            break;
+        }
+        count++;
+        end = at + read;
+    }
+    if( opt_out_len ) {
+        *opt_out_len = end;
     }
+    return count;
 }
 
 attr_core_api
@@ -745,3 +2423,5 @@ bsize string_buf_fmt_va(
     return stream_fmt_va( string_buf_stream, &target, format, va ) != 0;
 }
 
+#undef VECTOR_MIN_LEN
+#undef STRING_STREAM_BLOCK_SIZE
@@ -116,16 +116,22 @@ void mutex_unlock( struct Mutex* mtx ) {
 }
 attr_core_api
 b32 mutex_lock_timed( struct Mutex* mtx, u32 ms ) {
-    if( ms == CORE_WAIT_INFINITE ) {
-        atomic_spinlock( &mtx->atom, 0 );
-    } else {
-        if( !atomic_spinlock_timed( &mtx->atom, 0, ms ) ) {
-            return false;
+    for( ;; ) {
+        if( ms == CORE_WAIT_INFINITE ) {
+            atomic_spinlock( &mtx->atom, 0 );
+        } else {
+            if( !atomic_spinlock_timed( &mtx->atom, 0, ms ) ) {
+                return false;
+            }
         }
-    }
 
-    atomic_exchange32( &mtx->atom, 1 );
-    return true;
+        // NOTE(alicia): another thread may have taken the lock
+        // between the spinlock and here so only take the lock
+        // if it's still unlocked.
+        if( atomic_compare_exchange32( &mtx->atom, 0, 1 ) == 0 ) {
+            return true;
+        }
+    }
 }
 
 attr_internal
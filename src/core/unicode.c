@@ -6,7 +6,109 @@
 */
 #include "core/unicode.h"
 
-// TODO(alicia): 
+#include "core/memory.h"
+#include "core/internal/bits.h"
+
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+    #include "core/internal/sse.h" // IWYU pragma: keep
+#endif
+
+#include "src/core/unicode_tables.c"
+
+// NOTE(alicia): UTF-8 validation is a DFA over byte classes.
+// Classes split continuation bytes into 80-8F, 90-9F and A0-BF
+// so that overlong forms, surrogates and code points past
+// U+10FFFF are rejected on the second byte.
+// Each class has a row with the next state of all 9 states
+// packed into 6 bit fields and states are bit offsets into
+// row, so transition is a shift and mask which keeps the
+// dependency chain between bytes short.
+
+#define UTF8_CLASS_COUNT (12)
+#define UTF8_ACCEPT      (0)
+#define UTF8_REJECT      (8 * 6)
+
+#define UNICODE_REPLACEMENT_RUNE  (0xFFFD)
+#define UNICODE_STREAM_BLOCK_SIZE (1024)
+
+attr_global
+const u8 global_utf8_byte_class[256] = {
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,
+     2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,
+     3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,
+     3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,
+     4,  4,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,
+     5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,
+     6,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  8,  7,  7,
+     9, 10, 10, 10, 11,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,
+};
+/// @brief Sequence length of each byte class, zero if class can not start a sequence.
+attr_global
+const u8 global_utf8_class_sequence_len[UTF8_CLASS_COUNT] = {
+    1, 0, 0, 0, 0, 2, 3, 3, 3, 4, 4, 4,
+};
+attr_global
+const u64 global_utf8_class_rows[UTF8_CLASS_COUNT] = {
+    0x0030C30C30C30C00ull, // ASCII
+    0x00303301B0306030ull, // 80-8F
+    0x0030C0C1B0306030ull, // 90-9F
+    0x0030C0CC06306030ull, // A0-BF
+    0x0030C30C30C30C30ull, // C0-C1, F5-FF
+    0x0030C30C30C30C06ull, // C2-DF
+    0x0030C30C30C30C18ull, // E0
+    0x0030C30C30C30C0Cull, // E1-EC, EE-EF
+    0x0030C30C30C30C1Eull, // ED
+    0x0030C30C30C30C24ull, // F0
+    0x0030C30C30C30C12ull, // F1-F3
+    0x0030C30C30C30C2Aull, // F4
+};
+
+attr_always_inline inline attr_internal
+u32 internal_utf8_step( u32 state, u8 byte ) {
+    return (u32)(global_utf8_class_rows[global_utf8_byte_class[byte]] >> state) & 63;
+}
+/// @brief Skip ASCII bytes. Returns offset of first non-ASCII byte or a position close to end.
+attr_always_inline inline attr_internal
+usize internal_utf8_skip_ascii( usize len, const u8* bytes, usize at ) {
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+    while( (at + 64) <= len ) {
+        __m128i a = _mm_loadu_si128( (const __m128i*)(bytes + at) );
+        __m128i b = _mm_loadu_si128( (const __m128i*)(bytes + at + 16) );
+        __m128i c = _mm_loadu_si128( (const __m128i*)(bytes + at + 32) );
+        __m128i d = _mm_loadu_si128( (const __m128i*)(bytes + at + 48) );
+        __m128i any = _mm_or_si128( _mm_or_si128( a, b ), _mm_or_si128( c, d ) );
+        if( _mm_movemask_epi8( any ) ) {
+            break;
+        }
+        at += 64;
+    }
+    while( (at + 16) <= len ) {
+        int mask = _mm_movemask_epi8( _mm_loadu_si128( (const __m128i*)(bytes + at) ) );
+        if( mask ) {
+            return at + internal_bits_ctz32( (u32)mask );
+        }
+        at += 16;
+    }
+#else
+    while( (at + 8) <= len ) {
+        u64 word;
+        memory_copy( &word, bytes + at, sizeof(word) );
+        if( word & 0x8080808080808080ull ) {
+            break;
+        }
+        at += 8;
+    }
+#endif
+    return at;
+}
 
 attr_core_api
 UnicodeValidationResult unicode_utf8_validate(
@@ -18,124 +120,85 @@ UnicodeValidationResult unicode_utf8_validate(
         return UNICODE_RESULT_UNFINISHED;
     }
 
-    if( !(uc[0] & ~0x7F) ) {
-        if( opt_out_rune ) {
-            *opt_out_rune = uc[0];
-        }
-        if( opt_out_advance ) {
-            *opt_out_advance = 1;
-        }
-        return UNICODE_RESULT_OK;
-    } else if( (uc[0] & 0xE0) == 0xC0 ) {
-        if( len >= 2 ) {
-            rune32 rune = uc[0] & 0x1F;
-
-            if( (uc[1] & 0xC0) != 0x80 ) {
-                if( opt_out_error ) {
-                    *opt_out_error = utf8 + 1;
-                }
-                return UNICODE_RESULT_INVALID;
-            }
-
-            rune = ( rune << 6 ) | ( uc[1] & 0x3F );
+    u32 expected = global_utf8_class_sequence_len[global_utf8_byte_class[uc[0]]];
+    u32 count    = expected;
+    if( count > len ) {
+        count = (u32)len;
+    }
 
-            if( opt_out_rune ) {
-                *opt_out_rune = rune;
-            }
-            if( opt_out_advance ) {
-                *opt_out_advance = 2;
-            }
-            return UNICODE_RESULT_OK;
-        } else {
-            if( opt_out_advance ) {
-                *opt_out_advance = 2 - len;
-            }
-            return UNICODE_RESULT_UNFINISHED;
+    u32 state = internal_utf8_step( UTF8_ACCEPT, uc[0] );
+    if( state == UTF8_REJECT ) {
+        if( opt_out_error ) {
+            *opt_out_error = utf8;
         }
-    } else if( (uc[0] & 0xF0) == 0xE0 ) {
-        if( len >= 3 ) {
-            rune32 rune = uc[0] & 0x0F;
-
-            if( (uc[1] & 0xC0) != 0x80 ) {
-                if( opt_out_error ) {
-                    *opt_out_error = utf8 + 1;
-                }
-                return UNICODE_RESULT_INVALID;
-            }
-            rune = ( rune << 6 ) | ( uc[1] & 0x3F );
-
-            if( (uc[2] & 0xC0) != 0x80 ) {
-                if( opt_out_error ) {
-                    *opt_out_error = utf8 + 2;
-                }
-                return UNICODE_RESULT_INVALID;
-            }
-            rune = ( rune << 6 ) | ( uc[2] & 0x3F );
+        return UNICODE_RESULT_INVALID;
+    }
 
-            if( opt_out_rune ) {
-                *opt_out_rune = rune;
-            }
-            if( opt_out_advance ) {
-                *opt_out_advance = 3;
-            }
-            return UNICODE_RESULT_OK;
-        } else {
-            if( opt_out_advance ) {
-                *opt_out_advance = 3 - len;
+    rune32 rune = uc[0] & (expected < 2 ? 0x7F : (0xFF >> (expected + 1)));
+    for( u32 i = 1; i < count; ++i ) {
+        state = internal_utf8_step( state, uc[i] );
+        if( state == UTF8_REJECT ) {
+            if( opt_out_error ) {
+                *opt_out_error = utf8 + i;
             }
-            return UNICODE_RESULT_UNFINISHED;
+            return UNICODE_RESULT_INVALID;
         }
-    } else if( (uc[0] & 0xF8) == 0xF0 ) {
-        if( len >= 4 ) {
-            rune32 rune = uc[0] & 0x07;
-
-            if( (uc[1] & 0xC0) != 0x80 ) {
-                if( opt_out_error ) {
-                    *opt_out_error = utf8 + 1;
-                }
-                return UNICODE_RESULT_INVALID;
-            }
-            rune = ( rune << 6 ) | ( uc[1] & 0x37 );
-
-            if( (uc[2] & 0xC0) != 0x80 ) {
-                if( opt_out_error ) {
-                    *opt_out_error = utf8 + 2;
-                }
-                return UNICODE_RESULT_INVALID;
-            }
-            rune = ( rune << 6 ) | ( uc[2] & 0x37 );
+        rune = (rune << 6) | (uc[i] & 0x3F);
+    }
 
-            if( (uc[3] & 0xC0) != 0x80 ) {
-                if( opt_out_error ) {
-                    *opt_out_error = utf8 + 3;
-                }
-                return UNICODE_RESULT_INVALID;
-            }
-            rune = ( rune << 6 ) | ( uc[3] & 0x37 );
+    if( state != UTF8_ACCEPT ) {
+        if( opt_out_advance ) {
+            *opt_out_advance = expected - (u32)len;
+        }
+        return UNICODE_RESULT_UNFINISHED;
+    }
 
-            if( rune > 0x10FFFF ) {
-                if( opt_out_error ) {
-                    *opt_out_error = utf8 + 3;
-                }
-                return UNICODE_RESULT_INVALID;
+    if( opt_out_rune ) {
+        *opt_out_rune = rune;
+    }
+    if( opt_out_advance ) {
+        *opt_out_advance = expected;
+    }
+    return UNICODE_RESULT_OK;
+}
+attr_core_api
+UnicodeValidationResult unicode_utf8_validate_string(
+    usize len, const c8* utf8, usize* opt_out_error_offset
+) {
+    const u8* bytes = (const u8*)utf8;
+    u32   state = UTF8_ACCEPT;
+    usize start = 0;
+    usize at    = 0;
+
+    while( at < len ) {
+        if( (state == UTF8_ACCEPT) && !(bytes[at] & 0x80) ) {
+            at    = internal_utf8_skip_ascii( len, bytes, at );
+            start = at;
+            if( at >= len ) {
+                break;
             }
+        }
 
-            if( opt_out_advance ) {
-                *opt_out_advance = 4;
-            }
-            return UNICODE_RESULT_OK;
-        } else {
-            if( opt_out_advance ) {
-                *opt_out_advance = 4 - len;
-            }
-            return UNICODE_RESULT_UNFINISHED;
+        // NOTE(alicia): reject state never leaves so it is only
+        // checked once per block, start of last complete code point
+        // is tracked without branching.
+        usize block_end = (len - at) < 16 ? len : at + 16;
+        while( at < block_end ) {
+            state = internal_utf8_step( state, bytes[at++] );
+            start = (state == UTF8_ACCEPT) ? at : start;
+        }
+        if( state == UTF8_REJECT ) {
+            break;
         }
     }
 
-    if( opt_out_error ) {
-        *opt_out_error = utf8;
+    if( state == UTF8_ACCEPT ) {
+        return UNICODE_RESULT_OK;
     }
-    return UNICODE_RESULT_INVALID;
+    if( opt_out_error_offset ) {
+        *opt_out_error_offset = start;
+    }
+    return state == UTF8_REJECT ? UNICODE_RESULT_INVALID : UNICODE_RESULT_UNFINISHED;
 }
 attr_core_api
 UnicodeValidationResult unicode_utf16_validate(
@@ -146,49 +209,39 @@ UnicodeValidationResult unicode_utf16_validate(
         return UNICODE_RESULT_UNFINISHED;
     }
 
-    if( utf16[0] <= 0xD7FF ) {
-        // FIXME(alicia): may still be invalid
-        rune32 rune = utf16[0];
-
+    if( (utf16[0] < 0xD800) || (utf16[0] > 0xDFFF) ) {
         if( opt_out_rune ) {
-            *opt_out_rune = rune;
+            *opt_out_rune = utf16[0];
         }
         if( opt_out_advance ) {
             *opt_out_advance = 1;
         }
         return UNICODE_RESULT_OK;
     } else if( utf16[0] <= 0xDBFF ) {
-        if( len >= 2 ) {
-            rune32 rune = 0;
-
-            u16 hi = ( utf16[0] - 0xD800 ) * 0x400;
-            u16 lo = ( utf16[1] - 0xDC00 );
-
-            rune = (lo | hi) + 0x10000;
-
-            if( rune > 0x10FFFF ) {
-                if( opt_out_error ) {
-                    *opt_out_error = utf16 + 2;
-                }
-                return UNICODE_RESULT_INVALID;
-            }
-            // FIXME(alicia): may still be invalid
-
-            if( opt_out_rune ) {
-                *opt_out_rune = rune;
-            }
+        if( len < 2 ) {
             if( opt_out_advance ) {
-                *opt_out_advance = 2;
-            }
-            return UNICODE_RESULT_OK;
-        } else {
-            if( opt_out_advance ) {
-                *opt_out_advance = 2 - len;
+                *opt_out_advance = 1;
             }
             return UNICODE_RESULT_UNFINISHED;
         }
+        if( (utf16[1] < 0xDC00) || (utf16[1] > 0xDFFF) ) {
+            if( opt_out_error ) {
+                *opt_out_error = utf16 + 1;
+            }
+            return UNICODE_RESULT_INVALID;
+        }
+
+        if( opt_out_rune ) {
+            *opt_out_rune =
+                ((((rune32)utf16[0] - 0xD800) << 10) | ((rune32)utf16[1] - 0xDC00)) + 0x10000;
+        }
+        if( opt_out_advance ) {
+            *opt_out_advance = 2;
+        }
+        return UNICODE_RESULT_OK;
     }
 
+    // NOTE(alicia): unpaired low surrogate.
     if( opt_out_error ) {
         *opt_out_error = utf16;
     }
@@ -203,15 +256,13 @@ UnicodeValidationResult unicode_utf32_validate(
         return UNICODE_RESULT_UNFINISHED;
     }
 
-    if( *utf32 > 0x10FFFF ) {
+    if( (*utf32 > 0x10FFFF) || ((*utf32 >= 0xD800) && (*utf32 <= 0xDFFF)) ) {
         if( opt_out_error ) {
             *opt_out_error = utf32;
         }
         return UNICODE_RESULT_INVALID;
     }
 
-    // FIXME(alicia): may still be invalid
-
     if( opt_out_rune ) {
         *opt_out_rune = *utf32;
     }
@@ -265,11 +316,11 @@ u32 unicode_cp16_from_string( usize len, const c16* utf16, UTFCodePoint16* out_c
         return 0;
     }
 
-    if( utf16[0] <= 0xD7FF ) {
+    if( (utf16[0] <= 0xD7FF) || (utf16[0] >= 0xE000) ) {
         *out_cp16 = unicode_cp16_from_code_units( utf16[0], 0 );
         return 1;
     } else if( utf16[0] <= 0xDBFF ) {
-        if( len >= 2 ) {
+        if( (len >= 2) && ((utf16[1] & 0xFC00) == 0xDC00) ) {
             *out_cp16 = unicode_cp16_from_code_units( utf16[0], utf16[1] );
             return 2;
         } else {
@@ -296,142 +347,764 @@ u32 unicode_cp32_from_string( usize len, const c32* utf32, UTFCodePoint32* out_c
     return 1;
 }
 
-attr_core_api
-usize unicode_utf8_from_utf16(
-    StreamBytesFN* stream, void* target, usize len, const c16* string
-) {
-    usize result = 0;
+/// @brief Decode next UTF-8 code point, invalid sequences decode to U+FFFD.
+/// @details
+/// Invalid sequences consume the longest prefix that could have
+/// started a valid sequence, at least one byte.
+attr_always_inline inline attr_internal
+u32 internal_utf8_decode( usize len, const u8* bytes, rune32* out_rune ) {
+    u32 expected = global_utf8_class_sequence_len[global_utf8_byte_class[bytes[0]]];
+    u32 state    = internal_utf8_step( UTF8_ACCEPT, bytes[0] );
+    if( state == UTF8_REJECT ) {
+        *out_rune = UNICODE_REPLACEMENT_RUNE;
+        return 1;
+    }
 
-    const c16* utf16     = string;
-    usize      remaining = len;
-    while( remaining ) {
-        UTFCodePoint16 cp16 = {};
-        usize advance = unicode_cp16_from_string( remaining, utf16, &cp16 );
+    rune32 rune = bytes[0] & (expected < 2 ? 0x7F : (0xFF >> (expected + 1)));
+    for( u32 i = 1; i < expected; ++i ) {
+        if( i >= len ) {
+            *out_rune = UNICODE_REPLACEMENT_RUNE;
+            return i;
+        }
+        state = internal_utf8_step( state, bytes[i] );
+        if( state == UTF8_REJECT ) {
+            *out_rune = UNICODE_REPLACEMENT_RUNE;
+            return i;
+        }
+        rune = (rune << 6) | (bytes[i] & 0x3F);
+    }
+    *out_rune = rune;
+    return expected;
+}
+/// @brief Decode next UTF-16 code point, unpaired surrogates decode to U+FFFD.
+attr_always_inline inline attr_internal
+u32 internal_utf16_decode( usize len, const c16* units, rune32* out_rune ) {
+    rune32 unit = units[0];
+    if( (unit & 0xF800) != 0xD800 ) {
+        *out_rune = unit;
+        return 1;
+    }
+    if( (unit <= 0xDBFF) && (len >= 2) && ((units[1] & 0xFC00) == 0xDC00) ) {
+        *out_rune = (((unit - 0xD800) << 10) | ((rune32)units[1] - 0xDC00)) + 0x10000;
+        return 2;
+    }
+    *out_rune = UNICODE_REPLACEMENT_RUNE;
+    return 1;
+}
+/// @brief Decode UTF-32 code unit, surrogates and out of range values decode to U+FFFD.
+attr_always_inline inline attr_internal
+rune32 internal_utf32_decode( c32 unit ) {
+    if( (unit > 0x10FFFF) || ((unit & 0xFFFFF800) == 0xD800) ) {
+        return UNICODE_REPLACEMENT_RUNE;
+    }
+    return unit;
+}
+attr_always_inline inline attr_internal
+u32 internal_utf8_rune_len( rune32 rune ) {
+    return 1 + (rune >= 0x80) + (rune >= 0x800) + (rune >= 0x10000);
+}
+attr_always_inline inline attr_internal
+void internal_utf8_encode( rune32 rune, u32 count, u8* out ) {
+    switch( count ) {
+        case 1: {
+            out[0] = (u8)rune;
+        } break;
+        case 2: {
+            out[0] = (u8)(0xC0 | (rune >> 6));
+            out[1] = (u8)(0x80 | (rune & 0x3F));
+        } break;
+        case 3: {
+            out[0] = (u8)(0xE0 | (rune >> 12));
+            out[1] = (u8)(0x80 | ((rune >> 6) & 0x3F));
+            out[2] = (u8)(0x80 | (rune & 0x3F));
+        } break;
+        default: {
+            out[0] = (u8)(0xF0 | (rune >> 18));
+            out[1] = (u8)(0x80 | ((rune >> 12) & 0x3F));
+            out[2] = (u8)(0x80 | ((rune >> 6) & 0x3F));
+            out[3] = (u8)(0x80 | (rune & 0x3F));
+        } break;
+    }
+}
+attr_always_inline inline attr_internal
+void internal_utf16_encode( rune32 rune, u32 count, c16* out ) {
+    if( count == 1 ) {
+        out[0] = (c16)rune;
+    } else {
+        rune  -= 0x10000;
+        out[0] = (c16)(0xD800 + (rune >> 10));
+        out[1] = (c16)(0xDC00 + (rune & 0x3FF));
+    }
+}
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+/// @brief Check if block is exactly 8 valid 2 byte sequences.
+attr_always_inline inline attr_internal
+b32 internal_utf8_is_two_byte_block( __m128i v ) {
+    // NOTE(alicia): little endian, lead is low byte of each 16-bit lane.
+    u32 shape = (u32)_mm_movemask_epi8( _mm_cmpeq_epi16(
+        _mm_and_si128( v, _mm_set1_epi16( (i16)0xC0E0 ) ), _mm_set1_epi16( (i16)0x80C0 ) ) );
+    u32 overlong = (u32)_mm_movemask_epi8( _mm_cmpeq_epi16(
+        _mm_and_si128( v, _mm_set1_epi16( 0x1E ) ), _mm_setzero_si128() ) );
+    return (shape == 0xFFFF) && !overlong;
+}
+/// @brief Decode block of 8 2 byte sequences into 8 16-bit runes.
+attr_always_inline inline attr_internal
+__m128i internal_utf8_decode_two_byte_block( __m128i v ) {
+    return _mm_or_si128(
+        _mm_slli_epi16( _mm_and_si128( v, _mm_set1_epi16( 0x1F ) ), 6 ),
+        _mm_and_si128( _mm_srli_epi16( v, 8 ), _mm_set1_epi16( 0x3F ) ) );
+}
+#endif
+/// @brief Count code points in UTF-8 string, optionally counting 4 byte sequences twice.
+attr_internal
+usize internal_utf8_count( usize len, const u8* bytes, b32 count_surrogate_pairs ) {
+    usize result = 0;
+    usize at     = 0;
+
+    if( unicode_utf8_validate_string( len, (const c8*)bytes, NULL ) != UNICODE_RESULT_OK ) {
+        // NOTE(alicia): invalid sequences do not map to
+        // one code point per lead byte.
+        while( at < len ) {
+            rune32 rune;
+            at     += internal_utf8_decode( len - at, bytes + at, &rune );
+            result += 1 + (count_surrogate_pairs && (rune >= 0x10000));
+        }
+        return result;
+    }
 
-        UTFCodePoint8 cp8 = unicode_cp8_from_cp16( cp16 );
+    // NOTE(alicia): valid UTF-8 has one non-continuation byte
+    // per code point and one 4 byte lead per surrogate pair.
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+    __m128i continuation = _mm_set1_epi8( (char)0xC0 );
+    __m128i four_lead    = _mm_set1_epi8( (char)0xF0 );
+    while( (at + 16) <= len ) {
+        __m128i v = _mm_loadu_si128( (const __m128i*)(bytes + at) );
+        u32 cont  = (u32)_mm_movemask_epi8( _mm_cmplt_epi8( v, continuation ) );
+        u32 lead  = (u32)_mm_movemask_epi8( v ) & ~cont;
+        result   += 16 - internal_bits_popcount32( cont );
+        if( count_surrogate_pairs && lead ) {
+            u32 four = (u32)_mm_movemask_epi8(
+                _mm_cmpeq_epi8( _mm_max_epu8( v, four_lead ), v ) );
+            result += internal_bits_popcount32( four );
+        }
+        at += 16;
+    }
+#endif
+    for( ; at < len; ++at ) {
+        result += (bytes[at] & 0xC0) != 0x80;
+        result += count_surrogate_pairs && (bytes[at] >= 0xF0);
+    }
+    return result;
+}
 
-        result += stream( target, unicode_cp8_code_unit_count( cp8 ), cp8.code_units );
+attr_core_api
+usize unicode_utf8_len_from_utf16( usize len, const c16* utf16 ) {
+    usize result = 0;
+    usize at     = 0;
+    while( at < len ) {
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+        if( (at + 8) <= len ) {
+            __m128i v   = _mm_loadu_si128( (const __m128i*)(utf16 + at) );
+            __m128i top = _mm_and_si128( v, _mm_set1_epi16( (i16)0xF800 ) );
+            if( !_mm_movemask_epi8( _mm_cmpeq_epi16( top, _mm_set1_epi16( (i16)0xD800 ) ) ) ) {
+                __m128i zero = _mm_setzero_si128();
+                u32 one_byte = (u32)_mm_movemask_epi8( _mm_cmpeq_epi16(
+                    _mm_and_si128( v, _mm_set1_epi16( (i16)0xFF80 ) ), zero ) );
+                u32 two_byte = (u32)_mm_movemask_epi8( _mm_cmpeq_epi16( top, zero ) );
+                // NOTE(alicia): movemask has 2 bits per lane.
+                result += 24 -
+                    ((internal_bits_popcount32( one_byte ) +
+                      internal_bits_popcount32( two_byte )) / 2);
+                at += 8;
+                continue;
+            }
+        }
+        usize block_end = (len - at) < 8 ? len : at + 8;
+#else
+        usize block_end = len;
+#endif
+        while( at < block_end ) {
+            rune32 rune;
+            at     += internal_utf16_decode( len - at, utf16 + at, &rune );
+            result += internal_utf8_rune_len( rune );
+        }
+    }
+    return result;
+}
+attr_core_api
+usize unicode_utf8_len_from_utf32( usize len, const c32* utf32 ) {
+    usize result = 0;
+    for( usize i = 0; i < len; ++i ) {
+        result += internal_utf8_rune_len( internal_utf32_decode( utf32[i] ) );
+    }
+    return result;
+}
+attr_core_api
+usize unicode_utf16_len_from_utf8( usize len, const c8* utf8 ) {
+    return internal_utf8_count( len, utf8, true );
+}
+attr_core_api
+usize unicode_utf16_len_from_utf32( usize len, const c32* utf32 ) {
+    usize result = 0;
+    for( usize i = 0; i < len; ++i ) {
+        result += 1 + (internal_utf32_decode( utf32[i] ) >= 0x10000);
+    }
+    return result;
+}
+attr_core_api
+usize unicode_utf32_len_from_utf8( usize len, const c8* utf8 ) {
+    return internal_utf8_count( len, utf8, false );
+}
+attr_core_api
+usize unicode_utf32_len_from_utf16( usize len, const c16* utf16 ) {
+    usize result = 0;
+    usize at     = 0;
+    while( at < len ) {
+        rune32 rune;
+        at += internal_utf16_decode( len - at, utf16 + at, &rune );
+        result++;
+    }
+    return result;
+}
 
-        utf16     += advance;
-        remaining -= advance;
+attr_core_api
+usize unicode_utf8_from_utf16_buffer(
+    usize len, const c16* utf16, usize cap, c8* buffer, usize* opt_out_read
+) {
+    usize at      = 0;
+    usize written = 0;
+    while( at < len ) {
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+        // NOTE(alicia): 3 byte path writes 16 bytes for every 12
+        // so it needs 4 bytes of slack.
+        if( ((at + 8) <= len) && ((written + 28) <= cap) ) {
+            __m128i zero  = _mm_setzero_si128();
+            __m128i v     = _mm_loadu_si128( (const __m128i*)(utf16 + at) );
+            __m128i top   = _mm_and_si128( v, _mm_set1_epi16( (i16)0xF800 ) );
+            u32     ascii = (u32)_mm_movemask_epi8( _mm_cmpeq_epi16(
+                _mm_and_si128( v, _mm_set1_epi16( (i16)0xFF80 ) ), zero ) );
+
+            if( ascii & 1 ) {
+                // NOTE(alicia): write all 8, only keep leading ASCII.
+                u32 count = (ascii == 0xFFFF) ? 8 : internal_bits_ctz32( ~ascii ) / 2;
+                _mm_storel_epi64( (__m128i*)(buffer + written), _mm_packus_epi16( v, v ) );
+                at      += count;
+                written += count;
+                continue;
+            }
+            if( !ascii ) {
+                u32 two_byte = (u32)_mm_movemask_epi8( _mm_cmpeq_epi16( top, zero ) );
+                if( two_byte == 0xFFFF ) {
+                    __m128i out = _mm_or_si128(
+                        _mm_or_si128(
+                            _mm_srli_epi16( v, 6 ),
+                            _mm_slli_epi16( _mm_and_si128( v, _mm_set1_epi16( 0x3F ) ), 8 ) ),
+                        _mm_set1_epi16( (i16)0x80C0 ) );
+                    _mm_storeu_si128( (__m128i*)(buffer + written), out );
+                    at      += 8;
+                    written += 16;
+                    continue;
+                }
+                u32 surrogate = (u32)_mm_movemask_epi8(
+                    _mm_cmpeq_epi16( top, _mm_set1_epi16( (i16)0xD800 ) ) );
+                if( !two_byte && !surrogate ) {
+                    __m128i halves[2] = {
+                        _mm_unpacklo_epi16( v, zero ),
+                        _mm_unpackhi_epi16( v, zero ) };
+                    for( u32 h = 0; h < 2; ++h ) {
+                        __m128i w   = halves[h];
+                        __m128i out = _mm_or_si128(
+                            _mm_or_si128(
+                                _mm_srli_epi32( w, 12 ),
+                                _mm_slli_epi32( _mm_and_si128(
+                                    _mm_srli_epi32( w, 6 ), _mm_set1_epi32( 0x3F ) ), 8 ) ),
+                            _mm_or_si128(
+                                _mm_slli_epi32( _mm_and_si128( w, _mm_set1_epi32( 0x3F ) ), 16 ),
+                                _mm_set1_epi32( 0x8080E0 ) ) );
+                        // NOTE(alicia): pack 4 lanes of 3 bytes into 12 bytes,
+                        // first pairs within 64-bit lanes then the two halves.
+                        out = _mm_or_si128(
+                            _mm_and_si128( out, _mm_set_epi32( 0, -1, 0, -1 ) ),
+                            _mm_slli_epi64( _mm_srli_epi64( out, 32 ), 24 ) );
+                        out = _mm_or_si128(
+                            _mm_move_epi64( out ),
+                            _mm_slli_si128( _mm_srli_si128( out, 8 ), 6 ) );
+                        _mm_storeu_si128( (__m128i*)(buffer + written), out );
+                        written += 12;
+                    }
+                    at += 8;
+                    continue;
+                }
+            }
+        }
+        usize block_end = (len - at) < 8 ? len : at + 8;
+#else
+        usize block_end = len;
+#endif
+        while( at < block_end ) {
+            rune32 rune;
+            u32 advance = internal_utf16_decode( len - at, utf16 + at, &rune );
+            u32 count   = internal_utf8_rune_len( rune );
+            if( (written + count) > cap ) {
+                goto unicode_utf8_from_utf16_buffer_end;
+            }
+            internal_utf8_encode( rune, count, buffer + written );
+            at      += advance;
+            written += count;
+        }
+    }
+unicode_utf8_from_utf16_buffer_end:
+    if( opt_out_read ) {
+        *opt_out_read = at;
+    }
+    return written;
+}
+attr_core_api
+usize unicode_utf8_from_utf32_buffer(
+    usize len, const c32* utf32, usize cap, c8* buffer, usize* opt_out_read
+) {
+    usize at      = 0;
+    usize written = 0;
+    while( at < len ) {
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+        if( ((at + 8) <= len) && ((written + 8) <= cap) ) {
+            __m128i a = _mm_loadu_si128( (const __m128i*)(utf32 + at) );
+            __m128i b = _mm_loadu_si128( (const __m128i*)(utf32 + at + 4) );
+            __m128i high = _mm_and_si128( _mm_or_si128( a, b ), _mm_set1_epi32( (i32)0xFFFFFF80 ) );
+            if( _mm_movemask_epi8( _mm_cmpeq_epi32( high, _mm_setzero_si128() ) ) == 0xFFFF ) {
+                __m128i packed = _mm_packs_epi32( a, b );
+                _mm_storel_epi64( (__m128i*)(buffer + written), _mm_packus_epi16( packed, packed ) );
+                at      += 8;
+                written += 8;
+                continue;
+            }
+        }
+        usize block_end = (len - at) < 8 ? len : at + 8;
+#else
+        usize block_end = len;
+#endif
+        for( ; at < block_end; ++at ) {
+            rune32 rune  = internal_utf32_decode( utf32[at] );
+            u32    count = internal_utf8_rune_len( rune );
+            if( (written + count) > cap ) {
+                goto unicode_utf8_from_utf32_buffer_end;
+            }
+            internal_utf8_encode( rune, count, buffer + written );
+            written += count;
+        }
+    }
+unicode_utf8_from_utf32_buffer_end:
+    if( opt_out_read ) {
+        *opt_out_read = at;
+    }
+    return written;
+}
+attr_core_api
+usize unicode_utf16_from_utf8_buffer(
+    usize len, const c8* utf8, usize cap, c16* buffer, usize* opt_out_read
+) {
+    usize at      = 0;
+    usize written = 0;
+    while( at < len ) {
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+        usize block_end = (len - at) < 16 ? len : at + 16;
+        if( ((at + 16) <= len) && ((written + 16) <= cap) ) {
+            __m128i v    = _mm_loadu_si128( (const __m128i*)(utf8 + at) );
+            u32     mask = (u32)_mm_movemask_epi8( v );
+            if( !(mask & 1) ) {
+                __m128i zero  = _mm_setzero_si128();
+                u32     count = mask ? internal_bits_ctz32( mask ) : 16;
+                _mm_storeu_si128( (__m128i*)(buffer + written), _mm_unpacklo_epi8( v, zero ) );
+                _mm_storeu_si128( (__m128i*)(buffer + written + 8), _mm_unpackhi_epi8( v, zero ) );
+                at      += count;
+                written += count;
+            } else if( internal_utf8_is_two_byte_block( v ) ) {
+                _mm_storeu_si128(
+                    (__m128i*)(buffer + written), internal_utf8_decode_two_byte_block( v ) );
+                at      += 16;
+                written += 8;
+                continue;
+            }
+        }
+#else
+        usize block_end = len;
+#endif
+        while( at < block_end ) {
+            rune32 rune;
+            u32 advance = internal_utf8_decode( len - at, utf8 + at, &rune );
+            u32 count   = 1 + (rune >= 0x10000);
+            if( (written + count) > cap ) {
+                goto unicode_utf16_from_utf8_buffer_end;
+            }
+            internal_utf16_encode( rune, count, buffer + written );
+            at      += advance;
+            written += count;
+        }
+    }
+unicode_utf16_from_utf8_buffer_end:
+    if( opt_out_read ) {
+        *opt_out_read = at;
+    }
+    return written;
+}
+attr_core_api
+usize unicode_utf16_from_utf32_buffer(
+    usize len, const c32* utf32, usize cap, c16* buffer, usize* opt_out_read
+) {
+    usize at      = 0;
+    usize written = 0;
+    while( at < len ) {
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+        if( ((at + 8) <= len) && ((written + 8) <= cap) ) {
+            __m128i a    = _mm_loadu_si128( (const __m128i*)(utf32 + at) );
+            __m128i b    = _mm_loadu_si128( (const __m128i*)(utf32 + at + 4) );
+            __m128i zero = _mm_setzero_si128();
+            __m128i high = _mm_and_si128( _mm_or_si128( a, b ), _mm_set1_epi32( (i32)0xFFFF0000 ) );
+            __m128i surrogate_bits = _mm_set1_epi32( 0xF800 );
+            __m128i surrogate      = _mm_set1_epi32( 0xD800 );
+            __m128i bad = _mm_or_si128(
+                _mm_cmpeq_epi32( _mm_and_si128( a, surrogate_bits ), surrogate ),
+                _mm_cmpeq_epi32( _mm_and_si128( b, surrogate_bits ), surrogate ) );
+            if(
+                (_mm_movemask_epi8( _mm_cmpeq_epi32( high, zero ) ) == 0xFFFF) &&
+                !_mm_movemask_epi8( bad )
+            ) {
+                // NOTE(alicia): SSE2 only has signed saturating pack,
+                // bias into signed range and back.
+                __m128i bias   = _mm_set1_epi32( 0x8000 );
+                __m128i packed = _mm_packs_epi32(
+                    _mm_sub_epi32( a, bias ), _mm_sub_epi32( b, bias ) );
+                packed = _mm_add_epi16( packed, _mm_set1_epi16( (i16)0x8000 ) );
+                _mm_storeu_si128( (__m128i*)(buffer + written), packed );
+                at      += 8;
+                written += 8;
+                continue;
+            }
+        }
+        usize block_end = (len - at) < 8 ? len : at + 8;
+#else
+        usize block_end = len;
+#endif
+        for( ; at < block_end; ++at ) {
+            rune32 rune  = internal_utf32_decode( utf32[at] );
+            u32    count = 1 + (rune >= 0x10000);
+            if( (written + count) > cap ) {
+                goto unicode_utf16_from_utf32_buffer_end;
+            }
+            internal_utf16_encode( rune, count, buffer + written );
+            written += count;
+        }
+    }
+unicode_utf16_from_utf32_buffer_end:
+    if( opt_out_read ) {
+        *opt_out_read = at;
+    }
+    return written;
+}
+attr_core_api
+usize unicode_utf32_from_utf8_buffer(
+    usize len, const c8* utf8, usize cap, c32* buffer, usize* opt_out_read
+) {
+    usize at      = 0;
+    usize written = 0;
+    while( at < len ) {
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+        usize block_end = (len - at) < 16 ? len : at + 16;
+        if( ((at + 16) <= len) && ((written + 16) <= cap) ) {
+            __m128i v    = _mm_loadu_si128( (const __m128i*)(utf8 + at) );
+            u32     mask = (u32)_mm_movemask_epi8( v );
+            if( !(mask & 1) ) {
+                __m128i zero  = _mm_setzero_si128();
+                __m128i lo    = _mm_unpacklo_epi8( v, zero );
+                __m128i hi    = _mm_unpackhi_epi8( v, zero );
+                u32     count = mask ? internal_bits_ctz32( mask ) : 16;
+                _mm_storeu_si128( (__m128i*)(buffer + written),      _mm_unpacklo_epi16( lo, zero ) );
+                _mm_storeu_si128( (__m128i*)(buffer + written + 4),  _mm_unpackhi_epi16( lo, zero ) );
+                _mm_storeu_si128( (__m128i*)(buffer + written + 8),  _mm_unpacklo_epi16( hi, zero ) );
+                _mm_storeu_si128( (__m128i*)(buffer + written + 12), _mm_unpackhi_epi16( hi, zero ) );
+                at      += count;
+                written += count;
+            } else if( internal_utf8_is_two_byte_block( v ) ) {
+                __m128i zero  = _mm_setzero_si128();
+                __m128i runes = internal_utf8_decode_two_byte_block( v );
+                _mm_storeu_si128( (__m128i*)(buffer + written),     _mm_unpacklo_epi16( runes, zero ) );
+                _mm_storeu_si128( (__m128i*)(buffer + written + 4), _mm_unpackhi_epi16( runes, zero ) );
+                at      += 16;
+                written += 8;
+                continue;
+            }
+        }
+#else
+        usize block_end = len;
+#endif
+        while( at < block_end ) {
+            if( written >= cap ) {
+                goto unicode_utf32_from_utf8_buffer_end;
+            }
+            at += internal_utf8_decode( len - at, utf8 + at, buffer + written );
+            written++;
+        }
     }
+unicode_utf32_from_utf8_buffer_end:
+    if( opt_out_read ) {
+        *opt_out_read = at;
+    }
+    return written;
+}
+attr_core_api
+usize unicode_utf32_from_utf16_buffer(
+    usize len, const c16* utf16, usize cap, c32* buffer, usize* opt_out_read
+) {
+    usize at      = 0;
+    usize written = 0;
+    while( at < len ) {
+#if defined(CORE_ENABLE_SSE_INSTRUCTIONS)
+        if( ((at + 8) <= len) && ((written + 8) <= cap) ) {
+            __m128i v   = _mm_loadu_si128( (const __m128i*)(utf16 + at) );
+            __m128i top = _mm_and_si128( v, _mm_set1_epi16( (i16)0xF800 ) );
+            if( !_mm_movemask_epi8( _mm_cmpeq_epi16( top, _mm_set1_epi16( (i16)0xD800 ) ) ) ) {
+                __m128i zero = _mm_setzero_si128();
+                _mm_storeu_si128( (__m128i*)(buffer + written),     _mm_unpacklo_epi16( v, zero ) );
+                _mm_storeu_si128( (__m128i*)(buffer + written + 4), _mm_unpackhi_epi16( v, zero ) );
+                at      += 8;
+                written += 8;
+                continue;
+            }
+        }
+        usize block_end = (len - at) < 8 ? len : at + 8;
+#else
+        usize block_end = len;
+#endif
+        while( at < block_end ) {
+            if( written >= cap ) {
+                goto unicode_utf32_from_utf16_buffer_end;
+            }
+            at += internal_utf16_decode( len - at, utf16 + at, buffer + written );
+            written++;
+        }
+    }
+unicode_utf32_from_utf16_buffer_end:
+    if( opt_out_read ) {
+        *opt_out_read = at;
+    }
+    return written;
+}
 
+attr_core_api
+usize unicode_utf8_from_utf16(
+    StreamBytesFN* stream, void* target, usize len, const c16* string
+) {
+    c8    block[UNICODE_STREAM_BLOCK_SIZE];
+    usize result = 0;
+    while( len ) {
+        usize read  = 0;
+        usize count = unicode_utf8_from_utf16_buffer(
+            len, string, UNICODE_STREAM_BLOCK_SIZE, block, &read );
+        result += stream( target, count, block );
+        string += read;
+        len    -= read;
+    }
     return result;
 }
 attr_core_api
 usize unicode_utf8_from_utf32(
     StreamBytesFN* stream, void* target, usize len, const c32* string
 ) {
+    c8    block[UNICODE_STREAM_BLOCK_SIZE];
     usize result = 0;
-
-    const c32* utf32     = string;
-    usize      remaining = len;
-    while( remaining ) {
-        UTFCodePoint32 cp32 = {};
-        usize advance = unicode_cp32_from_string( remaining, utf32, &cp32 );
-
-        UTFCodePoint8 cp8 = unicode_cp8_from_cp32( cp32 );
-
-        result += stream( target, unicode_cp8_code_unit_count( cp8 ), cp8.code_units );
-
-        utf32     += advance;
-        remaining -= advance;
+    while( len ) {
+        usize read  = 0;
+        usize count = unicode_utf8_from_utf32_buffer(
+            len, string, UNICODE_STREAM_BLOCK_SIZE, block, &read );
+        result += stream( target, count, block );
+        string += read;
+        len    -= read;
     }
-
     return result;
 }
 attr_core_api
 usize unicode_utf16_from_utf8(
     StreamBytesFN* stream, void* target, usize len, const c8* string
 ) {
+    c16   block[UNICODE_STREAM_BLOCK_SIZE / sizeof(c16)];
     usize result = 0;
-
-    const u8* utf8      = (const u8*)string;
-    usize     remaining = len;
-    while( remaining ) {
-        UTFCodePoint8 cp8 = {};
-        usize advance = unicode_cp8_from_string( remaining, utf8, &cp8 );
-
-        UTFCodePoint16 cp16 = unicode_cp16_from_cp8( cp8 );
-
-        result += stream(
-            target, sizeof(u16) * unicode_cp16_code_unit_count( cp16 ), cp16.code_units );
-
-        utf8      += advance;
-        remaining -= advance;
+    while( len ) {
+        usize read  = 0;
+        usize count = unicode_utf16_from_utf8_buffer(
+            len, string, static_array_len( block ), block, &read );
+        result += stream( target, sizeof(c16) * count, block );
+        string += read;
+        len    -= read;
     }
-
     return result;
 }
 attr_core_api
 usize unicode_utf16_from_utf32(
     StreamBytesFN* stream, void* target, usize len, const c32* string
 ) {
+    c16   block[UNICODE_STREAM_BLOCK_SIZE / sizeof(c16)];
     usize result = 0;
-
-    const c32* utf32     = string;
-    usize      remaining = len;
-    while( remaining ) {
-        UTFCodePoint32 cp32 = {};
-        usize advance = unicode_cp32_from_string( remaining, utf32, &cp32 );
-
-        UTFCodePoint16 cp16 = unicode_cp16_from_cp32( cp32 );
-
-        result += stream(
-            target, sizeof(u16) * unicode_cp16_code_unit_count( cp16 ), cp16.code_units );
-
-        utf32     += advance;
-        remaining -= advance;
+    while( len ) {
+        usize read  = 0;
+        usize count = unicode_utf16_from_utf32_buffer(
+            len, string, static_array_len( block ), block, &read );
+        result += stream( target, sizeof(c16) * count, block );
+        string += read;
+        len    -= read;
     }
-
     return result;
 }
 attr_core_api
 usize unicode_utf32_from_utf8(
     StreamBytesFN* stream, void* target, usize len, const c8* string
 ) {
+    c32   block[UNICODE_STREAM_BLOCK_SIZE / sizeof(c32)];
     usize result = 0;
-
-    const u8* utf8      = (const u8*)string;
-    usize     remaining = len;
-    while( remaining ) {
-        UTFCodePoint8 cp8 = {};
-        usize advance = unicode_cp8_from_string( remaining, utf8, &cp8 );
-
-        UTFCodePoint32 cp32 = unicode_cp32_from_cp8( cp8 );
-
-        result += stream(
-            target, sizeof(u32) * unicode_cp32_code_unit_count( cp32 ), cp32.code_units );
-
-        utf8      += advance;
-        remaining -= advance;
+    while( len ) {
+        usize read  = 0;
+        usize count = unicode_utf32_from_utf8_buffer(
+            len, string, static_array_len( block ), block, &read );
+        result += stream( target, sizeof(c32) * count, block );
+        string += read;
+        len    -= read;
     }
-
     return result;
 }
 attr_core_api
 usize unicode_utf32_from_utf16(
     StreamBytesFN* stream, void* target, usize len, const c16* string 
 ) {
+    c32   block[UNICODE_STREAM_BLOCK_SIZE / sizeof(c32)];
     usize result = 0;
-
-    const c16* utf16     = string;
-    usize      remaining = len;
-    while( remaining ) {
-        UTFCodePoint16 cp16 = {};
-        usize advance = unicode_cp16_from_string( remaining, utf16, &cp16 );
-
-        UTFCodePoint32 cp32 = unicode_cp32_from_cp16( cp16 );
-
-        result += stream(
-            target, sizeof(u32) * unicode_cp32_code_unit_count( cp32 ), cp32.code_units );
-
-        utf16     += advance;
-        remaining -= advance;
+    while( len ) {
+        usize read  = 0;
+        usize count = unicode_utf32_from_utf16_buffer(
+            len, string, static_array_len( block ), block, &read );
+        result += stream( target, sizeof(c32) * count, block );
+        string += read;
+        len    -= read;
     }
-
     return result;
 }
+/// @brief Look up properties of rune in two-stage table.
+/// @details
+/// Runes past U+10FFFF are looked up as U+0000 which has no properties.
+attr_always_inline inline attr_internal
+const UnicodeProperties* internal_unicode_properties( rune32 rune ) {
+    rune32 index = rune > 0x10FFFF ? 0 : rune;
+    u32    page  = global_unicode_block_index[index >> UNICODE_TABLE_SHIFT];
+    return global_unicode_properties + global_unicode_pages[
+        (page << UNICODE_TABLE_SHIFT) | (index & UNICODE_TABLE_MASK) ];
+}
+attr_always_inline inline attr_internal
+rune32 internal_unicode_to_upper( rune32 rune ) {
+    return (rune32)((i32)rune + internal_unicode_properties( rune )->upper);
+}
+attr_always_inline inline attr_internal
+rune32 internal_unicode_to_lower( rune32 rune ) {
+    return (rune32)((i32)rune + internal_unicode_properties( rune )->lower);
+}
+attr_always_inline inline attr_internal
+rune32 internal_unicode_fold( rune32 rune ) {
+    return (rune32)((i32)rune + internal_unicode_properties( rune )->fold);
+}
+// NOTE(alicia): grapheme cluster breaks (UAX #29) are a state machine
+// over grapheme break properties. State is property of previous rune
+// plus two states for context that spans more than two runes:
+// regional indicator that completed a flag pair (GB12/GB13) and
+// extended pictographic followed by Extend* ZWJ (GB11).
+// Extended pictographic followed by Extend stays in its own state.
+// Each state has a mask of properties that do not break after it.
+
+#define GRAPHEME_STATE_RI_PAIR     (UNICODE_GRAPHEME_COUNT + 0)
+#define GRAPHEME_STATE_EMOJI_ZWJ   (UNICODE_GRAPHEME_COUNT + 1)
+#define GRAPHEME_STATE_COUNT       (UNICODE_GRAPHEME_COUNT + 2)
+
+#define GRAPHEME_BIT( property ) (1 << UNICODE_GRAPHEME_##property)
+/// @brief GB9, GB9a: never break before Extend, ZWJ or SpacingMark.
+#define GRAPHEME_EXTEND_MASK \
+    (GRAPHEME_BIT(EXTEND) | GRAPHEME_BIT(ZWJ) | GRAPHEME_BIT(SPACING_MARK))
+
+attr_global
+const u16 global_unicode_grapheme_join[GRAPHEME_STATE_COUNT] = {
+    [UNICODE_GRAPHEME_OTHER]        = GRAPHEME_EXTEND_MASK,
+    // GB3, GB4: CR only joins with LF.
+    [UNICODE_GRAPHEME_CR]           = GRAPHEME_BIT(LF),
+    [UNICODE_GRAPHEME_LF]           = 0,
+    [UNICODE_GRAPHEME_CONTROL]      = 0,
+    [UNICODE_GRAPHEME_EXTEND]       = GRAPHEME_EXTEND_MASK,
+    [UNICODE_GRAPHEME_ZWJ]          = GRAPHEME_EXTEND_MASK,
+    // GB12, GB13: first regional indicator of a pair.
+    [UNICODE_GRAPHEME_REGIONAL_INDICATOR] =
+        GRAPHEME_EXTEND_MASK | GRAPHEME_BIT(REGIONAL_INDICATOR),
+    // GB9b, GB5: Prepend joins with anything but controls.
+    [UNICODE_GRAPHEME_PREPEND]      =
+        ((1 << UNICODE_GRAPHEME_COUNT) - 1) &
+        ~(GRAPHEME_BIT(CR) | GRAPHEME_BIT(LF) | GRAPHEME_BIT(CONTROL)),
+    [UNICODE_GRAPHEME_SPACING_MARK] = GRAPHEME_EXTEND_MASK,
+    // GB6, GB7, GB8: Hangul syllable sequences.
+    [UNICODE_GRAPHEME_L]            = GRAPHEME_EXTEND_MASK |
+        GRAPHEME_BIT(L) | GRAPHEME_BIT(V) | GRAPHEME_BIT(LV) | GRAPHEME_BIT(LVT),
+    [UNICODE_GRAPHEME_V]            = GRAPHEME_EXTEND_MASK |
+        GRAPHEME_BIT(V) | GRAPHEME_BIT(T),
+    [UNICODE_GRAPHEME_T]            = GRAPHEME_EXTEND_MASK | GRAPHEME_BIT(T),
+    [UNICODE_GRAPHEME_LV]           = GRAPHEME_EXTEND_MASK |
+        GRAPHEME_BIT(V) | GRAPHEME_BIT(T),
+    [UNICODE_GRAPHEME_LVT]          = GRAPHEME_EXTEND_MASK | GRAPHEME_BIT(T),
+    [UNICODE_GRAPHEME_EXTENDED_PICTOGRAPHIC] = GRAPHEME_EXTEND_MASK,
+    [GRAPHEME_STATE_RI_PAIR]        = GRAPHEME_EXTEND_MASK,
+    // GB11: ExtPict Extend* ZWJ x ExtPict.
+    [GRAPHEME_STATE_EMOJI_ZWJ]      =
+        GRAPHEME_EXTEND_MASK | GRAPHEME_BIT(EXTENDED_PICTOGRAPHIC),
+};
+
+/// @brief Get state after rune with given grapheme break property joined cluster.
+attr_always_inline inline attr_internal
+u32 internal_unicode_grapheme_next( u32 state, u32 property ) {
+    if( state == UNICODE_GRAPHEME_EXTENDED_PICTOGRAPHIC ) {
+        if( property == UNICODE_GRAPHEME_EXTEND ) {
+            return state;
+        }
+        if( property == UNICODE_GRAPHEME_ZWJ ) {
+            return GRAPHEME_STATE_EMOJI_ZWJ;
+        }
+    }
+    if(
+        state    == UNICODE_GRAPHEME_REGIONAL_INDICATOR &&
+        property == UNICODE_GRAPHEME_REGIONAL_INDICATOR
+    ) {
+        return GRAPHEME_STATE_RI_PAIR;
+    }
+    return property;
+}
+attr_always_inline inline attr_internal
+usize internal_unicode_grapheme_len( usize len, const u8* bytes ) {
+    if( !len ) {
+        return 0;
+    }
+    // NOTE(alicia): ASCII followed by ASCII always breaks, except CR LF.
+    if( bytes[0] < 0x80 && (len == 1 || bytes[1] < 0x80) ) {
+        return 1 + (len > 1 && bytes[0] == '\r' && bytes[1] == '\n');
+    }
+
+    rune32 rune  = 0;
+    usize  at    = internal_utf8_decode( len, bytes, &rune );
+    u32    state = internal_unicode_properties( rune )->grapheme;
+    while( at < len ) {
+        u32 read     = internal_utf8_decode( len - at, bytes + at, &rune );
+        u32 property = internal_unicode_properties( rune )->grapheme;
+        if( !(global_unicode_grapheme_join[state] & (1 << property)) ) {
+            break;
+        }
+        state = internal_unicode_grapheme_next( state, property );
+        at   += read;
+    }
+    return at;
+}
+attr_core_api
+usize unicode_utf8_grapheme_len( usize len, const c8* utf8 ) {
+    return internal_unicode_grapheme_len( len, utf8 );
+}
 attr_core_api
 b32 unicode_is_mathematical( rune32 rune ) {
     return
@@ -443,27 +1116,15 @@ b32 unicode_is_mathematical( rune32 rune ) {
 }
 attr_core_api
 b32 unicode_is_alphabetic_upper( rune32 rune ) {
-    if( unicode_is_ascii( rune ) ) {
-        return ascii_is_alphabetic_upper( rune );
-    }
-    // TODO(alicia): check against other writing systems.
-    return false;
+    return (internal_unicode_properties( rune )->flags & UNICODE_PROPERTY_UPPER) != 0;
 }
 attr_core_api
 b32 unicode_is_alphabetic_lower( rune32 rune ) {
-    if( unicode_is_ascii( rune ) ) {
-        return ascii_is_alphabetic_lower( rune );
-    }
-    // TODO(alicia): check against other writing systems.
-    return false;
+    return (internal_unicode_properties( rune )->flags & UNICODE_PROPERTY_LOWER) != 0;
 }
 attr_core_api
 b32 unicode_is_alphabetic( rune32 rune ) {
-    if( unicode_is_ascii( rune ) ) {
-        return ascii_is_alphabetic( rune );
-    }
-    // TODO(alicia): check against other writing systems.
-    return false;
+    return (internal_unicode_properties( rune )->flags & UNICODE_PROPERTY_ALPHABETIC) != 0;
 }
 attr_core_api
 b32 unicode_is_emoji( rune32 rune ) {
@@ -479,19 +1140,15 @@ b32 unicode_is_emoji( rune32 rune ) {
 }
 attr_core_api
 rune32 unicode_to_upper( rune32 rune ) {
-    if( unicode_is_ascii( rune ) ) {
-        return ascii_to_upper( rune );
-    }
-    // TODO(alicia): 
-    return rune;
+    return internal_unicode_to_upper( rune );
 }
 attr_core_api
 rune32 unicode_to_lower( rune32 rune ) {
-    if( unicode_is_ascii( rune ) ) {
-        return ascii_to_lower( rune );
-    }
-    // TODO(alicia): 
-    return rune;
+    return internal_unicode_to_lower( rune );
+}
+attr_core_api
+rune32 unicode_fold( rune32 rune ) {
+    return internal_unicode_fold( rune );
 }
 attr_core_api
 GraphemeCluster unicode_cluster_to_upper( GraphemeCluster cluster ) {
@@ -510,24 +1167,45 @@ usize ascii_from_utf8(
     usize len, const c8* string,
     char opt_replacement_character 
 ) {
+    c8    block[UNICODE_STREAM_BLOCK_SIZE];
+    usize count  = 0;
     usize result = 0;
-
-    const c8* utf8  = string;
-    usize remaining = len;
-    while( remaining ) {
-        UTFCodePoint8 cp8 = {};
-        u32 advance = unicode_cp8_from_string( remaining, utf8, &cp8 );
-
-        if( !(cp8.code_units[0] & ~0x7F) ) {
-            result += stream( target, 1, cp8.code_units );
-        } else if( opt_replacement_character ) {
-            result += stream( target, 1, &opt_replacement_character );
+    usize at     = 0;
+    while( at < len ) {
+        usize run_end = internal_utf8_skip_ascii( len, string, at );
+        while( (run_end < len) && (string[run_end] < 0x80) ) {
+            run_end++;
+        }
+        while( at < run_end ) {
+            usize copy = UNICODE_STREAM_BLOCK_SIZE - count;
+            if( copy > (run_end - at) ) {
+                copy = run_end - at;
+            }
+            memory_copy( block + count, string + at, copy );
+            count += copy;
+            at    += copy;
+            if( count == UNICODE_STREAM_BLOCK_SIZE ) {
+                result += stream( target, count, block );
+                count   = 0;
+            }
+        }
+        if( at >= len ) {
+            break;
         }
 
-        utf8      += advance;
-        remaining -= advance;
+        rune32 rune;
+        at += internal_utf8_decode( len - at, string + at, &rune );
+        if( opt_replacement_character ) {
+            block[count++] = (c8)opt_replacement_character;
+            if( count == UNICODE_STREAM_BLOCK_SIZE ) {
+                result += stream( target, count, block );
+                count   = 0;
+            }
+        }
+    }
+    if( count ) {
+        result += stream( target, count, block );
     }
-
     return result;
 }
 attr_core_api
@@ -536,26 +1214,26 @@ usize ascii_from_utf16(
     usize len, const c16* string,
     char opt_replacement_character
 ) {
+    c8    block[UNICODE_STREAM_BLOCK_SIZE];
+    usize count  = 0;
     usize result = 0;
-
-    const c16* utf16 = string;
-    usize remaining  = len;
-    while( remaining ) {
-        UTFCodePoint16 cp16 = {};
-        u32 advance = unicode_cp16_from_string( remaining, utf16, &cp16 );
-
-        UTFCodePoint8 cp8 = unicode_cp8_from_cp16( cp16 );
-
-        if( !(cp8.code_units[0] & ~0x7F) ) {
-            result += stream( target, 1, cp8.code_units );
+    usize at     = 0;
+    while( at < len ) {
+        rune32 rune;
+        at += internal_utf16_decode( len - at, string + at, &rune );
+        if( rune < 0x80 ) {
+            block[count++] = (c8)rune;
         } else if( opt_replacement_character ) {
-            result += stream( target, 1, &opt_replacement_character );
+            block[count++] = (c8)opt_replacement_character;
+        }
+        if( count == UNICODE_STREAM_BLOCK_SIZE ) {
+            result += stream( target, count, block );
+            count   = 0;
         }
-
-        utf16     += advance;
-        remaining -= advance;
     }
-
+    if( count ) {
+        result += stream( target, count, block );
+    }
     return result;
 }
 attr_core_api
@@ -564,26 +1242,54 @@ usize ascii_from_utf32(
     usize len, const c32* string,
     char opt_replacement_character
 ) {
+    c8    block[UNICODE_STREAM_BLOCK_SIZE];
+    usize count  = 0;
     usize result = 0;
-
-    const c32* utf32 = string;
-    usize remaining  = len;
-    while( remaining ) {
-        UTFCodePoint32 cp32 = {};
-        u32 advance = unicode_cp32_from_string( remaining, utf32, &cp32 );
-
-        UTFCodePoint8 cp8 = unicode_cp8_from_cp32( cp32 );
-
-        if( !(cp8.code_units[0] & ~0x7F) ) {
-            result += stream( target, 1, cp8.code_units );
+    for( usize i = 0; i < len; ++i ) {
+        if( string[i] < 0x80 ) {
+            block[count++] = (c8)string[i];
         } else if( opt_replacement_character ) {
-            result += stream( target, 1, &opt_replacement_character );
+            block[count++] = (c8)opt_replacement_character;
+        }
+        if( count == UNICODE_STREAM_BLOCK_SIZE ) {
+            result += stream( target, count, block );
+            count   = 0;
         }
-
-        utf32     += advance;
-        remaining -= advance;
     }
-
+    if( count ) {
+        result += stream( target, count, block );
+    }
     return result;
 }
 
+#undef UTF8_CLASS_COUNT
+#undef UTF8_ACCEPT
+#undef UTF8_REJECT
+#undef UNICODE_REPLACEMENT_RUNE
+#undef UNICODE_STREAM_BLOCK_SIZE
+#undef UNICODE_TABLE_SHIFT
+#undef UNICODE_TABLE_MASK
+#undef UNICODE_PROPERTY_ALPHABETIC
+#undef UNICODE_PROPERTY_UPPER
+#undef UNICODE_PROPERTY_LOWER
+#undef UNICODE_GRAPHEME_OTHER
+#undef UNICODE_GRAPHEME_CR
+#undef UNICODE_GRAPHEME_LF
+#undef UNICODE_GRAPHEME_CONTROL
+#undef UNICODE_GRAPHEME_EXTEND
+#undef UNICODE_GRAPHEME_ZWJ
+#undef UNICODE_GRAPHEME_REGIONAL_INDICATOR
+#undef UNICODE_GRAPHEME_PREPEND
+#undef UNICODE_GRAPHEME_SPACING_MARK
+#undef UNICODE_GRAPHEME_L
+#undef UNICODE_GRAPHEME_V
+#undef UNICODE_GRAPHEME_T
+#undef UNICODE_GRAPHEME_LV
+#undef UNICODE_GRAPHEME_LVT
+#undef UNICODE_GRAPHEME_EXTENDED_PICTOGRAPHIC
+#undef UNICODE_GRAPHEME_COUNT
+#undef GRAPHEME_STATE_RI_PAIR
+#undef GRAPHEME_STATE_EMOJI_ZWJ
+#undef GRAPHEME_STATE_COUNT
+#undef GRAPHEME_BIT
+#undef GRAPHEME_EXTEND_MASK
@@ -5,9 +5,257 @@
  * @date   March 03, 2025
 */
 #include "core/print.h"
+#include "core/unicode.h"
+#include "core/sort.h"
+#include "core/constants.h"
+#include "core/alloc.h"
+
+/// @brief Row of Unicode Table 3-7, Well-Formed UTF-8 Byte Sequences.
+struct ReferenceUTF8Row {
+    u8 lead_min, lead_max;
+    u8 second_min, second_max;
+    u32 len;
+};
+static const struct ReferenceUTF8Row global_reference_utf8_table[] = {
+    { 0xC2, 0xDF, 0x80, 0xBF, 2 },
+    { 0xE0, 0xE0, 0xA0, 0xBF, 3 },
+    { 0xE1, 0xEC, 0x80, 0xBF, 3 },
+    { 0xED, 0xED, 0x80, 0x9F, 3 },
+    { 0xEE, 0xEF, 0x80, 0xBF, 3 },
+    { 0xF0, 0xF0, 0x90, 0xBF, 4 },
+    { 0xF1, 0xF3, 0x80, 0xBF, 4 },
+    { 0xF4, 0xF4, 0x80, 0x8F, 4 },
+};
+
+/// @brief Scalar UTF-8 decoder that follows Table 3-7 byte by byte.
+/// @param      len         Length of buffer.
+/// @param[in]  bytes       Buffer.
+/// @param[out] out_rune    Decoded rune if sequence is valid.
+/// @param[out] out_advance Length of sequence if valid, offset of bad byte if invalid.
+/// @return Result.
+static UnicodeValidationResult reference_utf8_decode(
+    usize len, const u8* bytes, rune32* out_rune, u32* out_advance
+) {
+    if( bytes[0] < 0x80 ) {
+        *out_rune    = bytes[0];
+        *out_advance = 1;
+        return UNICODE_RESULT_OK;
+    }
+
+    const struct ReferenceUTF8Row* row = 0;
+    for( u32 i = 0; i < static_array_len( global_reference_utf8_table ); ++i ) {
+        if(
+            bytes[0] >= global_reference_utf8_table[i].lead_min &&
+            bytes[0] <= global_reference_utf8_table[i].lead_max
+        ) {
+            row = global_reference_utf8_table + i;
+            break;
+        }
+    }
+    if( !row ) {
+        *out_advance = 0;
+        return UNICODE_RESULT_INVALID;
+    }
+
+    rune32 rune = bytes[0] & (0xFF >> (row->len + 1));
+    for( u32 i = 1; i < row->len; ++i ) {
+        if( i >= len ) {
+            return UNICODE_RESULT_UNFINISHED;
+        }
+        u8 min = i == 1 ? row->second_min : 0x80;
+        u8 max = i == 1 ? row->second_max : 0xBF;
+        if( bytes[i] < min || bytes[i] > max ) {
+            *out_advance = i;
+            return UNICODE_RESULT_INVALID;
+        }
+        rune = (rune << 6) | (bytes[i] & 0x3F);
+    }
+
+    *out_rune    = rune;
+    *out_advance = row->len;
+    return UNICODE_RESULT_OK;
+}
+
+/// @brief Compare UTF-8 validators against reference for one buffer.
+static b32 test_utf8_validate_buffer( usize len, const u8* bytes ) {
+    rune32 expected_rune = 0, rune = 0;
+    u32 expected_advance = 0, advance = 0;
+    const c8* error = 0;
+
+    UnicodeValidationResult expected =
+        reference_utf8_decode( len, bytes, &expected_rune, &expected_advance );
+    UnicodeValidationResult result = unicode_utf8_validate(
+        len, (const c8*)bytes, &rune, &error, &advance );
+    if( result != expected ) {
+        return false;
+    }
+    switch( expected ) {
+        case UNICODE_RESULT_OK: {
+            if( rune != expected_rune || advance != expected_advance ) {
+                return false;
+            }
+        } break;
+        case UNICODE_RESULT_INVALID: {
+            if( error != (const c8*)bytes + expected_advance ) {
+                return false;
+            }
+        } break;
+        case UNICODE_RESULT_UNFINISHED: break;
+    }
+
+    usize at = 0;
+    while( at < len ) {
+        expected = reference_utf8_decode(
+            len - at, bytes + at, &expected_rune, &expected_advance );
+        if( expected != UNICODE_RESULT_OK ) {
+            break;
+        }
+        at += expected_advance;
+    }
+
+    usize error_offset = 0;
+    result = unicode_utf8_validate_string( len, (const c8*)bytes, &error_offset );
+    if( result != expected ) {
+        return false;
+    }
+    if( expected != UNICODE_RESULT_OK && error_offset != at ) {
+        return false;
+    }
+    return true;
+}
+
+/// @brief Check UTF-8 validation exhaustively against Table 3-7.
+/// @details
+/// Covers every 1-3 byte input and every 4-byte input with an F0-F4 lead.
+static b32 test_utf8_validate(void) {
+    u8 bytes[4];
+    for( u32 len = 1; len <= 3; ++len ) {
+        for( u32 value = 0; value < (1u << (len * 8)); ++value ) {
+            for( u32 i = 0; i < len; ++i ) {
+                bytes[i] = (u8)(value >> ((len - 1 - i) * 8));
+            }
+            if( !test_utf8_validate_buffer( len, bytes ) ) {
+                println( "utf8 validate: mismatch at length {u32} value {u32,xu}", len, value );
+                return false;
+            }
+        }
+    }
+    for( u32 value = 0xF00000; value < 0xF50000; ++value ) {
+        bytes[0] = (u8)(value >> 16);
+        bytes[1] = (u8)(value >> 8);
+        bytes[2] = (u8)value;
+        for( u32 last = 0; last < 256; ++last ) {
+            bytes[3] = (u8)last;
+            if( !test_utf8_validate_buffer( 4, bytes ) ) {
+                println( "utf8 validate: mismatch at length 4 value {u32,xu}", (value << 8) | last );
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static b32 test_sort_cmp_less_equal( void* lhs, void* rhs, usize size, void* params ) {
+    unused( size, params );
+    return *(i32*)lhs <= *(i32*)rhs;
+}
+/// @brief Fill buffer with duplicates and I32_MIN guards on either side.
+static void test_sort_fill( usize len, i32* storage, i32 modulo ) {
+    storage[0]       = I32_MIN;
+    storage[len + 1] = I32_MIN;
+    for( usize i = 0; i < len; ++i ) {
+        storage[i + 1] = (i32)((i * 7) % modulo);
+    }
+}
+/// @brief Check that sorting with a non-strict (<=) comparator stays in bounds.
+/// @details
+/// Partition scans must stop at buffer start even when
+/// comparator matches the pivot itself.
+static b32 test_sort_non_strict_cmp(void) {
+    #define TEST_SORT_LEN (256)
+    i32 storage[TEST_SORT_LEN + 2];
+    i32* buffer = storage + 1;
+    i32 swap;
+
+    i32 modulos[] = { 1, 4, 97 };
+    for( usize m = 0; m < static_array_len( modulos ); ++m ) {
+        test_sort_fill( TEST_SORT_LEN, storage, modulos[m] );
+        quicksort_generic(
+            0, TEST_SORT_LEN - 1, sizeof(i32), buffer,
+            test_sort_cmp_less_equal, 0, &swap );
+        if( storage[0] != I32_MIN || storage[TEST_SORT_LEN + 1] != I32_MIN ) {
+            println( "sort <=: quicksort_generic wrote out of bounds" );
+            return false;
+        }
+        for( usize i = 1; i < TEST_SORT_LEN; ++i ) {
+            if( buffer[i - 1] > buffer[i] ) {
+                println( "sort <=: quicksort_generic result is not sorted" );
+                return false;
+            }
+        }
+
+        usize nth = TEST_SORT_LEN / 3;
+        test_sort_fill( TEST_SORT_LEN, storage, modulos[m] );
+        select_nth_generic(
+            TEST_SORT_LEN, sizeof(i32), buffer, nth,
+            test_sort_cmp_less_equal, 0, &swap );
+        if( storage[0] != I32_MIN || storage[TEST_SORT_LEN + 1] != I32_MIN ) {
+            println( "sort <=: select_nth_generic wrote out of bounds" );
+            return false;
+        }
+        for( usize i = 0; i < TEST_SORT_LEN; ++i ) {
+            if(
+                (i < nth && buffer[i] > buffer[nth]) ||
+                (i > nth && buffer[i] < buffer[nth])
+            ) {
+                println( "sort <=: select_nth_generic result is not partitioned" );
+                return false;
+            }
+        }
+    }
+    #undef TEST_SORT_LEN
+    return true;
+}
+
+/// @brief Check that parallel sort split and merge work with a (<=) comparator.
+static b32 test_parallel_sort_non_strict_cmp(void) {
+    #define TEST_PARALLEL_SORT_LEN (1 << 18)
+    static i32 buffer[TEST_PARALLEL_SORT_LEN];
+    for( usize i = 0; i < TEST_PARALLEL_SORT_LEN; ++i ) {
+        buffer[i] = (i32)((i * 7) % 97);
+    }
+
+    AllocatorInterface allocator;
+    allocator_interface_from_heap( &allocator );
+    if( !parallel_sort_generic(
+        &allocator, TEST_PARALLEL_SORT_LEN, sizeof(i32), buffer,
+        test_sort_cmp_less_equal, 0, 4
+    ) ) {
+        println( "sort <=: parallel_sort_generic failed to allocate" );
+        return false;
+    }
+    for( usize i = 1; i < TEST_PARALLEL_SORT_LEN; ++i ) {
+        if( buffer[i - 1] > buffer[i] ) {
+            println( "sort <=: parallel_sort_generic result is not sorted" );
+            return false;
+        }
+    }
+    #undef TEST_PARALLEL_SORT_LEN
+    return true;
+}
 
 int main( int argc, char** argv ) {
     println( "hello, world!\n" );
+
+    if( !test_utf8_validate() ) {
+        return 1;
+    }
+    println( "utf8 validate: ok" );
+
+    if( !test_sort_non_strict_cmp() || !test_parallel_sort_non_strict_cmp() ) {
+        return 1;
+    }
+    println( "sort <=: ok" );
     return 0;
 }
 